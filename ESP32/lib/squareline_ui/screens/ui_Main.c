@@ -4,12 +4,8 @@
 // Project name: VOX_EFX
 
 #include "../ui.h"
+#include "../ui_panels.h"   // VOX EFX: ui_panels (re-export step, see ui_panels.h)
 
-lv_obj_t * uic_pnlSetup;
-lv_obj_t * uic_pnlEQ;
-lv_obj_t * uic_pnlReverb;
-lv_obj_t * uic_pnlDynamics;
-lv_obj_t * uic_pnlDelay;
 lv_obj_t * uic_ContentContainer;
 lv_obj_t * uic_btnSetupPage;
 lv_obj_t * uic_btnEQPage;
@@ -30,19 +26,6 @@ lv_obj_t * ui_Label4 = NULL;
 lv_obj_t * ui_btnSetupPage = NULL;
 lv_obj_t * ui_Label5 = NULL;
 lv_obj_t * ui_ContentContainer = NULL;
-lv_obj_t * ui_pnlDelay = NULL;
-lv_obj_t * ui_Label7 = NULL;
-lv_obj_t * ui_Image4 = NULL;
-lv_obj_t * ui_pnlDynamics = NULL;
-lv_obj_t * ui_Label8 = NULL;
-lv_obj_t * ui_Image3 = NULL;
-lv_obj_t * ui_pnlReverb = NULL;
-lv_obj_t * ui_Image2 = NULL;
-lv_obj_t * ui_pnlEQ = NULL;
-lv_obj_t * ui_Image5 = NULL;
-lv_obj_t * ui_Label9 = NULL;
-lv_obj_t * ui_pnlSetup = NULL;
-lv_obj_t * ui_Label10 = NULL;
 // event funtions
 void ui_event_btnReverbPage(lv_event_t * e)
 {
@@ -89,6 +72,122 @@ void ui_event_btnSetupPage(lv_event_t * e)
     }
 }
 
+// VOX EFX: ui_panels - panel build functions, created on demand by
+// ui_panels.c (re-export step, see ui_panels.h)
+
+lv_obj_t * ui_pnlDelay_create(lv_obj_t * parent)
+{
+    lv_obj_t * ui_pnlDelay = lv_obj_create(parent);
+    lv_obj_set_width(ui_pnlDelay, lv_pct(100));
+    lv_obj_set_height(ui_pnlDelay, lv_pct(90));
+    lv_obj_set_align(ui_pnlDelay, LV_ALIGN_BOTTOM_MID);
+    lv_obj_remove_flag(ui_pnlDelay, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Label7 = lv_label_create(ui_pnlDelay);
+    lv_obj_set_width(ui_Label7, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_Label7, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_Label7, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_Label7, "Delay");
+
+    lv_obj_t * ui_Image4 = lv_image_create(ui_pnlDelay);
+    lv_image_set_src(ui_Image4, &ui_img_382037981);
+    lv_obj_set_width(ui_Image4, LV_SIZE_CONTENT);   /// 1276
+    lv_obj_set_height(ui_Image4, LV_SIZE_CONTENT);    /// 392
+    lv_obj_set_x(ui_Image4, 2);
+    lv_obj_set_y(ui_Image4, 60);
+    lv_obj_set_align(ui_Image4, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_Image4, LV_OBJ_FLAG_CLICKABLE);     /// Flags
+    lv_obj_remove_flag(ui_Image4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    return ui_pnlDelay;
+}
+
+lv_obj_t * ui_pnlDynamics_create(lv_obj_t * parent)
+{
+    lv_obj_t * ui_pnlDynamics = lv_obj_create(parent);
+    lv_obj_set_width(ui_pnlDynamics, lv_pct(100));
+    lv_obj_set_height(ui_pnlDynamics, lv_pct(90));
+    lv_obj_set_align(ui_pnlDynamics, LV_ALIGN_BOTTOM_MID);
+    lv_obj_remove_flag(ui_pnlDynamics, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Label8 = lv_label_create(ui_pnlDynamics);
+    lv_obj_set_width(ui_Label8, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_Label8, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_Label8, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_Label8, "Dynamics");
+
+    lv_obj_t * ui_Image3 = lv_image_create(ui_pnlDynamics);
+    lv_image_set_src(ui_Image3, &ui_img_1980880135);
+    lv_obj_set_width(ui_Image3, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_Image3, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_Image3, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_Image3, LV_OBJ_FLAG_CLICKABLE);     /// Flags
+    lv_obj_remove_flag(ui_Image3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    return ui_pnlDynamics;
+}
+
+lv_obj_t * ui_pnlReverb_create(lv_obj_t * parent)
+{
+    lv_obj_t * ui_pnlReverb = lv_obj_create(parent);
+    lv_obj_set_width(ui_pnlReverb, lv_pct(100));
+    lv_obj_set_height(ui_pnlReverb, lv_pct(90));
+    lv_obj_set_align(ui_pnlReverb, LV_ALIGN_BOTTOM_MID);
+    lv_obj_remove_flag(ui_pnlReverb, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Image2 = lv_image_create(ui_pnlReverb);
+    lv_image_set_src(ui_Image2, &ui_img_1926139265);
+    lv_obj_set_width(ui_Image2, lv_pct(100));
+    lv_obj_set_height(ui_Image2, lv_pct(100));
+    lv_obj_set_align(ui_Image2, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_Image2, LV_OBJ_FLAG_CLICKABLE);     /// Flags
+    lv_obj_remove_flag(ui_Image2, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    return ui_pnlReverb;
+}
+
+lv_obj_t * ui_pnlEQ_create(lv_obj_t * parent)
+{
+    lv_obj_t * ui_pnlEQ = lv_obj_create(parent);
+    lv_obj_set_width(ui_pnlEQ, lv_pct(100));
+    lv_obj_set_height(ui_pnlEQ, lv_pct(90));
+    lv_obj_set_align(ui_pnlEQ, LV_ALIGN_BOTTOM_MID);
+    lv_obj_remove_flag(ui_pnlEQ, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Image5 = lv_image_create(ui_pnlEQ);
+    lv_image_set_src(ui_Image5, &ui_img_2009663892);
+    lv_obj_set_width(ui_Image5, LV_SIZE_CONTENT);   /// 1186
+    lv_obj_set_height(ui_Image5, LV_SIZE_CONTENT);    /// 608
+    lv_obj_set_align(ui_Image5, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_Image5, LV_OBJ_FLAG_CLICKABLE);     /// Flags
+    lv_obj_remove_flag(ui_Image5, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Label9 = lv_label_create(ui_pnlEQ);
+    lv_obj_set_width(ui_Label9, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_Label9, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_Label9, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_Label9, "Eq");
+
+    return ui_pnlEQ;
+}
+
+lv_obj_t * ui_pnlSetup_create(lv_obj_t * parent)
+{
+    lv_obj_t * ui_pnlSetup = lv_obj_create(parent);
+    lv_obj_set_width(ui_pnlSetup, lv_pct(100));
+    lv_obj_set_height(ui_pnlSetup, lv_pct(90));
+    lv_obj_set_align(ui_pnlSetup, LV_ALIGN_BOTTOM_MID);
+    lv_obj_remove_flag(ui_pnlSetup, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    lv_obj_t * ui_Label10 = lv_label_create(ui_pnlSetup);
+    lv_obj_set_width(ui_Label10, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_Label10, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_Label10, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_Label10, "Setup");
+
+    return ui_pnlSetup;
+}
+
 // build funtions
 
 void ui_Main_screen_init(void)
@@ -282,94 +381,7 @@ void ui_Main_screen_init(void)
     lv_obj_set_align(ui_ContentContainer, LV_ALIGN_BOTTOM_MID);
     lv_obj_remove_flag(ui_ContentContainer, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);      /// Flags
 
-    ui_pnlDelay = lv_obj_create(ui_ContentContainer);
-    lv_obj_set_width(ui_pnlDelay, lv_pct(100));
-    lv_obj_set_height(ui_pnlDelay, lv_pct(90));
-    lv_obj_set_align(ui_pnlDelay, LV_ALIGN_BOTTOM_MID);
-    lv_obj_remove_flag(ui_pnlDelay, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Label7 = lv_label_create(ui_pnlDelay);
-    lv_obj_set_width(ui_Label7, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_Label7, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_align(ui_Label7, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_Label7, "Delay");
-
-    ui_Image4 = lv_image_create(ui_pnlDelay);
-    lv_image_set_src(ui_Image4, &ui_img_382037981);
-    lv_obj_set_width(ui_Image4, LV_SIZE_CONTENT);   /// 1276
-    lv_obj_set_height(ui_Image4, LV_SIZE_CONTENT);    /// 392
-    lv_obj_set_x(ui_Image4, 2);
-    lv_obj_set_y(ui_Image4, 60);
-    lv_obj_set_align(ui_Image4, LV_ALIGN_CENTER);
-    lv_obj_add_flag(ui_Image4, LV_OBJ_FLAG_CLICKABLE);     /// Flags
-    lv_obj_remove_flag(ui_Image4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_pnlDynamics = lv_obj_create(ui_ContentContainer);
-    lv_obj_set_width(ui_pnlDynamics, lv_pct(100));
-    lv_obj_set_height(ui_pnlDynamics, lv_pct(90));
-    lv_obj_set_align(ui_pnlDynamics, LV_ALIGN_BOTTOM_MID);
-    lv_obj_remove_flag(ui_pnlDynamics, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Label8 = lv_label_create(ui_pnlDynamics);
-    lv_obj_set_width(ui_Label8, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_Label8, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_align(ui_Label8, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_Label8, "Dynamics");
-
-    ui_Image3 = lv_image_create(ui_pnlDynamics);
-    lv_image_set_src(ui_Image3, &ui_img_1980880135);
-    lv_obj_set_width(ui_Image3, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_Image3, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_align(ui_Image3, LV_ALIGN_CENTER);
-    lv_obj_add_flag(ui_Image3, LV_OBJ_FLAG_CLICKABLE);     /// Flags
-    lv_obj_remove_flag(ui_Image3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_pnlReverb = lv_obj_create(ui_ContentContainer);
-    lv_obj_set_width(ui_pnlReverb, lv_pct(100));
-    lv_obj_set_height(ui_pnlReverb, lv_pct(90));
-    lv_obj_set_align(ui_pnlReverb, LV_ALIGN_BOTTOM_MID);
-    lv_obj_remove_flag(ui_pnlReverb, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Image2 = lv_image_create(ui_pnlReverb);
-    lv_image_set_src(ui_Image2, &ui_img_1926139265);
-    lv_obj_set_width(ui_Image2, lv_pct(100));
-    lv_obj_set_height(ui_Image2, lv_pct(100));
-    lv_obj_set_align(ui_Image2, LV_ALIGN_CENTER);
-    lv_obj_add_flag(ui_Image2, LV_OBJ_FLAG_CLICKABLE);     /// Flags
-    lv_obj_remove_flag(ui_Image2, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_pnlEQ = lv_obj_create(ui_ContentContainer);
-    lv_obj_set_width(ui_pnlEQ, lv_pct(100));
-    lv_obj_set_height(ui_pnlEQ, lv_pct(90));
-    lv_obj_set_align(ui_pnlEQ, LV_ALIGN_BOTTOM_MID);
-    lv_obj_remove_flag(ui_pnlEQ, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Image5 = lv_image_create(ui_pnlEQ);
-    lv_image_set_src(ui_Image5, &ui_img_2009663892);
-    lv_obj_set_width(ui_Image5, LV_SIZE_CONTENT);   /// 1186
-    lv_obj_set_height(ui_Image5, LV_SIZE_CONTENT);    /// 608
-    lv_obj_set_align(ui_Image5, LV_ALIGN_CENTER);
-    lv_obj_add_flag(ui_Image5, LV_OBJ_FLAG_CLICKABLE);     /// Flags
-    lv_obj_remove_flag(ui_Image5, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Label9 = lv_label_create(ui_pnlEQ);
-    lv_obj_set_width(ui_Label9, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_Label9, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_align(ui_Label9, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_Label9, "Eq");
-
-    ui_pnlSetup = lv_obj_create(ui_ContentContainer);
-    lv_obj_set_width(ui_pnlSetup, lv_pct(100));
-    lv_obj_set_height(ui_pnlSetup, lv_pct(90));
-    lv_obj_set_align(ui_pnlSetup, LV_ALIGN_BOTTOM_MID);
-    lv_obj_add_flag(ui_pnlSetup, LV_OBJ_FLAG_HIDDEN);     /// Flags
-    lv_obj_remove_flag(ui_pnlSetup, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_Label10 = lv_label_create(ui_pnlSetup);
-    lv_obj_set_width(ui_Label10, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_Label10, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_align(ui_Label10, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_Label10, "Setup");
+    ui_panels_init(ui_ContentContainer);     // VOX EFX: ui_panels
 
     lv_obj_add_event_cb(ui_btnReverbPage, ui_event_btnReverbPage, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_btnDelayPage, ui_event_btnDelayPage, LV_EVENT_ALL, NULL);
@@ -383,16 +395,12 @@ void ui_Main_screen_init(void)
     uic_btnEQPage = ui_btnEQPage;
     uic_btnSetupPage = ui_btnSetupPage;
     uic_ContentContainer = ui_ContentContainer;
-    uic_pnlDelay = ui_pnlDelay;
-    uic_pnlDynamics = ui_pnlDynamics;
-    uic_pnlReverb = ui_pnlReverb;
-    uic_pnlEQ = ui_pnlEQ;
-    uic_pnlSetup = ui_pnlSetup;
 
 }
 
 void ui_Main_screen_destroy(void)
 {
+    ui_panels_deinit();     // VOX EFX: ui_panels
     if(ui_Main) lv_obj_del(ui_Main);
 
     // NULL screen variables
@@ -416,23 +424,5 @@ void ui_Main_screen_destroy(void)
     ui_Label5 = NULL;
     uic_ContentContainer = NULL;
     ui_ContentContainer = NULL;
-    uic_pnlDelay = NULL;
-    ui_pnlDelay = NULL;
-    ui_Label7 = NULL;
-    ui_Image4 = NULL;
-    uic_pnlDynamics = NULL;
-    ui_pnlDynamics = NULL;
-    ui_Label8 = NULL;
-    ui_Image3 = NULL;
-    uic_pnlReverb = NULL;
-    ui_pnlReverb = NULL;
-    ui_Image2 = NULL;
-    uic_pnlEQ = NULL;
-    ui_pnlEQ = NULL;
-    ui_Image5 = NULL;
-    ui_Label9 = NULL;
-    uic_pnlSetup = NULL;
-    ui_pnlSetup = NULL;
-    ui_Label10 = NULL;
 
 }
@@ -31,19 +31,12 @@ extern void ui_event_btnSetupPage(lv_event_t * e);
 extern lv_obj_t * ui_btnSetupPage;
 extern lv_obj_t * ui_Label5;
 extern lv_obj_t * ui_ContentContainer;
-extern lv_obj_t * ui_pnlDelay;
-extern lv_obj_t * ui_Label7;
-extern lv_obj_t * ui_Image4;
-extern lv_obj_t * ui_pnlDynamics;
-extern lv_obj_t * ui_Label8;
-extern lv_obj_t * ui_Image3;
-extern lv_obj_t * ui_pnlReverb;
-extern lv_obj_t * ui_Image2;
-extern lv_obj_t * ui_pnlEQ;
-extern lv_obj_t * ui_Image5;
-extern lv_obj_t * ui_Label9;
-extern lv_obj_t * ui_pnlSetup;
-extern lv_obj_t * ui_Label10;
+// VOX EFX: ui_panels - built on first show by ui_panels.c (re-export step, see ui_panels.h)
+lv_obj_t * ui_pnlDelay_create(lv_obj_t * parent);
+lv_obj_t * ui_pnlDynamics_create(lv_obj_t * parent);
+lv_obj_t * ui_pnlReverb_create(lv_obj_t * parent);
+lv_obj_t * ui_pnlEQ_create(lv_obj_t * parent);
+lv_obj_t * ui_pnlSetup_create(lv_obj_t * parent);
 // CUSTOM VARIABLES
 extern lv_obj_t * uic_NavContainer;
 extern lv_obj_t * uic_btnReverbPage;
@@ -52,11 +45,6 @@ extern lv_obj_t * uic_btnDelayPage;
 extern lv_obj_t * uic_btnEQPage;
 extern lv_obj_t * uic_btnSetupPage;
 extern lv_obj_t * uic_ContentContainer;
-extern lv_obj_t * uic_pnlDelay;
-extern lv_obj_t * uic_pnlDynamics;
-extern lv_obj_t * uic_pnlReverb;
-extern lv_obj_t * uic_pnlEQ;
-extern lv_obj_t * uic_pnlSetup;
 
 #ifdef __cplusplus
 } /*extern "C"*/
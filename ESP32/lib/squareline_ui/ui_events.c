@@ -4,45 +4,35 @@
 // Project name: VOX_EFX
 
 #include "ui.h"
-
-static void show_only_panel(lv_obj_t * panel_to_show)
-{
-    lv_obj_add_flag(ui_pnlReverb,   LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_pnlDelay,    LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_pnlDynamics, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_pnlEQ,       LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(ui_pnlSetup,    LV_OBJ_FLAG_HIDDEN);
-
-    lv_obj_clear_flag(panel_to_show, LV_OBJ_FLAG_HIDDEN);
-}
+#include "ui_panels.h"
 
 void on_nav_reverb(lv_event_t * e)
 {
     if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-    show_only_panel(ui_pnlReverb);
+    ui_panel_show(UI_PANEL_REVERB);
 }
 
 void on_nav_delay(lv_event_t * e)
 {
     if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-    show_only_panel(ui_pnlDelay);
+    ui_panel_show(UI_PANEL_DELAY);
 }
 
 void on_nav_dynamics(lv_event_t * e)
 {
     if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-    show_only_panel(ui_pnlDynamics);
+    ui_panel_show(UI_PANEL_DYNAMICS);
 }
 
 void on_nav_eq(lv_event_t * e)
 {
     if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-    show_only_panel(ui_pnlEQ);
+    ui_panel_show(UI_PANEL_EQ);
 }
 
 void on_nav_setup(lv_event_t * e)
 {
     if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
-    show_only_panel(ui_pnlSetup);
+    ui_panel_show(UI_PANEL_SETUP);
 }
 
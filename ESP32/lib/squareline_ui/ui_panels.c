@@ -0,0 +1,113 @@
+// VOX EFX - on-demand content panels for ui_Main (see ui_panels.h)
+
+#include "ui.h"
+#include "ui_panels.h"
+
+typedef struct {
+    lv_obj_t * (*create)(lv_obj_t * parent);
+    lv_obj_t * obj;
+    uint32_t hidden_at;     // lv_tick_get() when it stopped being the current panel
+} ui_panel_t;
+
+static ui_panel_t panels[UI_PANEL_COUNT] = {
+    [UI_PANEL_REVERB]   = { ui_pnlReverb_create,   NULL, 0 },
+    [UI_PANEL_DELAY]    = { ui_pnlDelay_create,    NULL, 0 },
+    [UI_PANEL_DYNAMICS] = { ui_pnlDynamics_create, NULL, 0 },
+    [UI_PANEL_EQ]       = { ui_pnlEQ_create,       NULL, 0 },
+    [UI_PANEL_SETUP]    = { ui_pnlSetup_create,    NULL, 0 },
+};
+
+static lv_obj_t * container = NULL;
+static ui_panel_id_t current = UI_PANEL_REVERB;
+static const ui_panel_hooks_t * hooks = NULL;
+static lv_timer_t * free_timer = NULL;
+
+static void delete_panel(ui_panel_id_t id)
+{
+    if(hooks && hooks->deleting) hooks->deleting(id, panels[id].obj);
+    lv_obj_delete(panels[id].obj);
+    panels[id].obj = NULL;
+}
+
+#if UI_PANEL_FREE_MS > 0
+static void free_timer_cb(lv_timer_t * t)
+{
+    (void)t;
+    for(int i = 0; i < UI_PANEL_COUNT; i++) {
+        if(i == (int)current || !panels[i].obj) continue;
+        if(lv_tick_elaps(panels[i].hidden_at) >= UI_PANEL_FREE_MS) delete_panel((ui_panel_id_t)i);
+    }
+}
+#endif
+
+static lv_obj_t * build(ui_panel_id_t id)
+{
+    if(!panels[id].obj) {
+        lv_obj_t * p = panels[id].create(container);
+        lv_obj_add_flag(p, LV_OBJ_FLAG_HIDDEN);
+        panels[id].obj = p;
+        if(hooks && hooks->created) hooks->created(id, p);
+    }
+    return panels[id].obj;
+}
+
+void ui_panels_init(lv_obj_t * parent)
+{
+    container = parent;
+    current = UI_PANEL_REVERB;     // matches btnReverbPage's initial CHECKED state
+    lv_obj_remove_flag(build(current), LV_OBJ_FLAG_HIDDEN);
+
+#if UI_PANEL_FREE_MS > 0
+    free_timer = lv_timer_create(free_timer_cb, UI_PANEL_FREE_MS / 4 + 1, NULL);
+#endif
+}
+
+void ui_panels_deinit(void)
+{
+    for(int i = 0; i < UI_PANEL_COUNT; i++) {
+        if(panels[i].obj) delete_panel((ui_panel_id_t)i);
+    }
+    if(free_timer) lv_timer_delete(free_timer);
+    free_timer = NULL;
+    container = NULL;
+}
+
+void ui_panels_set_hooks(const ui_panel_hooks_t * h)
+{
+    hooks = h;
+    if(!hooks) return;
+    if(hooks->created) {
+        for(int i = 0; i < UI_PANEL_COUNT; i++) {
+            if(panels[i].obj) hooks->created((ui_panel_id_t)i, panels[i].obj);
+        }
+    }
+    // The boot panel was shown by ui_panels_init(), before any hooks
+    if(hooks->shown && panels[current].obj) hooks->shown(current, panels[current].obj);
+}
+
+lv_obj_t * ui_panel_show(ui_panel_id_t id)
+{
+    if(id >= UI_PANEL_COUNT || !container) return NULL;
+    if(hooks && hooks->showing) hooks->showing(id);
+    lv_obj_t * p = build(id);
+
+    if(id != current && panels[current].obj) {
+        lv_obj_add_flag(panels[current].obj, LV_OBJ_FLAG_HIDDEN);
+        panels[current].hidden_at = lv_tick_get();
+    }
+    current = id;
+    lv_obj_remove_flag(p, LV_OBJ_FLAG_HIDDEN);
+
+    if(hooks && hooks->shown) hooks->shown(id, p);
+    return p;
+}
+
+lv_obj_t * ui_panel_get(ui_panel_id_t id)
+{
+    return id < UI_PANEL_COUNT ? panels[id].obj : NULL;
+}
+
+ui_panel_id_t ui_panel_current(void)
+{
+    return current;
+}
@@ -0,0 +1,78 @@
+// VOX EFX - on-demand content panels for ui_Main
+// Replaces the ui_pnl* globals: each panel is built by its
+// ui_pnl*_create() the first time it is shown, and a hidden panel can be
+// deleted again after UI_PANEL_FREE_MS (0 = keep every panel once built).
+// Only the Reverb panel is built by ui_init(), so boot renders one panel
+//
+// Re-export step. SquareLine writes every panel of a screen inline in
+// ui_Main_screen_init(), so screens/ui_Main.c and ui_Main.h carry hand
+// edits, each marked "VOX EFX: ui_panels". A fresh export drops them, and
+// tools/pack_images.py (pre-build) then stops the build and lists what is
+// missing. To redo them in a fresh export:
+//  1. ui_Main.c: include "../ui_panels.h" after "../ui.h"
+//  2. ui_Main.c: each content panel block of ui_Main_screen_init(), from
+//     `ui_pnlX = lv_obj_create(ui_ContentContainer);` through its last
+//     child, becomes `lv_obj_t * ui_pnlX_create(lv_obj_t * parent)` above
+//     ui_Main_screen_init(): the panel is created on parent, it and its
+//     children are locals, LV_OBJ_FLAG_HIDDEN is dropped, the panel is
+//     returned
+//  3. ui_Main.c: delete the globals of those panels and their children,
+//     the uic_pnl* copies and their NULL resets in ui_Main_screen_destroy()
+//  4. ui_Main.c: call ui_panels_init(ui_ContentContainer) where the panels
+//     were built, and ui_panels_deinit() first in ui_Main_screen_destroy()
+//  5. ui_Main.h: replace the panel externs with the ui_pnlX_create()
+//     prototypes
+//  6. filelist.txt / CMakeLists.txt (non-PlatformIO builds): list ui_panels.c
+// A panel added in SquareLine also needs a ui_panel_id_t and a row in the
+// table in ui_panels.c.
+
+#ifndef _UI_PANELS_H
+#define _UI_PANELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+#ifndef UI_PANEL_FREE_MS
+#define UI_PANEL_FREE_MS 0
+#endif
+
+typedef enum {
+    UI_PANEL_REVERB = 0,
+    UI_PANEL_DELAY,
+    UI_PANEL_DYNAMICS,
+    UI_PANEL_EQ,
+    UI_PANEL_SETUP,
+    UI_PANEL_COUNT
+} ui_panel_id_t;
+
+// Any hook may be NULL
+typedef struct {
+    void (*showing)(ui_panel_id_t id);                      // ui_panel_show() entered
+    void (*created)(ui_panel_id_t id, lv_obj_t * panel);    // built, still hidden
+    void (*shown)(ui_panel_id_t id, lv_obj_t * panel);      // now the visible panel
+    void (*deleting)(ui_panel_id_t id, lv_obj_t * panel);   // about to be freed
+} ui_panel_hooks_t;
+
+// Called by ui_Main_screen_init() / ui_Main_screen_destroy()
+void ui_panels_init(lv_obj_t * container);
+void ui_panels_deinit(void);
+
+// hooks must outlive the UI. Calls created() for the panels already built,
+// then shown() for the current one
+void ui_panels_set_hooks(const ui_panel_hooks_t * hooks);
+
+// Builds the panel if needed, hides the others
+lv_obj_t * ui_panel_show(ui_panel_id_t id);
+
+// NULL while the panel is not built
+lv_obj_t * ui_panel_get(ui_panel_id_t id);
+ui_panel_id_t ui_panel_current(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
@@ -1,10 +1,20 @@
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 #include <Wire.h>
+#include <esp_heap_caps.h>
+
+#include <atomic>
+
+#include "vox_link.h"       // Teensy <-> ESP32 frame codec (../shared/VoxLink)
+#include "vox_snapshot.h"   // lock-free RX task -> LVGL hand-over
+#include "vox_boot_trace.h" // setup() timeline, printed once as BOOT,ESP32,...
+#include "packed_image.h"   // decoder for tools/pack_images.py assets
+#include "panel_cache.h"    // pre-rendered panel backgrounds
 
 extern "C" {
   #include <lvgl.h>
   #include "ui.h"   // SquareLine export (lib/squareline_ui)
+  #include "ui_panels.h"
 }
 
 // ====================== Display settings ======================
@@ -12,42 +22,79 @@ static constexpr int DISP_HOR = 480;
 static constexpr int DISP_VER = 320;
 static constexpr int TFT_ROT  = 1;   // landscape for most ST7796 setups
 
-// Reduce RAM usage: one partial buffer
-static constexpr uint32_t BUF_LINES  = 20;                 // 10–20 is safe on ESP32
+// Two partial buffers: LVGL renders one band while DMA sends the other.
+// DISP_BUF_LINES comes from platformio.ini build_flags
+#ifndef DISP_BUF_LINES
+#define DISP_BUF_LINES 20
+#endif
+static constexpr uint32_t BUF_LINES  = DISP_BUF_LINES;
 static constexpr uint32_t BUF_PIXELS = DISP_HOR * BUF_LINES;
+static constexpr uint32_t BUF_BYTES  = BUF_PIXELS * sizeof(lv_color_t);
 
 TFT_eSPI tft;
 static lv_display_t* g_disp = nullptr;
-static lv_color_t g_buf1[BUF_PIXELS];                      // ONE buffer (fits DRAM)
+static lv_color_t* g_buf1 = nullptr;                       // DMA-capable internal RAM
+static lv_color_t* g_buf2 = nullptr;
+
+// Boot timeline: setup() phases, then the first complete frame (loop())
+static vox::link::BootTrace<12> g_boot;
+static bool g_bootDone = false;
+static bool g_firstFrame = false;                          // set by the flush of the last band
+static void bootMark(const char* phase) { g_boot.mark(phase, micros()); }
+
+static lv_color_t* allocDrawBuf()
+{
+  return (lv_color_t*)heap_caps_malloc(BUF_BYTES, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+}
 
 // ====================== LVGL flush callback ======================
+// The bus stays claimed (startWrite() in setup), each band goes out as one
+// DMA transfer and the callback returns at once. pushImageDMA() waits for
+// the previous transfer before it sets the window, and with two buffers LVGL only renders into a
+// buffer again after flushing the other one, so by then that buffer's DMA
+// has finished: flush_ready can be signalled as soon as the transfer is
+// queued. With a single buffer (allocation fallback) it waits instead
 static void my_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map)
 {
-  const int32_t x1 = area->x1;
-  const int32_t y1 = area->y1;
-  const int32_t x2 = area->x2;
-  const int32_t y2 = area->y2;
+  const int32_t w = (area->x2 - area->x1 + 1);
+  const int32_t h = (area->y2 - area->y1 + 1);
 
-  const int32_t w = (x2 - x1 + 1);
-  const int32_t h = (y2 - y1 + 1);
+  // LVGL RGB565 buffer -> DMA; byte swap happens in place (setSwapBytes)
+  tft.pushImageDMA(area->x1, area->y1, w, h, (uint16_t*)px_map);
 
-  tft.startWrite();
-  tft.setAddrWindow((int)x1, (int)y1, (int)w, (int)h);
+  if (!g_buf2) tft.dmaWait();
+  if (lv_display_flush_is_last(disp)) g_firstFrame = true;
+  lv_display_flush_ready(disp);
+}
 
-  // LVGL RGB565 buffer -> push as 16-bit pixels
-  tft.pushPixels((uint16_t*)px_map, (uint32_t)(w * h));
+// ====================== UI wake-ups ======================
+// loop() sleeps on its task notification between LVGL passes; the link RX
+// and touch tasks wake it early. Both run on the core Arduino loop() and
+// LVGL don't use
+static const BaseType_t IO_CORE = ARDUINO_RUNNING_CORE ? 0 : 1;
+static TaskHandle_t g_uiTask = nullptr;
 
-  tft.endWrite();
-  lv_display_flush_ready(disp);
+static void wakeUi()
+{
+  if (g_uiTask) xTaskNotifyGive(g_uiTask);
 }
 
 // ====================== Optional Touch (FT6336U) ======================
 #define ENABLE_FT6336U_TOUCH  1
 
 #if ENABLE_FT6336U_TOUCH
+// GPIO wired to the FT6336U INT line (active low, platformio.ini), -1 if
+// not wired: the indev callback then polls the panel itself
+#ifndef FT6336U_INT_PIN
+#define FT6336U_INT_PIN -1
+#endif
+
+static lv_indev_t* g_touch = nullptr;
+
 static const uint8_t FT_ADDR     = 0x38;
-static const uint8_t REG_TD_STAT = 0x02;
-static const uint8_t REG_P1_XH   = 0x03;
+static const uint8_t REG_TD_STAT = 0x02;   // 0x02..0x06: count, P1 XH/XL/YH/YL
+static const uint8_t REG_G_MODE  = 0xA4;
+static const uint8_t G_MODE_TRIGGER = 0x01; // one INT pulse per new report
 
 static bool ftReadRegs(uint8_t startReg, uint8_t* buf, uint8_t len)
 {
@@ -60,19 +107,17 @@ static bool ftReadRegs(uint8_t startReg, uint8_t* buf, uint8_t len)
   return true;
 }
 
+// One I2C transaction: touch count and first point
 static bool ftReadTouch(int& sx, int& sy, bool& pressed)
 {
   pressed = false;
 
-  uint8_t td = 0;
-  if (!ftReadRegs(REG_TD_STAT, &td, 1)) return false;
-  if ((td & 0x0F) == 0) return true; // no touch, but comm OK
+  uint8_t b[5];
+  if (!ftReadRegs(REG_TD_STAT, b, sizeof(b))) return false;
+  if ((b[0] & 0x0F) == 0) return true; // no touch, but comm OK
 
-  uint8_t b[4];
-  if (!ftReadRegs(REG_P1_XH, b, 4)) return false;
-
-  uint16_t x = ((uint16_t)(b[0] & 0x0F) << 8) | b[1];
-  uint16_t y = ((uint16_t)(b[2] & 0x0F) << 8) | b[3];
+  uint16_t x = ((uint16_t)(b[1] & 0x0F) << 8) | b[2];
+  uint16_t y = ((uint16_t)(b[3] & 0x0F) << 8) | b[4];
 
   // Mapping guess for rotation(1): many panels report portrait coords
   int rawX = (int)x;
@@ -84,6 +129,69 @@ static bool ftReadTouch(int& sx, int& sy, bool& pressed)
   return true;
 }
 
+#if FT6336U_INT_PIN >= 0
+// Touch task: reads the panel only when INT fires and caches the result as
+// one word (x | y << 12 | pressed << 31), so the indev callback on the
+// LVGL thread is a single load and never touches I2C. While a finger is
+// down it also re-reads every TOUCH_HELD_POLL_MS, in case a release pulse
+// was missed
+static const UBaseType_t TOUCH_PRIO         = 6;
+static const uint32_t    TOUCH_STACK        = 3072;
+static const uint32_t    TOUCH_HELD_POLL_MS = 50;
+static const uint32_t    TOUCH_PRESSED      = 1u << 31;
+
+static TaskHandle_t g_touchTask = nullptr;
+static std::atomic<uint32_t> g_touchCache(0);
+static std::atomic<bool> g_touchFresh(false);    // new reading for LVGL
+
+static bool ftWriteReg(uint8_t reg, uint8_t v)
+{
+  Wire.beginTransmission(FT_ADDR);
+  Wire.write(reg);
+  Wire.write(v);
+  return Wire.endTransmission() == 0;
+}
+
+static void IRAM_ATTR ftIntIsr()
+{
+  BaseType_t woken = pdFALSE;
+  if (g_touchTask) vTaskNotifyGiveFromISR(g_touchTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+static void touchTask(void*)
+{
+  ftWriteReg(REG_G_MODE, G_MODE_TRIGGER);
+  bool down = false;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, down ? pdMS_TO_TICKS(TOUCH_HELD_POLL_MS) : portMAX_DELAY);
+
+    int x = 0, y = 0;
+    bool pressed = false;
+    if (!ftReadTouch(x, y, pressed)) pressed = false;
+
+    const uint32_t prev = g_touchCache.load(std::memory_order_relaxed);
+    const uint32_t v = pressed ? ((uint32_t)x | ((uint32_t)y << 12) | TOUCH_PRESSED)
+                               : (prev & ~TOUCH_PRESSED);   // release keeps the last point
+    down = pressed;
+    if (v == prev) continue;
+
+    g_touchCache.store(v, std::memory_order_release);
+    g_touchFresh.store(true, std::memory_order_release);
+    wakeUi();
+  }
+}
+
+static void my_touch_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+  (void)indev;
+  const uint32_t v = g_touchCache.load(std::memory_order_acquire);
+  data->state   = (v & TOUCH_PRESSED) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+  data->point.x = (int32_t)(v & 0xFFF);
+  data->point.y = (int32_t)((v >> 12) & 0xFFF);
+}
+#else
 static void my_touch_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
 {
   (void)indev;
@@ -102,46 +210,273 @@ static void my_touch_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
   data->point.y = y;
 }
 #endif
+#endif
+
+// ====================== Teensy link (binary frames) ======================
+#define TEENSY_SERIAL Serial2
+static const int TEENSY_RX_PIN = 16;   // from Teensy TX4 (pin 17)
+static const int TEENSY_TX_PIN = 17;   // to Teensy RX4 (pin 16)
+
+static const uint32_t TEENSY_RX_BUF = 1024;    // UART driver ring, ~90 ms at 115200
+
+// Link RX task: pinned to the core LVGL doesn't run on (Arduino loop() and
+// LVGL live on ARDUINO_RUNNING_CORE), so a burst of frames never delays a
+// redraw and a long redraw never overruns the UART
+static const UBaseType_t LINK_RX_PRIO    = 5;
+static const uint32_t    LINK_RX_STACK   = 4096;
+static const TickType_t  LINK_RX_IDLE    = pdMS_TO_TICKS(2);
+
+// Latest telemetry from the pedal
+struct PedalState {
+  vox::link::Meter       meter;
+  vox::link::Level       level;
+  vox::link::ReverbState reverb;
+  vox::link::DelayState  delay;
+  vox::link::Debug       dbg;
+  vox::link::Cpu         cpu;
+  vox::link::Pool        pool;
+  uint32_t               lastFrameMs;
+  uint32_t               frames, crcErrors;
+};
+
+// RX task -> LVGL: whole PedalState copies, never a lock
+static vox::link::Snapshot<PedalState> g_pedalSnap;
+
+static void linkRxTask(void*)
+{
+  vox::link::Decoder rx;
+  PedalState st = {};
+  uint8_t buf[64];
+
+  for (;;) {
+    int avail = TEENSY_SERIAL.available();
+    if (avail <= 0) {
+      vTaskDelay(LINK_RX_IDLE);
+      continue;
+    }
+
+    // Parse everything that's waiting, publish once per burst
+    bool changed = false;
+    while (avail > 0) {
+      size_t n = TEENSY_SERIAL.read(buf, avail < (int)sizeof(buf) ? (size_t)avail : sizeof(buf));
+      for (size_t i = 0; i < n; i++) {
+        if (!rx.push(buf[i])) continue;
+
+        bool ok = false;
+        switch (rx.type()) {
+          case vox::link::MSG_METER:  ok = vox::link::decode(rx, st.meter);  break;
+          case vox::link::MSG_LEVEL:  ok = vox::link::decode(rx, st.level);  break;
+          case vox::link::MSG_REVERB: ok = vox::link::decode(rx, st.reverb); break;
+          case vox::link::MSG_DELAY:  ok = vox::link::decode(rx, st.delay);  break;
+          case vox::link::MSG_DEBUG:  ok = vox::link::decode(rx, st.dbg);    break;
+          case vox::link::MSG_CPU:    ok = vox::link::decode(rx, st.cpu);    break;
+          case vox::link::MSG_POOL:   ok = vox::link::decode(rx, st.pool);   break;
+          default: break;
+        }
+        if (ok) {
+          st.lastFrameMs = millis();
+          changed = true;
+        }
+      }
+      avail = TEENSY_SERIAL.available();
+    }
+
+    if (changed) {
+      st.frames = rx.frames;
+      st.crcErrors = rx.crcErrors;
+      g_pedalSnap.publish(st);
+      wakeUi();
+    }
+  }
+}
 
-// ====================== LVGL tick ======================
-static uint32_t last_ms = 0;
+// ====================== Meters / status (LVGL side) ======================
+static const int      METER_LINK_SEGS = vox::link::Meter::SEGMENTS;   // Teensy meterScale range
+static const int      METER_UI_MAX    = 29;    // X32Meter / IndicatorRight slider range
+static const int32_t  METER_H         = 260;   // clears the nav bar
+static const uint32_t LINK_STALE_MS   = 500;   // meters drop to 0 without frames
+
+static lv_obj_t* g_meterIn  = nullptr;   // X32Meter
+static lv_obj_t* g_meterOut = nullptr;   // IndicatorRight
+static lv_obj_t* g_status   = nullptr;   // level / reverb, on the Reverb panel while it exists
+static bool      g_statusNew = false;     // label (re)built: show the current state
+
+static int meterValue(uint8_t seg)
+{
+  if (seg >= METER_LINK_SEGS) return METER_UI_MAX;
+  return (seg * METER_UI_MAX + METER_LINK_SEGS / 2) / METER_LINK_SEGS;
+}
+
+static lv_obj_t* placeMeter(lv_obj_t* m, int32_t x)
+{
+  lv_obj_remove_flag(m, LV_OBJ_FLAG_CLICKABLE);   // display only
+  lv_obj_set_height(m, METER_H);
+  lv_obj_set_x(m, x);
+  lv_obj_set_y(m, 22);
+  lv_slider_set_value(m, 0, LV_ANIM_OFF);
+  return m;
+}
+
+static void createMeters()
+{
+  // SquareLine exports the components but places no instances
+  g_meterIn  = placeMeter(ui_X32Meter_create(ui_Main), -40);
+  g_meterOut = placeMeter(ui_IndicatorRight_create(ui_Main), -2);
+}
+
+// ui_panels builds panels on first show and may free hidden ones
+static void onPanelShowing(ui_panel_id_t id)
+{
+  (void)id;
+  panelCacheSwitchStart();
+}
+
+static void onPanelCreated(ui_panel_id_t id, lv_obj_t* panel)
+{
+  if (id != UI_PANEL_REVERB) return;
+  g_status = lv_label_create(panel);
+  lv_obj_set_align(g_status, LV_ALIGN_TOP_LEFT);
+  lv_label_set_text(g_status, "No link");
+  panelCacheMarkDynamic(g_status);
+  g_statusNew = true;
+}
+
+static void onPanelShown(ui_panel_id_t id, lv_obj_t* panel)
+{
+  panelCacheShown((int)id, panel);
+}
+
+static void onPanelDeleting(ui_panel_id_t id, lv_obj_t* panel)
+{
+  if (id == UI_PANEL_REVERB) g_status = nullptr;
+  panelCacheDrop(panel);
+}
+
+static const ui_panel_hooks_t PANEL_HOOKS = { onPanelShowing, onPanelCreated, onPanelShown, onPanelDeleting };
+
+// Once per frame: take the newest snapshot, touch only what changed
+static void applyPedalState()
+{
+  static bool    shownUp = false;
+  static uint8_t shownLevel = 0xFF;
+  static int8_t  shownReverb = -1;
+
+  const bool fresh = g_pedalSnap.acquire();
+  const PedalState& st = g_pedalSnap.current();
+  const bool up = st.frames != 0 && (millis() - st.lastFrameMs) < LINK_STALE_MS;
+  if (!fresh && up == shownUp && !g_statusNew) return;
+
+  if (g_meterIn) {
+    // lv_slider_set_value() ignores unchanged values: no redraw
+    lv_slider_set_value(g_meterIn,  up ? meterValue(st.meter.in)  : 0, LV_ANIM_OFF);
+    lv_slider_set_value(g_meterOut, up ? meterValue(st.meter.out) : 0, LV_ANIM_OFF);
+  }
+
+  if (g_status) {
+    const int8_t rev = st.reverb.on ? 1 : 0;
+    if (g_statusNew || up != shownUp || st.level.pct != shownLevel || rev != shownReverb) {
+      if (up) lv_label_set_text_fmt(g_status, "Level %u%%   Reverb %s", (unsigned)st.level.pct, rev ? "ON" : "OFF");
+      else    lv_label_set_text(g_status, "No link");
+      shownLevel = st.level.pct;
+      shownReverb = rev;
+      g_statusNew = false;
+    }
+  }
+  shownUp = up;
+}
+
+// ====================== LVGL tick / scheduler ======================
+// A 1 kHz hardware timer feeds lv_tick_inc(), so LVGL time no longer depends
+// on how long loop() sleeps. loop() runs lv_timer_handler() and then blocks
+// until its next deadline, a touch interrupt or a telemetry update
+static const uint32_t LV_TICK_US     = 1000;
+static const uint32_t LV_IDLE_MAX_MS = 100;    // bounds the link-stale check
+
+static hw_timer_t* g_tickTimer = nullptr;
+
+static void IRAM_ATTR lvTickIsr()
+{
+  lv_tick_inc(LV_TICK_US / 1000);
+}
+
+static void startLvTick()
+{
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  g_tickTimer = timerBegin(1000000);
+  timerAttachInterrupt(g_tickTimer, &lvTickIsr);
+  timerAlarm(g_tickTimer, LV_TICK_US, true, 0);
+#else
+  g_tickTimer = timerBegin(0, 80, true);          // 80 MHz APB / 80 = 1 MHz
+  timerAttachInterrupt(g_tickTimer, &lvTickIsr, true);
+  timerAlarmWrite(g_tickTimer, LV_TICK_US, true);
+  timerAlarmEnable(g_tickTimer);
+#endif
+}
 
 // Set to 1 if you want to force a simple LVGL test screen *instead* of SquareLine UI
 #define LVGL_FORCE_TEST_SCREEN  0
 
 void setup()
 {
+  g_boot.begin(micros());
   Serial.begin(115200);
+  TEENSY_SERIAL.setRxBufferSize(TEENSY_RX_BUF);
+  TEENSY_SERIAL.begin(115200, SERIAL_8N1, TEENSY_RX_PIN, TEENSY_TX_PIN);
   delay(100);
+  bootMark("serial");
 
   // --- TFT ---
   tft.init();
+  bootMark("tft.init");
   tft.setRotation(TFT_ROT);
   tft.setSwapBytes(true);
   tft.fillScreen(TFT_BLACK);
+  bootMark("tft.clear");
 
   // --- LVGL ---
   lv_init();
+  packedImageInit();
+  bootMark("lv_init");
 
   // Create LVGL display and attach flush
   g_disp = lv_display_create(DISP_HOR, DISP_VER);
   lv_display_set_flush_cb(g_disp, my_flush_cb);
 
+  g_buf1 = allocDrawBuf();
+  g_buf2 = allocDrawBuf();
+  if (!g_buf1) {
+    Serial.println("LVGL draw buffer allocation failed");
+    for (;;) delay(1000);
+  }
+  if (!g_buf2) Serial.println("LVGL: one draw buffer only (no DMA overlap)");
+
   // LVGL 9.x (PlatformIO build): 5-arg lv_display_set_buffers
   lv_display_set_buffers(
     g_disp,
     g_buf1,
-    nullptr,
-    BUF_PIXELS * sizeof(lv_color_t),
+    g_buf2,
+    BUF_BYTES,
     LV_DISPLAY_RENDER_MODE_PARTIAL
   );
 
+  // DMA flush: claim the bus for good, the display is its only device
+  tft.initDMA();
+  tft.startWrite();
+  bootMark("display");
+
 #if ENABLE_FT6336U_TOUCH
   // --- Touch I2C ---
   Wire.begin(); // if needed: Wire.begin(SDA, SCL);
-  lv_indev_t* indev = lv_indev_create();
-  lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-  lv_indev_set_read_cb(indev, my_touch_read_cb);
+  g_touch = lv_indev_create();
+  lv_indev_set_type(g_touch, LV_INDEV_TYPE_POINTER);
+  lv_indev_set_read_cb(g_touch, my_touch_read_cb);
+#if FT6336U_INT_PIN >= 0
+  // I2C from here on belongs to the touch task
+  xTaskCreatePinnedToCore(touchTask, "touch", TOUCH_STACK, nullptr, TOUCH_PRIO, &g_touchTask, IO_CORE);
+  pinMode(FT6336U_INT_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(FT6336U_INT_PIN), ftIntIsr, FALLING);
+#endif
+  bootMark("touch");
 #endif
 
 #if LVGL_FORCE_TEST_SCREEN
@@ -156,20 +491,43 @@ void setup()
 #else
   // --- SquareLine UI ---
   ui_init();
+  bootMark("ui_init");
+  createMeters();
+
+  panelCacheInit(g_disp);
+  ui_panels_set_hooks(&PANEL_HOOKS);
 #endif
 
-  last_ms = millis();
+  // --- Teensy link RX (other core) ---
+  xTaskCreatePinnedToCore(linkRxTask, "linkRx", LINK_RX_STACK, nullptr, LINK_RX_PRIO, nullptr, IO_CORE);
+
+  g_uiTask = xTaskGetCurrentTaskHandle();     // setup() and loop() share the Arduino loop task
+  startLvTick();
+  bootMark("setup");
 }
 
 void loop()
 {
-  // LVGL tick increment
-  uint32_t now  = millis();
-  uint32_t diff = now - last_ms;
-  last_ms = now;
+  applyPedalState();
 
-  lv_tick_inc(diff);
-  lv_timer_handler();
+#if ENABLE_FT6336U_TOUCH && FT6336U_INT_PIN >= 0
+  // New touch reading: hand it to LVGL now instead of at the next poll
+  if (g_touchFresh.exchange(false, std::memory_order_acq_rel)) {
+    lv_timer_ready(lv_indev_get_read_timer(g_touch));
+  }
+#endif
+
+  uint32_t nextMs = lv_timer_handler();
+  if (nextMs > LV_IDLE_MAX_MS) nextMs = LV_IDLE_MAX_MS;   // includes LV_NO_TIMER_READY
+
+  if (g_firstFrame && !g_bootDone) {
+    g_bootDone = true;
+    bootMark("first_frame");
+    char line[256];
+    g_boot.format(line, sizeof(line), "ESP32");
+    Serial.print(line);
+  }
 
-  delay(5);
+  // Sleep until the next LVGL deadline or a wake-up, whichever comes first
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(nextMs));
 }
@@ -0,0 +1,205 @@
+// VOX EFX - LVGL decoder for the packed SquareLine images
+// - tools/pack_images.py rewrites lib/squareline_ui/images/ui_img_*.c as
+//   4-bit indexed colour with small per-band palettes plus run-length alpha,
+//   marked LV_COLOR_FORMAT_RAW_ALPHA; this decoder claims those descriptors
+//   by their magic and draws them as RGB565A8
+// - The image stays in flash. open() allocates a CHUNK_ROWS-row draw buffer
+//   and LVGL pulls the image through get_area() a chunk at a time, so a
+//   475x244 panel never needs its 350 KB of RGB565A8 in RAM
+// - Each blit reads 4 bits of index plus a little alpha per pixel from
+//   flash, instead of 24 bits
+//
+// Layout (little-endian):
+//   0   "VXP4"
+//   4   u16 w, u16 h, u8 bandRows, u8 0, u16 bands
+//   12  palettes: bands x 16 x u16 RGB565, band = row / bandRows
+//   ..  indices:  h x (w + 1) / 2 bytes, even pixel in the low nibble
+//   ..  alpha row table: h x u32, offsets into the run stream
+//   ..  alpha runs: per row, (count, value) byte pairs covering w pixels
+
+#include "packed_image.h"
+
+#include <string.h>
+
+extern "C" {
+  #include <lvgl.h>
+}
+
+namespace {
+
+const uint8_t  MAGIC[4]   = { 'V', 'X', 'P', '4' };
+const uint32_t HEADER     = 12;
+const uint32_t COLORS     = 16;
+const int32_t  CHUNK_ROWS = 8;
+
+// Descriptors live in flash and aren't aligned: byte reads only
+inline uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t rd32(const uint8_t* p) { return (uint32_t)rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+
+struct Packed {
+  const uint8_t* pal;
+  const uint8_t* idx;
+  const uint8_t* table;
+  const uint8_t* runs;
+  const uint8_t* end;
+  uint32_t w, h, stride, bandRows;
+};
+
+bool parse(const lv_image_dsc_t* img, Packed& pk)
+{
+  if (img->header.cf != LV_COLOR_FORMAT_RAW_ALPHA || img->data_size < HEADER) return false;
+  const uint8_t* d = img->data;
+  if (memcmp(d, MAGIC, sizeof(MAGIC)) != 0) return false;
+
+  pk.w = rd16(d + 4);
+  pk.h = rd16(d + 6);
+  pk.bandRows = d[8];
+  const uint32_t bands = rd16(d + 10);
+  if (pk.w != img->header.w || pk.h != img->header.h || pk.bandRows == 0) return false;
+  if (bands * pk.bandRows < pk.h) return false;
+
+  pk.stride = (pk.w + 1) / 2;
+  pk.pal    = d + HEADER;
+  pk.idx    = pk.pal + bands * COLORS * 2;
+  pk.table  = pk.idx + pk.stride * pk.h;
+  pk.runs   = pk.table + 4 * pk.h;
+  pk.end    = d + img->data_size;
+  return pk.runs <= pk.end;
+}
+
+// One full row into RGB565 + A8
+void decodeRow(const Packed& pk, uint32_t y, uint16_t* color, uint8_t* alpha)
+{
+  uint16_t lut[COLORS];
+  const uint8_t* pal = pk.pal + (y / pk.bandRows) * COLORS * 2;
+  for (uint32_t i = 0; i < COLORS; i++) lut[i] = rd16(pal + 2 * i);
+
+  const uint8_t* ix = pk.idx + y * pk.stride;
+  uint32_t x = 0;
+  for (; x + 1 < pk.w; x += 2) {
+    const uint8_t b = *ix++;
+    color[x]     = lut[b & 0x0F];
+    color[x + 1] = lut[b >> 4];
+  }
+  if (x < pk.w) color[x] = lut[*ix & 0x0F];
+
+  // A corrupt run stream leaves the rest of the row transparent
+  const uint8_t* r = pk.runs + rd32(pk.table + 4 * y);
+  x = 0;
+  while (x < pk.w) {
+    uint32_t n = (r + 2 <= pk.end) ? r[0] : 0;
+    if (n == 0) {
+      memset(alpha + x, 0, pk.w - x);
+      break;
+    }
+    if (n > pk.w - x) n = pk.w - x;
+    memset(alpha + x, r[1], n);
+    x += n;
+    r += 2;
+  }
+}
+
+struct State {
+  Packed pk;
+  lv_draw_buf_t* buf;      // CHUNK_ROWS x w, RGB565A8
+};
+
+const lv_image_dsc_t* packedSrc(const void* src)
+{
+  if (lv_image_src_get_type(src) != LV_IMAGE_SRC_VARIABLE) return nullptr;
+  return (const lv_image_dsc_t*)src;
+}
+
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR < 2
+lv_result_t infoCb(lv_image_decoder_t* decoder, const void* src, lv_image_header_t* header)
+{
+#else
+lv_result_t infoCb(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc, lv_image_header_t* header)
+{
+  const void* src = dsc->src;
+#endif
+  (void)decoder;
+  const lv_image_dsc_t* img = packedSrc(src);
+  Packed pk;
+  if (!img || !parse(img, pk)) return LV_RESULT_INVALID;
+
+  *header = img->header;
+  header->cf = LV_COLOR_FORMAT_RGB565A8;
+  header->stride = pk.w * 2;
+  return LV_RESULT_OK;
+}
+
+lv_result_t openCb(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc)
+{
+  (void)decoder;
+  const lv_image_dsc_t* img = packedSrc(dsc->src);
+  Packed pk;
+  if (!img || !parse(img, pk)) return LV_RESULT_INVALID;
+
+  State* st = (State*)lv_malloc(sizeof(State));
+  if (!st) return LV_RESULT_INVALID;
+  st->pk = pk;
+  st->buf = lv_draw_buf_create(pk.w, CHUNK_ROWS, LV_COLOR_FORMAT_RGB565A8, 0);
+  if (!st->buf) {
+    lv_free(st);
+    return LV_RESULT_INVALID;
+  }
+
+  dsc->user_data = st;
+  dsc->decoded = nullptr;          // drawn chunk by chunk through get_area()
+  return LV_RESULT_OK;
+}
+
+// Decodes the next CHUNK_ROWS rows of full_area (full width; LVGL clips).
+// decoded_area->y1 == LV_COORD_MIN on the first call
+lv_result_t getAreaCb(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc,
+                      const lv_area_t* full_area, lv_area_t* decoded_area)
+{
+  (void)decoder;
+  State* st = (State*)dsc->user_data;
+  const Packed& pk = st->pk;
+
+  const int32_t y0 = (decoded_area->y1 == LV_COORD_MIN) ? LV_MAX(full_area->y1, 0) : decoded_area->y2 + 1;
+  const int32_t last = LV_MIN(full_area->y2, (int32_t)pk.h - 1);
+  if (y0 > last) return LV_RESULT_INVALID;
+  const int32_t rows = LV_MIN(CHUNK_ROWS, last - y0 + 1);
+
+  // RGB565A8 is planar: the alpha rows follow all colour rows at half the stride
+  lv_draw_buf_t* buf = st->buf;
+  buf->header.h = rows;
+  const uint32_t stride = buf->header.stride;
+  uint8_t* color = buf->data;
+  uint8_t* alpha = buf->data + stride * rows;
+  for (int32_t r = 0; r < rows; r++) {
+    decodeRow(pk, y0 + r, (uint16_t*)(color + r * stride), alpha + r * (stride / 2));
+  }
+
+  decoded_area->x1 = 0;
+  decoded_area->x2 = pk.w - 1;
+  decoded_area->y1 = y0;
+  decoded_area->y2 = y0 + rows - 1;
+  dsc->decoded = buf;
+  return LV_RESULT_OK;
+}
+
+void closeCb(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc)
+{
+  (void)decoder;
+  State* st = (State*)dsc->user_data;
+  if (!st) return;
+  lv_draw_buf_destroy(st->buf);
+  lv_free(st);
+  dsc->user_data = nullptr;
+  dsc->decoded = nullptr;
+}
+
+} // namespace
+
+void packedImageInit()
+{
+  lv_image_decoder_t* dec = lv_image_decoder_create();
+  lv_image_decoder_set_info_cb(dec, infoCb);
+  lv_image_decoder_set_open_cb(dec, openCb);
+  lv_image_decoder_set_get_area_cb(dec, getAreaCb);
+  lv_image_decoder_set_close_cb(dec, closeCb);
+}
@@ -0,0 +1,6 @@
+// VOX EFX - LVGL decoder for the packed SquareLine images (tools/pack_images.py)
+
+#pragma once
+
+// Registers the decoder; call once after lv_init()
+void packedImageInit();
@@ -0,0 +1,724 @@
+// VOX EFX - pre-rendered panel backgrounds (see panel_cache.h)
+// - Capture: when ui_panels reports a panel shown and flash has no current
+//   capture of it, an lv_timer renders the screen under the panel offscreen,
+//   STAGE_ROWS rows per tick, into a RAM staging buffer, with the panel's
+//   dynamic children and everything drawn over it (later siblings of it and
+//   of its ancestors) hidden for that render only. The display never sees
+//   the hidden state. Each full stage goes to the "panelFlash" task. After
+//   the last one the task appends a directory record, and the next tick
+//   installs the capture
+// - The LVGL thread never writes or erases flash. The panelFlash task does
+//   all of it: lowest priority, on the core LVGL doesn't use. It programs
+//   one page per call and erases one 4 KB sector per call, with a tick's
+//   pause between bursts. The flash cache is off on both cores during each
+//   call, so these are kept short. Free slots are erased ahead of time, at
+//   boot and after a capture is dropped, so a first visit doesn't wait for
+//   an erase
+// - Records are CRC-checked once, by the task at boot. A switch to a
+//   cached panel then only maps its slot
+// - Partition: a directory in the first 64 KB block, then SLOT_SIZE slots
+//     directory: | Record | Record | ... | FF ...   (append-only, the
+//     newest record of a panel id with this build's hash wins; erased and
+//     rewritten from RAM when full)
+//     slot:      w * h RGB565 pixels, row-major, as LVGL renders them
+//   Slots and the directory sit on 64 KB boundaries: erase blocks and mmap
+//   pages. A capture cut short by power loss has no record, so its slot is
+//   erased again at the next boot
+// - A cached panel keeps its size and padding but stops drawing its own
+//   background, border and shadow (the capture already has them, and what
+//   was behind the panel)
+// - Switch time = start of ui_panel_show() (including building the panel)
+//   to the end of the next display refresh
+
+#include "panel_cache.h"
+
+#include <Arduino.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+extern "C" {
+  #include <src/display/lv_display_private.h>   // layer_head, for the offscreen render
+}
+
+#ifndef PANEL_CACHE
+#define PANEL_CACHE 1
+#endif
+
+namespace {
+
+const int MAX_PANELS = 8;
+const int MAX_SLOTS  = 16;
+const int MAX_HIDDEN = 32;
+const lv_obj_flag_t DYNAMIC = LV_OBJ_FLAG_USER_1;
+
+const esp_partition_subtype_t PARTITION_SUBTYPE = (esp_partition_subtype_t)0x40;
+const uint32_t BLOCK     = 0x10000;    // erase block and mmap page
+const uint32_t SECTOR    = 0x1000;     // smallest erase
+const uint32_t PAGE      = 0x100;      // one flash program operation
+const uint32_t DIR_SIZE  = 0x1000;     // directory: first sector of block 0
+const uint32_t SLOT_SIZE = 0x40000;    // up to 480 x 273 RGB565
+const uint32_t FORMAT    = 1;          // bump when the slot layout changes
+
+const int32_t  STAGE_ROWS  = 16;       // rows per offscreen render and flash hand-over
+const uint32_t STEP_MS     = 10;       // capture timer period
+const uint32_t FLASH_BURST = 0x400;    // bytes programmed between pauses
+
+// panelFlash task: below everything else on the IO core
+const UBaseType_t FLASH_PRIO  = 1;
+const uint32_t    FLASH_STACK = 3072;
+const BaseType_t  FLASH_CORE  = ARDUINO_RUNNING_CORE ? 0 : 1;
+
+struct Record {
+  uint32_t hash;                       // uiHash() of the build that captured it
+  uint32_t crc;                        // of the w * h * 2 pixel bytes
+  uint16_t w, h;
+  uint8_t  id, slot;
+  uint8_t  pad[2];
+  uint32_t check;                      // of the fields above: a torn record fails it
+};
+const int DIR_RECORDS = DIR_SIZE / sizeof(Record);
+
+// Each transition has one writer: the task checks ids at boot and marks
+// them READY on a commit, LVGL drops a READY one whose size changed.
+// DIRTY -> BLANK is the task's, BLANK -> TAKEN -> DIRTY LVGL's
+enum IdState : uint8_t { ID_UNCHECKED, ID_READY, ID_NONE };
+enum SlotState : uint8_t { SLOT_DIRTY, SLOT_BLANK, SLOT_TAKEN };
+
+// LVGL -> task requests: LVGL posts PENDING, the task answers DONE or
+// FAILED, LVGL takes the answer back to IDLE
+enum Job : uint8_t { JOB_IDLE, JOB_PENDING, JOB_DONE, JOB_FAILED };
+
+struct Entry {
+  lv_obj_t*               panel;
+  int                     id;
+  lv_image_dsc_t          snap;
+  spi_flash_mmap_handle_t map;
+  bool                    mapped;
+  bool                    cached;
+  bool                    failed;
+};
+
+struct Capture {                       // the panel being rendered to flash
+  Entry*        e = nullptr;           // nullptr: dropped mid-capture
+  int           id = -1;
+  int           slot = -1;             // -1: no capture
+  lv_area_t     area = {};             // screen coordinates
+  int32_t       row = 0;               // next row to render, area-relative
+  uint32_t      crc = 0;
+  uint8_t*      buf = nullptr;         // STAGE_ROWS rows
+  lv_draw_buf_t draw = {};
+  bool          committing = false;
+  int64_t       startUs = 0;
+};
+
+struct Stage {                         // rows for the task to program
+  uint32_t       offset;
+  const uint8_t* data;
+  uint32_t       bytes;
+};
+
+Entry g_entries[MAX_PANELS];           // panel == nullptr: free slot
+Entry* g_current = nullptr;            // the visible panel
+bool  g_enabled = false;
+lv_style_t g_shell;                    // cached panel: transparent, same geometry
+lv_display_t* g_disp = nullptr;
+lv_timer_t* g_step = nullptr;
+Capture g_cap;
+
+const esp_partition_t* g_part = nullptr;
+int     g_slots = 0;
+Record  g_dir[MAX_PANELS];             // current record per panel id (written by the task)
+int     g_dirNext = 0;                 // first erased record (the task's)
+TaskHandle_t g_flashTask = nullptr;
+
+std::atomic<uint8_t> g_idState[MAX_PANELS];
+std::atomic<uint8_t> g_slotState[MAX_SLOTS];
+std::atomic<uint8_t> g_stageJob(JOB_IDLE);
+std::atomic<uint8_t> g_commitJob(JOB_IDLE);
+Stage  g_stage;                        // read by the task while g_stageJob is PENDING
+Record g_commit;                       // read by the task while g_commitJob is PENDING
+
+int64_t g_switchStartUs = -1;
+bool    g_switchCached = false;
+
+uint32_t uiHash()
+{
+#ifdef UI_HASH
+  return (uint32_t)UI_HASH ^ FORMAT;
+#else
+  // No build-time hash: any firmware change counts as a UI change
+  const uint8_t* sha = esp_ota_get_app_description()->app_elf_sha256;
+  return ((uint32_t)sha[0] | (uint32_t)sha[1] << 8 | (uint32_t)sha[2] << 16 | (uint32_t)sha[3] << 24) ^ FORMAT;
+#endif
+}
+
+uint32_t slotOffset(int slot) { return BLOCK + (uint32_t)slot * SLOT_SIZE; }
+
+uint32_t mapBytes(uint32_t bytes) { return (bytes + BLOCK - 1) & ~(BLOCK - 1); }
+
+uint32_t recordCheck(const Record& r)
+{
+  return esp_rom_crc32_le(0, (const uint8_t*)&r, offsetof(Record, check));
+}
+
+void wakeFlash()
+{
+  if (g_flashTask) xTaskNotifyGive(g_flashTask);
+}
+
+// ====================== panelFlash task ======================
+
+// From panelCacheInit(), before the task starts
+void loadDirectory()
+{
+  const uint32_t hash = uiHash();
+  g_dirNext = DIR_RECORDS;
+  for (int i = 0; i < DIR_RECORDS; i++) {
+    Record r;
+    if (esp_partition_read(g_part, i * sizeof(Record), &r, sizeof(r)) != ESP_OK) break;
+    const uint8_t* b = (const uint8_t*)&r;
+    bool erased = true;
+    for (size_t k = 0; k < sizeof(r) && erased; k++) erased = b[k] == 0xFF;
+    if (erased) {
+      g_dirNext = i;
+      break;
+    }
+    if (r.check != recordCheck(r) || r.hash != hash || r.id >= MAX_PANELS || r.slot >= g_slots) continue;
+    g_dir[r.id] = r;
+    g_idState[r.id].store(ID_UNCHECKED, std::memory_order_relaxed);
+  }
+}
+
+// Records whose pixels still match become READY and their slots TAKEN;
+// every other slot stays DIRTY and is erased next
+void verifyRecords()
+{
+  for (int id = 0; id < MAX_PANELS; id++) {
+    if (g_idState[id].load(std::memory_order_relaxed) != ID_UNCHECKED) continue;
+    const Record& r = g_dir[id];
+    const uint32_t bytes = (uint32_t)r.w * r.h * 2;
+    const void* ptr = nullptr;
+    spi_flash_mmap_handle_t map;
+    bool ok = false;
+    if (esp_partition_mmap(g_part, slotOffset(r.slot), mapBytes(bytes), SPI_FLASH_MMAP_DATA, &ptr, &map) == ESP_OK) {
+      ok = esp_rom_crc32_le(0, (const uint8_t*)ptr, bytes) == r.crc;
+      spi_flash_munmap(map);
+    }
+    if (ok) g_slotState[r.slot].store(SLOT_TAKEN, std::memory_order_relaxed);
+    g_idState[id].store(ok ? ID_READY : ID_NONE, std::memory_order_release);
+  }
+}
+
+bool writeRecord(const Record& r)
+{
+  if (esp_partition_write(g_part, g_dirNext * sizeof(Record), &r, sizeof(r)) != ESP_OK) return false;
+  g_dirNext++;
+  return true;
+}
+
+// Full directory: erase it and write back the current records
+bool appendRecord(Record r)
+{
+  r.check = recordCheck(r);
+  if (g_dirNext >= DIR_RECORDS) {
+    if (esp_partition_erase_range(g_part, 0, DIR_SIZE) != ESP_OK) return false;
+    g_dirNext = 0;
+    for (int id = 0; id < MAX_PANELS; id++) {
+      if (id == r.id || g_idState[id].load(std::memory_order_relaxed) != ID_READY) continue;
+      if (!writeRecord(g_dir[id])) return false;
+    }
+  }
+  if (!writeRecord(r)) return false;
+  g_dir[r.id] = r;
+  g_idState[r.id].store(ID_READY, std::memory_order_release);
+  return true;
+}
+
+// One page per write, so each cache-off window is a single page program
+bool programStage()
+{
+  const Stage& s = g_stage;
+  uint32_t done = 0, burst = 0;
+  while (done < s.bytes) {
+    uint32_t n = PAGE - (s.offset + done) % PAGE;
+    if (n > s.bytes - done) n = s.bytes - done;
+    if (esp_partition_write(g_part, s.offset + done, s.data + done, n) != ESP_OK) return false;
+    done += n;
+    burst += n;
+    if (burst >= FLASH_BURST) {
+      burst = 0;
+      vTaskDelay(1);
+    }
+  }
+  return true;
+}
+
+// Sectors of a slot that hold anything: only those need erasing
+uint64_t writtenSectors(int slot)
+{
+  const void* ptr = nullptr;
+  spi_flash_mmap_handle_t map;
+  if (esp_partition_mmap(g_part, slotOffset(slot), SLOT_SIZE, SPI_FLASH_MMAP_DATA, &ptr, &map) != ESP_OK) {
+    return ~0ull;
+  }
+  uint64_t written = 0;
+  const uint32_t* w = (const uint32_t*)ptr;
+  for (uint32_t s = 0; s < SLOT_SIZE / SECTOR; s++) {
+    for (uint32_t i = 0; i < SECTOR / 4; i++) {
+      if (w[s * (SECTOR / 4) + i] != 0xFFFFFFFFu) {
+        written |= 1ull << s;
+        break;
+      }
+    }
+  }
+  spi_flash_munmap(map);
+  return written;
+}
+
+// One sector of the first dirty slot; false: nothing left to erase
+bool eraseStep()
+{
+  static int slot = -1;
+  static uint64_t left = 0;
+  if (slot < 0) {
+    for (int s = 0; s < g_slots && slot < 0; s++) {
+      if (g_slotState[s].load(std::memory_order_acquire) == SLOT_DIRTY) slot = s;
+    }
+    if (slot < 0) return false;
+    left = writtenSectors(slot);
+  }
+  if (left) {
+    const int s = __builtin_ctzll(left);
+    left &= left - 1;
+    if (esp_partition_erase_range(g_part, slotOffset(slot) + s * SECTOR, SECTOR) != ESP_OK) {
+      g_slotState[slot].store(SLOT_TAKEN, std::memory_order_release);   // unusable this boot
+      slot = -1;
+    }
+    vTaskDelay(1);
+    return true;
+  }
+  g_slotState[slot].store(SLOT_BLANK, std::memory_order_release);
+  slot = -1;
+  return true;
+}
+
+// Stage and commit requests go before erasing, so a capture waits for at
+// most one sector erase per stage
+void flashTask(void* arg)
+{
+  (void)arg;
+  verifyRecords();
+  for (;;) {
+    bool busy = false;
+    if (g_stageJob.load(std::memory_order_acquire) == JOB_PENDING) {
+      g_stageJob.store(programStage() ? JOB_DONE : JOB_FAILED, std::memory_order_release);
+      busy = true;
+    }
+    if (g_commitJob.load(std::memory_order_acquire) == JOB_PENDING) {
+      g_commitJob.store(appendRecord(g_commit) ? JOB_DONE : JOB_FAILED, std::memory_order_release);
+      busy = true;
+    }
+    if (!busy && !eraseStep()) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+}
+
+// ====================== LVGL side ======================
+
+bool mapSlot(Entry& e, int slot, uint32_t bytes)
+{
+  const void* ptr = nullptr;
+  if (esp_partition_mmap(g_part, slotOffset(slot), mapBytes(bytes), SPI_FLASH_MMAP_DATA, &ptr, &e.map) != ESP_OK) {
+    return false;
+  }
+  e.mapped = true;
+  e.snap.data = (const uint8_t*)ptr;
+  return true;
+}
+
+void unmap(Entry& e)
+{
+  if (!e.mapped) return;
+  lv_image_cache_drop(&e.snap);
+  spi_flash_munmap(e.map);
+  e.mapped = false;
+}
+
+// Panel area on screen, clipped to the display
+lv_area_t panelArea(lv_obj_t* p)
+{
+  lv_area_t a;
+  lv_obj_get_coords(p, &a);
+  a.x1 = LV_MAX(a.x1, 0);
+  a.y1 = LV_MAX(a.y1, 0);
+  a.x2 = LV_MIN(a.x2, lv_display_get_horizontal_resolution(g_disp) - 1);
+  a.y2 = LV_MIN(a.y2, lv_display_get_vertical_resolution(g_disp) - 1);
+  return a;
+}
+
+bool overlaps(const lv_area_t& a, const lv_area_t& b)
+{
+  return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+}
+
+// Shows the mapped capture in place of the panel's static children
+void install(Entry& e, const Record& r)
+{
+  lv_obj_t* p = e.panel;
+  e.snap.header.magic  = LV_IMAGE_HEADER_MAGIC;
+  e.snap.header.cf     = LV_COLOR_FORMAT_RGB565;
+  e.snap.header.w      = r.w;
+  e.snap.header.h      = r.h;
+  e.snap.header.stride = r.w * 2;
+  e.snap.data_size     = (uint32_t)r.w * r.h * 2;
+
+  // Geometry before the shell style: the image goes where the capture came
+  // from, border and padding included
+  lv_area_t coords;
+  lv_obj_get_coords(p, &coords);
+  const lv_area_t a = panelArea(p);
+  const int32_t bw = lv_obj_get_style_border_width(p, LV_PART_MAIN);
+  const int32_t x  = a.x1 - coords.x1 - lv_obj_get_style_pad_left(p, LV_PART_MAIN) - bw;
+  const int32_t y  = a.y1 - coords.y1 - lv_obj_get_style_pad_top(p, LV_PART_MAIN) - bw;
+
+  const uint32_t count = lv_obj_get_child_count(p);
+  for (uint32_t i = 0; i < count; i++) {
+    lv_obj_t* c = lv_obj_get_child(p, i);
+    if (!lv_obj_has_flag(c, DYNAMIC)) lv_obj_add_flag(c, LV_OBJ_FLAG_HIDDEN);
+  }
+  lv_obj_add_style(p, &g_shell, LV_PART_MAIN);
+
+  lv_obj_t* img = lv_image_create(p);
+  lv_obj_move_to_index(img, 0);
+  lv_obj_add_flag(img, LV_OBJ_FLAG_IGNORE_LAYOUT);
+  lv_obj_remove_flag(img, LV_OBJ_FLAG_CLICKABLE);
+  lv_image_set_src(img, &e.snap);
+  lv_obj_set_pos(img, x, y);
+  e.cached = true;
+}
+
+// The checked capture, if it is the panel's size. One that isn't is
+// dropped and its slot goes back to the task for erasing
+bool restore(Entry& e)
+{
+  if (g_idState[e.id].load(std::memory_order_acquire) != ID_READY) return false;
+  const Record& r = g_dir[e.id];
+  lv_obj_update_layout(e.panel);
+  const lv_area_t a = panelArea(e.panel);
+  if (r.w != a.x2 - a.x1 + 1 || r.h != a.y2 - a.y1 + 1) {
+    g_idState[e.id].store(ID_NONE, std::memory_order_relaxed);
+    g_slotState[r.slot].store(SLOT_DIRTY, std::memory_order_release);
+    wakeFlash();
+    return false;
+  }
+  if (!mapSlot(e, r.slot, (uint32_t)r.w * r.h * 2)) {
+    e.failed = true;
+    return false;
+  }
+  install(e, r);
+  return true;
+}
+
+void logCapture(int id, const char* result)
+{
+  const long us = g_cap.startUs ? (long)(esp_timer_get_time() - g_cap.startUs) : 0;
+  Serial.printf("PANEL,capture,id=%d,us=%ld,result=%s\n", id, us, result);
+}
+
+// Only with no stage pending: frees the buffer and, unless the capture was
+// committed, hands its slot back for erasing
+void endCapture(const char* result, bool committed)
+{
+  if (!committed) {
+    g_slotState[g_cap.slot].store(SLOT_DIRTY, std::memory_order_release);
+    wakeFlash();
+  }
+  free(g_cap.buf);
+  logCapture(g_cap.id, result);
+  g_cap = Capture();
+}
+
+// Renders rows y1 .. y2 of the screen under the capture area into the stage
+void renderStage(int32_t y1, int32_t y2)
+{
+  Capture& c = g_cap;
+  lv_obj_t* p = c.e->panel;
+  lv_obj_t* hidden[MAX_HIDDEN];
+  int nHidden = 0;
+  auto hide = [&](lv_obj_t* o) {
+    if (nHidden >= MAX_HIDDEN || lv_obj_has_flag(o, LV_OBJ_FLAG_HIDDEN)) return;
+    lv_obj_add_flag(o, LV_OBJ_FLAG_HIDDEN);
+    hidden[nHidden++] = o;
+  };
+
+  const uint32_t count = lv_obj_get_child_count(p);
+  for (uint32_t i = 0; i < count; i++) {
+    lv_obj_t* ch = lv_obj_get_child(p, i);
+    if (lv_obj_has_flag(ch, DYNAMIC)) hide(ch);
+  }
+  // Whatever is drawn after the panel and over it (meters on the screen)
+  for (lv_obj_t* o = p; lv_obj_get_parent(o); o = lv_obj_get_parent(o)) {
+    lv_obj_t* parent = lv_obj_get_parent(o);
+    const uint32_t n = lv_obj_get_child_count(parent);
+    for (uint32_t i = lv_obj_get_index(o) + 1; i < n; i++) {
+      lv_obj_t* ch = lv_obj_get_child(parent, i);
+      lv_area_t ca;
+      lv_obj_get_coords(ch, &ca);
+      if (overlaps(ca, c.area)) hide(ch);
+    }
+  }
+
+  // As lv_snapshot_take_to_draw_buf(), clipped to the stage's rows of the screen
+  const int32_t w = c.area.x2 - c.area.x1 + 1, rows = y2 - y1 + 1;
+  lv_draw_buf_init(&c.draw, w, rows, LV_COLOR_FORMAT_RGB565, w * 2, c.buf, w * rows * 2);
+  lv_layer_t layer;
+  memset(&layer, 0, sizeof(layer));
+  layer.draw_buf = &c.draw;
+  layer.buf_area = { c.area.x1, y1, c.area.x2, y2 };
+  layer.color_format = LV_COLOR_FORMAT_RGB565;
+  layer._clip_area = layer.buf_area;
+
+  lv_display_t* refreshing = _lv_refr_get_disp_refreshing();
+  lv_layer_t* head = g_disp->layer_head;
+  g_disp->layer_head = &layer;
+  _lv_refr_set_disp_refreshing(g_disp);
+  lv_obj_redraw(&layer, lv_display_get_screen_active(g_disp));
+  while (layer.draw_task_head) {
+    lv_draw_dispatch_wait_for_request();
+    lv_draw_dispatch();
+  }
+  g_disp->layer_head = head;
+  _lv_refr_set_disp_refreshing(refreshing);
+
+  for (int i = 0; i < nHidden; i++) lv_obj_remove_flag(hidden[i], LV_OBJ_FLAG_HIDDEN);
+}
+
+// Starts a capture of e in a blank slot, or gives up on e; false: no slot
+// is blank yet but the task is erasing one
+bool startCapture(Entry& e)
+{
+  lv_obj_update_layout(e.panel);
+  const lv_area_t a = panelArea(e.panel);
+  const int32_t w = a.x2 - a.x1 + 1, h = a.y2 - a.y1 + 1;
+  if (w <= 0 || h <= 0 || (uint32_t)w * h * 2 > SLOT_SIZE) {
+    e.failed = true;
+    logCapture(e.id, "too_big");
+    return true;
+  }
+
+  int slot = -1;
+  bool erasing = false;
+  for (int s = 0; s < g_slots && slot < 0; s++) {
+    const uint8_t st = g_slotState[s].load(std::memory_order_acquire);
+    if (st == SLOT_BLANK) slot = s;
+    erasing |= st == SLOT_DIRTY;
+  }
+  if (slot < 0) {
+    if (erasing) return false;
+    e.failed = true;
+    logCapture(e.id, "no_slot");
+    return true;
+  }
+
+  uint8_t* buf = (uint8_t*)malloc(w * STAGE_ROWS * 2);
+  if (!buf) {
+    e.failed = true;
+    logCapture(e.id, "no_memory");
+    return true;
+  }
+  g_slotState[slot].store(SLOT_TAKEN, std::memory_order_relaxed);
+  g_cap = Capture();
+  g_cap.e = &e;
+  g_cap.id = e.id;
+  g_cap.slot = slot;
+  g_cap.area = a;
+  g_cap.buf = buf;
+  g_cap.startUs = esp_timer_get_time();
+  return true;
+}
+
+// One timer tick of a capture: wait for the task, render the next stage,
+// commit after the last one, install once committed
+void stepCapture()
+{
+  Capture& c = g_cap;
+  const uint8_t stage = g_stageJob.load(std::memory_order_acquire);
+  if (stage == JOB_PENDING) return;
+  g_stageJob.store(JOB_IDLE, std::memory_order_relaxed);
+  if (stage == JOB_FAILED) {
+    if (c.e) c.e->failed = true;
+    endCapture("write_failed", false);
+    return;
+  }
+
+  const int32_t w = c.area.x2 - c.area.x1 + 1, h = c.area.y2 - c.area.y1 + 1;
+  if (c.committing) {
+    const uint8_t commit = g_commitJob.load(std::memory_order_acquire);
+    if (commit == JOB_PENDING) return;
+    g_commitJob.store(JOB_IDLE, std::memory_order_relaxed);
+    if (commit != JOB_DONE) {
+      if (c.e) c.e->failed = true;
+      endCapture("dir_failed", false);
+      return;
+    }
+    Entry* e = c.e;
+    const bool ok = !e || mapSlot(*e, c.slot, (uint32_t)w * h * 2);
+    if (e && ok) install(*e, g_commit);
+    if (e && !ok) e->failed = true;
+    endCapture(ok ? "ok" : "map_failed", true);
+    return;
+  }
+
+  // Dropped, or hidden (a hidden panel doesn't render): tried again on its next show
+  if (!c.e || c.e != g_current) {
+    endCapture(c.e ? "hidden" : "dropped", false);
+    return;
+  }
+
+  if (c.row >= h) {
+    Record& r = g_commit;
+    r = Record();
+    r.hash = uiHash();
+    r.crc = c.crc;
+    r.w = (uint16_t)w;
+    r.h = (uint16_t)h;
+    r.id = (uint8_t)c.id;
+    r.slot = (uint8_t)c.slot;
+    g_commitJob.store(JOB_PENDING, std::memory_order_release);
+    wakeFlash();
+    c.committing = true;
+    return;
+  }
+
+  const int32_t rows = LV_MIN(STAGE_ROWS, h - c.row);
+  renderStage(c.area.y1 + c.row, c.area.y1 + c.row + rows - 1);
+  const uint32_t bytes = (uint32_t)w * rows * 2;
+  c.crc = esp_rom_crc32_le(c.crc, c.buf, bytes);
+  g_stage.offset = slotOffset(c.slot) + (uint32_t)c.row * w * 2;
+  g_stage.data = c.buf;
+  g_stage.bytes = bytes;
+  g_stageJob.store(JOB_PENDING, std::memory_order_release);
+  wakeFlash();
+  c.row += rows;
+}
+
+// Capture timer: runs while the visible panel has no capture installed
+void onStep(lv_timer_t* t)
+{
+  if (g_cap.slot >= 0) {
+    stepCapture();
+    return;
+  }
+  Entry* e = g_current;
+  if (!e || e->cached || e->failed) {
+    lv_timer_pause(t);
+    return;
+  }
+  const uint8_t state = g_idState[e->id].load(std::memory_order_acquire);
+  if (state == ID_UNCHECKED) return;           // the task is still checking records
+  if (state == ID_READY && (restore(*e) || e->failed)) return;
+  startCapture(*e);
+}
+
+Entry* find(lv_obj_t* panel)
+{
+  for (Entry& e : g_entries) {
+    if (e.panel == panel) return &e;
+  }
+  return nullptr;
+}
+
+void onRefrReady(lv_event_t* ev)
+{
+  (void)ev;
+  if (g_switchStartUs < 0) return;
+  const int64_t us = esp_timer_get_time() - g_switchStartUs;
+  g_switchStartUs = -1;
+
+  Serial.print("PANEL,");
+  Serial.print(g_switchCached ? "cached" : "live");
+  Serial.print(",switch_us=");
+  Serial.print((long)us);
+  Serial.println();
+}
+
+} // namespace
+
+void panelCacheInit(lv_display_t* disp)
+{
+  g_disp = disp;
+  g_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, PARTITION_SUBTYPE, "panels");
+  g_slots = g_part && g_part->size > BLOCK ? (int)((g_part->size - BLOCK) / SLOT_SIZE) : 0;
+  if (g_slots > MAX_SLOTS) g_slots = MAX_SLOTS;
+  g_enabled = PANEL_CACHE && g_slots > 0;
+  for (int id = 0; id < MAX_PANELS; id++) g_idState[id].store(ID_NONE, std::memory_order_relaxed);
+  for (int s = 0; s < MAX_SLOTS; s++) g_slotState[s].store(SLOT_DIRTY, std::memory_order_relaxed);
+  if (g_enabled) loadDirectory();
+
+  lv_style_init(&g_shell);
+  lv_style_set_bg_opa(&g_shell, LV_OPA_TRANSP);
+  lv_style_set_border_opa(&g_shell, LV_OPA_TRANSP);
+  lv_style_set_shadow_opa(&g_shell, LV_OPA_TRANSP);
+  lv_style_set_outline_opa(&g_shell, LV_OPA_TRANSP);
+
+  lv_display_add_event_cb(disp, onRefrReady, LV_EVENT_REFR_READY, nullptr);
+  if (!g_enabled) {
+    Serial.println("PANEL,cache=off");
+    return;
+  }
+  g_step = lv_timer_create(onStep, STEP_MS, nullptr);
+  lv_timer_pause(g_step);
+  xTaskCreatePinnedToCore(flashTask, "panelFlash", FLASH_STACK, nullptr, FLASH_PRIO, &g_flashTask, FLASH_CORE);
+
+  int stored = 0;
+  for (int id = 0; id < MAX_PANELS; id++) stored += g_idState[id].load(std::memory_order_relaxed) == ID_UNCHECKED;
+  Serial.printf("PANEL,cache=flash,slots=%d,stored=%d,hash=%08lx\n", g_slots, stored, (unsigned long)uiHash());
+}
+
+void panelCacheSwitchStart()
+{
+  g_switchStartUs = esp_timer_get_time();
+}
+
+void panelCacheShown(int id, lv_obj_t* panel)
+{
+  g_current = nullptr;
+  Entry* e = find(panel);
+  if (!e) {
+    e = find(nullptr);
+    if (!e) return;
+    *e = Entry();
+    e->panel = panel;
+    e->id = id;
+  }
+  if (g_switchStartUs < 0) g_switchStartUs = esp_timer_get_time();
+  g_switchCached = e->cached;
+
+  if (!g_enabled || id < 0 || id >= MAX_PANELS) return;
+  g_current = e;
+  if (e->cached || e->failed) return;
+  if (restore(*e)) {
+    g_switchCached = true;
+    return;
+  }
+  lv_timer_resume(g_step);                     // capture it, or wait for the boot check
+}
+
+void panelCacheDrop(lv_obj_t* panel)
+{
+  Entry* e = find(panel);
+  if (!e) return;
+  if (g_cap.e == e) g_cap.e = nullptr;         // the next tick ends the capture
+  if (g_current == e) g_current = nullptr;
+  unmap(*e);
+  *e = Entry();
+}
+
+void panelCacheMarkDynamic(lv_obj_t* obj)
+{
+  lv_obj_add_flag(obj, DYNAMIC);
+}
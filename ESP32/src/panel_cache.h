@@ -0,0 +1,36 @@
+// VOX EFX - pre-rendered panel backgrounds for page switching
+// - The first time a panel is shown, it is rendered offscreen a few rows at
+//   a time and written to the "panels" flash partition (partitions.csv) by
+//   a low-priority task, never from the LVGL thread. From then on the panel
+//   is an RGB565 image of that capture, read in place through the flash
+//   cache (no RAM copy, no PSRAM needed), with only its dynamic children
+//   drawn live on top
+// - A capture is kept across reboots while its UI_HASH (the SquareLine
+//   export and lv_conf.h, set by tools/pack_images.py) and pixel CRC match,
+//   so flash is written once per panel per UI change
+// - Static = every child not passed to panelCacheMarkDynamic(); a static
+//   child must not change after its panel has been captured
+// - Off without the partition, or with -DPANEL_CACHE=0; switch times are
+//   logged to Serial either way ("PANEL,..."), so the two can be compared
+
+#pragma once
+
+extern "C" {
+  #include <lvgl.h>
+}
+
+// Call after ui_init()
+void panelCacheInit(lv_display_t* disp);
+
+// A panel switch starts (ui_panels showing hook): times from here
+void panelCacheSwitchStart();
+
+// panel just became the visible one (ui_panels shown hook); id names its
+// capture in flash, so it must be the same panel on every boot
+void panelCacheShown(int id, lv_obj_t* panel);
+
+// panel is about to be deleted: unmaps its snapshot (the capture stays)
+void panelCacheDrop(lv_obj_t* panel);
+
+// obj (a direct child of a cached panel) keeps being drawn live
+void panelCacheMarkDynamic(lv_obj_t* obj);
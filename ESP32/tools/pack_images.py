@@ -0,0 +1,368 @@
+"""VOX EFX - pack SquareLine image exports into 4-bit indexed assets
+
+SquareLine writes every image as raw RGB565A8 (LV_COLOR_FORMAT_NATIVE_WITH_ALPHA
+at 16-bit colour): 3 bytes per pixel, about 1 MB for the four panel images.
+This rewrites each lib/squareline_ui/images/ui_img_*.c in place, keeping its
+symbol, as:
+
+  - 4-bit indices, two pixels per byte (even pixel in the low nibble)
+  - a 16-colour RGB565 palette per band of BAND_ROWS rows, fitted by median
+    cut plus a few k-means passes over the visible colours of that band
+  - alpha run-length coded per row as (count, value) byte pairs, with a row
+    offset table so any row can be decoded on its own
+
+The descriptor is marked LV_COLOR_FORMAT_RAW_ALPHA and decoded a few rows at
+a time by src/packed_image.cpp, which documents the byte layout.
+
+Runs as a PlatformIO pre-build script (extra_scripts in platformio.ini), so a
+fresh SquareLine export is packed on the next build; files already packed are
+left alone. The build also gets UI_HASH, a CRC-32 of the (packed) SquareLine
+export and include/lv_conf.h: src/panel_cache.cpp captures the panels again
+when it changes.
+
+It also checks the hand edits a SquareLine export drops from
+screens/ui_Main.c and ui_Main.h (the re-export step in
+lib/squareline_ui/ui_panels.h) and stops the build, listing each one, when
+any is missing. Also runs standalone:
+
+  python tools/pack_images.py [--dry-run] [--check] [files...]
+"""
+
+import glob
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = b"VXP4"
+BAND_ROWS = 4
+COLORS = 16
+KMEANS_PASSES = 4
+PACKED_MARK = "// Packed by tools/pack_images.py"
+
+
+# ---------------------------------------------------------------- parsing
+def parse_export(text):
+    """Returns (name, w, h, rgb565 list, alpha list, source comment)"""
+    m = re.search(r"uint8_t\s+(\w+)_data\[\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not m:
+        raise ValueError("no image data array")
+    name = m.group(1)
+    data = bytes(int(x, 16) for x in re.findall(r"0x([0-9A-Fa-f]{2})", m.group(2)))
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    if "LV_COLOR_FORMAT_NATIVE_WITH_ALPHA" not in text or len(data) != w * h * 3:
+        raise ValueError("expected RGB565A8 (%dx%d, %d bytes)" % (w, h, len(data)))
+    n = w * h
+    rgb = [data[2 * i] | (data[2 * i + 1] << 8) for i in range(n)]
+    alpha = list(data[2 * n:])
+    src = re.search(r"// IMAGE DATA: (.*)", text)
+    return name, w, h, rgb, alpha, src.group(1) if src else name
+
+
+def to_rgb8(c):
+    r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+    return ((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2))
+
+
+def to_565(rgb):
+    r, g, b = (max(0, min(255, int(round(v)))) for v in rgb)
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+# ---------------------------------------------------------------- palette fit
+def median_cut(pixels, count):
+    # pixels: (r, g, b, weight)
+    boxes = [pixels]
+    while len(boxes) < count:
+        # Split the box with the widest channel range
+        best, axis, spread = None, 0, -1
+        for i, box in enumerate(boxes):
+            if len(box) < 2:
+                continue
+            for a in range(3):
+                lo = min(p[a] for p in box)
+                hi = max(p[a] for p in box)
+                if hi - lo > spread:
+                    best, axis, spread = i, a, hi - lo
+        if best is None or spread <= 0:
+            break
+        box = sorted(boxes.pop(best), key=lambda p: p[axis])
+        half, acc, mid = sum(p[3] for p in box) / 2.0, 0.0, 1
+        for mid, p in enumerate(box[:-1], 1):
+            acc += p[3]
+            if acc >= half:
+                break
+        boxes += [box[:mid], box[mid:]]
+    return [mean(box) for box in boxes]
+
+
+def mean(box):
+    total = sum(p[3] for p in box)
+    return tuple(sum(p[a] * p[3] for p in box) / total for a in range(3))
+
+
+def nearest(p, palette):
+    best, bd = 0, 1 << 30
+    for i, q in enumerate(palette):
+        d = (p[0] - q[0]) ** 2 + (p[1] - q[1]) ** 2 + (p[2] - q[2]) ** 2
+        if d < bd:
+            best, bd = i, d
+    return best
+
+
+def fit_palette(counts):
+    """counts: {rgb8: pixels}. Each colour weighs sqrt(pixels), so small
+    bright details (LEDs, glow) keep entries against large flat areas"""
+    if not counts:
+        return [(0, 0, 0)]
+    pixels = [c + (n ** 0.5,) for c, n in counts.items()]
+    palette = median_cut(pixels, COLORS)
+    for _ in range(KMEANS_PASSES):
+        groups = [[] for _ in palette]
+        for p in pixels:
+            groups[nearest(p, palette)].append(p)
+        palette = [mean(g) if g else palette[i] for i, g in enumerate(groups)]
+    return palette
+
+
+# ---------------------------------------------------------------- encoding
+def pack(w, h, rgb, alpha):
+    """Returns (blob, decoded rgb565 for the visible pixels)"""
+    stride = (w + 1) // 2
+    bands = (h + BAND_ROWS - 1) // BAND_ROWS
+    palettes = []
+    indices = bytearray(stride * h)
+    decoded = list(rgb)
+
+    for band in range(bands):
+        y0, y1 = band * BAND_ROWS, min(h, (band + 1) * BAND_ROWS)
+        counts = {}
+        for i in range(y0 * w, y1 * w):
+            if alpha[i]:
+                c = to_rgb8(rgb[i])
+                counts[c] = counts.get(c, 0) + 1
+        pal565 = [to_565(c) for c in fit_palette(counts)]
+        pal565 += [0] * (COLORS - len(pal565))
+        pal8 = [to_rgb8(c) for c in pal565]
+        palettes.append(pal565)
+
+        lookup = {}
+        for y in range(y0, y1):
+            for x in range(w):
+                i = y * w + x
+                k = 0
+                if alpha[i]:
+                    c = rgb[i]
+                    if c not in lookup:
+                        lookup[c] = nearest(to_rgb8(c), pal8)
+                    k = lookup[c]
+                    decoded[i] = pal565[k]
+                indices[y * stride + x // 2] |= k << (4 * (x & 1))
+
+    rows = []
+    offsets = []
+    pos = 0
+    for y in range(h):
+        row = bytearray()
+        x = 0
+        while x < w:
+            v = alpha[y * w + x]
+            n = 1
+            while x + n < w and n < 255 and alpha[y * w + x + n] == v:
+                n += 1
+            row += bytes((n, v))
+            x += n
+        offsets.append(pos)
+        rows.append(row)
+        pos += len(row)
+
+    blob = bytearray(MAGIC)
+    blob += struct.pack("<HHBBH", w, h, BAND_ROWS, 0, bands)
+    for pal in palettes:
+        blob += struct.pack("<%dH" % COLORS, *pal)
+    blob += indices
+    blob += struct.pack("<%dI" % h, *offsets)
+    for row in rows:
+        blob += row
+    return bytes(blob), decoded
+
+
+def unpack(blob):
+    """Reference decoder, mirrors src/packed_image.cpp"""
+    assert blob[:4] == MAGIC
+    w, h, band_rows, _, bands = struct.unpack_from("<HHBBH", blob, 4)
+    pal_off = 12
+    idx_off = pal_off + bands * COLORS * 2
+    stride = (w + 1) // 2
+    tab_off = idx_off + stride * h
+    run_off = tab_off + 4 * h
+    rgb, alpha = [], []
+    for y in range(h):
+        pal = struct.unpack_from("<%dH" % COLORS, blob, pal_off + (y // band_rows) * COLORS * 2)
+        for x in range(w):
+            rgb.append(pal[(blob[idx_off + y * stride + x // 2] >> (4 * (x & 1))) & 0xF])
+        p = run_off + struct.unpack_from("<I", blob, tab_off + 4 * y)[0]
+        n = 0
+        while n < w:
+            alpha += [blob[p + 1]] * blob[p]
+            n += blob[p]
+            p += 2
+    return w, h, rgb, alpha
+
+
+def psnr(rgb, decoded, alpha):
+    err, n = 0, 0
+    for a, b, v in zip(rgb, decoded, alpha):
+        if v:
+            pa, pb = to_rgb8(a), to_rgb8(b)
+            err += sum((pa[i] - pb[i]) ** 2 for i in range(3))
+            n += 3
+    if err == 0:
+        return float("inf")
+    import math
+    return 10 * math.log10(255 * 255 * n / err)
+
+
+# ---------------------------------------------------------------- output
+def emit(path, name, w, h, blob, source, raw_size):
+    lines = [
+        "// This file was generated by SquareLine Studio",
+        PACKED_MARK + ": 4-bit indexed, %d-row palettes, RLE alpha" % BAND_ROWS,
+        "// (%d bytes, %d raw), decoded by src/packed_image.cpp" % (len(blob), raw_size),
+        "",
+        '#include "../ui.h"',
+        "",
+        "#ifndef LV_ATTRIBUTE_MEM_ALIGN",
+        "    #define LV_ATTRIBUTE_MEM_ALIGN",
+        "#endif",
+        "",
+        "// IMAGE DATA: %s" % source,
+        "const LV_ATTRIBUTE_MEM_ALIGN uint8_t %s_data[]  = {" % name,
+    ]
+    for i in range(0, len(blob), 32):
+        lines.append("    " + ",".join("0x%02X" % b for b in blob[i:i + 32]) + ",")
+    lines += [
+        "};",
+        "const lv_image_dsc_t %s = {" % name,
+        "    .header.w = %d," % w,
+        "    .header.h = %d," % h,
+        "    .data_size = sizeof(%s_data)," % name,
+        "    .header.cf = LV_COLOR_FORMAT_RAW_ALPHA,",
+        "    .header.magic = LV_IMAGE_HEADER_MAGIC,",
+        "    .data = %s_data" % name,
+        "};",
+        "",
+    ]
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+def pack_file(path, dry_run=False, log=print):
+    with open(path) as f:
+        text = f.read()
+    if PACKED_MARK in text:
+        return None
+    name, w, h, rgb, alpha, source = parse_export(text)
+    blob, decoded = pack(w, h, rgb, alpha)
+
+    # Round trip before anything is written
+    w2, h2, rgb2, alpha2 = unpack(blob)
+    if (w2, h2, alpha2) != (w, h, alpha) or any(
+            a and rgb2[i] != decoded[i] for i, a in enumerate(alpha)):
+        raise RuntimeError("%s: round trip mismatch" % path)
+
+    raw = w * h * 3
+    log("pack_images: %s %dx%d %d -> %d bytes (%.1fx), %.1f dB" % (
+        os.path.basename(path), w, h, raw, len(blob), raw / float(len(blob)),
+        psnr(rgb, decoded, alpha)))
+    if not dry_run:
+        emit(path, name, w, h, blob, source, raw)
+    return raw, len(blob)
+
+
+def default_files(root):
+    return sorted(glob.glob(os.path.join(root, "lib", "squareline_ui", "images", "ui_img_*.c")))
+
+
+def ui_hash(root):
+    """CRC-32 over what a panel's pixels depend on"""
+    files = sorted(glob.glob(os.path.join(root, "lib", "squareline_ui", "**", "*.[ch]"), recursive=True))
+    files.append(os.path.join(root, "include", "lv_conf.h"))
+    crc = 0
+    for path in files:
+        crc = zlib.crc32(os.path.relpath(path, root).replace(os.sep, "/").encode(), crc)
+        with open(path, "rb") as f:
+            crc = zlib.crc32(f.read(), crc)
+    return crc & 0xFFFFFFFF
+
+
+def check_panel_hooks(root):
+    """Missing ui_panels edits in the SquareLine export, as messages"""
+    ui = os.path.join(root, "lib", "squareline_ui")
+
+    def read(*path):
+        with open(os.path.join(ui, *path)) as f:
+            return f.read()
+
+    main_c, main_h, panels_c = read("screens", "ui_Main.c"), read("screens", "ui_Main.h"), read("ui_panels.c")
+    problems = []
+    if '#include "../ui_panels.h"' not in main_c:
+        problems.append('ui_Main.c: no #include "../ui_panels.h"')
+    for call in ("ui_panels_init(ui_ContentContainer);", "ui_panels_deinit();"):
+        if call not in main_c:
+            problems.append("ui_Main.c: no call to %s" % call)
+    for name in sorted(set(re.findall(r"\b(ui_pnl\w+)_create\b", panels_c))):
+        proto = r"lv_obj_t \* %s_create\(lv_obj_t \* parent\)" % name
+        if not re.search(r"^" + proto + r"\s*\{", main_c, re.M):
+            problems.append("ui_Main.c: no %s_create() builder" % name)
+        if not re.search(r"^" + proto + r";", main_h, re.M):
+            problems.append("ui_Main.h: no %s_create() prototype" % name)
+        if re.search(r"^\s*%s = lv_obj_create\(" % name, main_c, re.M):
+            problems.append("ui_Main.c: ui_Main_screen_init() still builds %s" % name)
+    return problems
+
+
+def report_panel_hooks(root, log=print):
+    problems = check_panel_hooks(root)
+    for p in problems:
+        log("pack_images: ERROR %s" % p)
+    if problems:
+        log("pack_images: a SquareLine export dropped the ui_panels edits; "
+            "redo the re-export step in lib/squareline_ui/ui_panels.h")
+    return not problems
+
+
+def main(argv):
+    dry_run = "--dry-run" in argv
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    if "--check" in argv:
+        return 0 if report_panel_hooks(root) else 1
+    files = [a for a in argv if not a.startswith("--")]
+    if not files:
+        files = default_files(root)
+    total_raw = total_packed = 0
+    for path in files:
+        r = pack_file(path, dry_run)
+        if r:
+            total_raw += r[0]
+            total_packed += r[1]
+    if total_packed:
+        print("pack_images: total %d -> %d bytes (%.1fx)" % (
+            total_raw, total_packed, total_raw / float(total_packed)))
+    return 0 if report_panel_hooks(root) else 1
+
+
+try:
+    Import("env")  # noqa: F821 - PlatformIO extra_script
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main(sys.argv[1:]))
+else:
+    _root = env.subst("$PROJECT_DIR")  # noqa: F821
+    if not report_panel_hooks(_root):
+        env.Exit(1)  # noqa: F821
+    for _path in default_files(_root):
+        pack_file(_path)
+    env.Append(CPPDEFINES=[("UI_HASH", "0x%08X" % ui_hash(_root))])  # noqa: F821
@@ -0,0 +1,94 @@
+// VOX EFX - boot timeline, shared by both firmwares
+// - setup() calls begin() once, then mark("phase") as each init step ends;
+//   a mark stores the step's name and the clock in microseconds into a
+//   fixed array (no allocation, safe before Serial is up)
+// - format() writes the whole timeline as one text record:
+//     BOOT,<fw>,T0=<us>,<phase>=<us>,...,TOTAL=<us>[,DROP=<n>]\n
+//   T0 is the clock at begin(), i.e. time spent before setup() (runtime
+//   startup, USB delay); each phase is its own duration; TOTAL is the last
+//   mark minus begin()
+// - Names must be string literals (only the pointer is kept)
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace vox {
+namespace link {
+
+template <int N>
+class BootTrace {
+public:
+  struct Mark {
+    const char* name;
+    uint32_t us;
+  };
+
+  BootTrace() : t0(0), count(0), dropped(0) {}
+
+  void begin(uint32_t nowUs) {
+    t0 = nowUs;
+    count = 0;
+    dropped = 0;
+  }
+
+  // Full trace: the mark is counted in DROP, earlier ones stay exact
+  void mark(const char* name, uint32_t nowUs) {
+    if (count == N) {
+      dropped++;
+      return;
+    }
+    marks[count].name = name;
+    marks[count].us = nowUs;
+    count++;
+  }
+
+  int size() const { return count; }
+  const Mark& at(int i) const { return marks[i]; }
+  uint32_t start() const { return t0; }
+
+  // Duration of phase i (from the previous mark, or from begin())
+  uint32_t phase(int i) const { return marks[i].us - (i ? marks[i - 1].us : t0); }
+  uint32_t total() const { return count ? marks[count - 1].us - t0 : 0; }
+
+  // Returns the record length; a record that doesn't fit in cap is cut at
+  // the last whole field and still ends in '\n'
+  size_t format(char* out, size_t cap, const char* fw) const {
+    if (cap < 2) return 0;
+    size_t n = 0;
+    bool ok = append(out, cap, n, "BOOT,%s,T0=%lu", fw, (unsigned long)t0);
+    for (int i = 0; ok && i < count; i++) {
+      ok = append(out, cap, n, ",%s=%lu", marks[i].name, (unsigned long)phase(i));
+    }
+    if (ok) ok = append(out, cap, n, ",TOTAL=%lu", (unsigned long)total());
+    if (ok && dropped) append(out, cap, n, ",DROP=%lu", (unsigned long)dropped);
+    out[n++] = '\n';
+    out[n] = '\0';
+    return n;
+  }
+
+private:
+  // Leaves room for the trailing "\n\0"; false (and nothing added) when
+  // the field doesn't fit
+  template <class... Args>
+  static bool append(char* out, size_t cap, size_t& n, const char* fmt, Args... args) {
+    const size_t room = cap - 2 - n;
+    const int w = snprintf(out + n, room + 1, fmt, args...);
+    if (w < 0 || (size_t)w > room) {
+      out[n] = '\0';
+      return false;
+    }
+    n += (size_t)w;
+    return true;
+  }
+
+  uint32_t t0;
+  int count;
+  uint32_t dropped;
+  Mark marks[N];
+};
+
+} // namespace link
+} // namespace vox
@@ -0,0 +1,230 @@
+// VOX EFX - binary frame codec (see vox_link.h)
+
+#include "vox_link.h"
+
+#include <string.h>
+
+namespace vox {
+namespace link {
+
+static inline void put16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static inline uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void put32(uint8_t* p, uint32_t v) {
+  put16(p, (uint16_t)v);
+  put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint32_t get32(const uint8_t* p) {
+  return (uint32_t)get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+uint16_t crc16(const uint8_t* p, size_t n, uint16_t crc) {
+  while (n--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+size_t encodeFrame(uint8_t type, const uint8_t* payload, size_t len, uint8_t* out, size_t room) {
+  if (len > MAX_PAYLOAD || room < len + OVERHEAD) return 0;
+  out[0] = SYNC;
+  out[1] = type;
+  out[2] = (uint8_t)len;
+  if (len) memcpy(out + 3, payload, len);
+  put16(out + 3 + len, crc16(out + 1, len + 2));
+  return len + OVERHEAD;
+}
+
+// ===================== Decoder =====================
+bool Decoder::push(uint8_t b) {
+  switch (state) {
+    case WAIT_SYNC:
+      if (b == SYNC) state = TYPE;
+      else skipped++;
+      return false;
+
+    case TYPE:
+      frameType = b;
+      crc = crc16(&b, 1);
+      state = LEN;
+      return false;
+
+    case LEN:
+      if (b > MAX_PAYLOAD) {
+        lengthErrors++;
+        state = WAIT_SYNC;
+        return false;
+      }
+      len = b;
+      pos = 0;
+      crc = crc16(&b, 1, crc);
+      state = len ? PAYLOAD : CRC_LO;
+      return false;
+
+    case PAYLOAD:
+      buf[pos++] = b;
+      if (pos == len) {
+        crc = crc16(buf, len, crc);
+        state = CRC_LO;
+      }
+      return false;
+
+    case CRC_LO:
+      crcLo = b;
+      state = CRC_HI;
+      return false;
+
+    case CRC_HI:
+      state = WAIT_SYNC;
+      if ((uint16_t)(crcLo | (b << 8)) != crc) {
+        crcErrors++;
+        return false;
+      }
+      frames++;
+      return true;
+  }
+  state = WAIT_SYNC;
+  return false;
+}
+
+// ===================== Messages =====================
+void Meter::pack(uint8_t* p) const {
+  p[0] = in;
+  p[1] = out;
+}
+
+bool Meter::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  in = p[0];
+  out = p[1];
+  return true;
+}
+
+void Level::pack(uint8_t* p) const { p[0] = pct; }
+
+bool Level::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  pct = p[0];
+  return true;
+}
+
+void ReverbState::pack(uint8_t* p) const { p[0] = on ? 1 : 0; }
+
+bool ReverbState::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  on = p[0] != 0;
+  return true;
+}
+
+void DelayState::pack(uint8_t* p) const {
+  p[0] = on ? 1 : 0;
+  put16(p + 1, ms);
+}
+
+bool DelayState::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  on = p[0] != 0;
+  ms = get16(p + 1);
+  return true;
+}
+
+void Debug::pack(uint8_t* p) const {
+  put16(p + 0, dry);
+  put16(p + 2, wet);
+  put16(p + 4, room);
+  put16(p + 6, pkIn);
+  put16(p + 8, pkWet);
+  put16(p + 10, pkMix);
+  put16(p + 12, pkOut);
+  put16(p + 14, (uint16_t)grDb10);
+}
+
+bool Debug::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  dry = get16(p + 0);
+  wet = get16(p + 2);
+  room = get16(p + 4);
+  pkIn = get16(p + 6);
+  pkWet = get16(p + 8);
+  pkMix = get16(p + 10);
+  pkOut = get16(p + 12);
+  grDb10 = (int16_t)get16(p + 14);
+  return true;
+}
+
+void Cpu::pack(uint8_t* p) const {
+  p[0] = allPct;
+  p[1] = count;
+  p += 2;
+  for (int i = 0; i < count; i++) {
+    const Node& s = node[i];
+    memcpy(p, s.name, 3);
+    put16(p + 3, s.min);
+    put16(p + 5, s.avg);
+    put16(p + 7, s.max);
+    memcpy(p + 9, s.hist, BINS);
+    p += NODE_SIZE;
+  }
+}
+
+bool Cpu::unpack(const uint8_t* p, size_t n) {
+  if (n < 2 || p[1] > MAX_NODES || n != 2 + p[1] * NODE_SIZE) return false;
+  allPct = p[0];
+  count = p[1];
+  p += 2;
+  for (int i = 0; i < count; i++) {
+    Node& s = node[i];
+    memcpy(s.name, p, 3);
+    s.min = get16(p + 3);
+    s.avg = get16(p + 5);
+    s.max = get16(p + 7);
+    memcpy(s.hist, p + 9, BINS);
+    p += NODE_SIZE;
+  }
+  return true;
+}
+
+uint16_t Cpu::share(uint32_t cycles, uint32_t budget) {
+  if (budget == 0) return 0;
+  uint64_t v = (uint64_t)cycles * 10000u / budget;
+  return v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
+
+void Pool::pack(uint8_t* p) const {
+  put16(p + 0, capacity);
+  put16(p + 2, used);
+  put16(p + 4, usedMax);
+  put32(p + 6, failures);
+}
+
+bool Pool::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  capacity = get16(p + 0);
+  used = get16(p + 2);
+  usedMax = get16(p + 4);
+  failures = get32(p + 6);
+  return true;
+}
+
+void SetEq::pack(uint8_t* p) const {
+  p[0] = band;
+  put16(p + 1, (uint16_t)gainDb10);
+}
+
+bool SetEq::unpack(const uint8_t* p, size_t n) {
+  if (n != SIZE) return false;
+  band = p[0];
+  gainDb10 = (int16_t)get16(p + 1);
+  return true;
+}
+
+} // namespace link
+} // namespace vox
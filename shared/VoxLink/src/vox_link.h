@@ -0,0 +1,187 @@
+// VOX EFX - binary frame codec for the Teensy <-> ESP32 UART link
+// Shared by both firmwares (lib_extra_dirs = ../shared) and the host tests.
+//
+//   | SYNC 0xA5 | type | len | payload[len] | crc16 lo | crc16 hi |
+//
+// - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over type, len and payload
+// - Payload fields are little-endian, packed by hand (no struct memcpy), so
+//   both compilers agree on the layout
+// - Levels travel as fixed point (no float formatting on the Teensy):
+//   gains/peaks in 1/1000, dB in 1/10, CPU in 1/100 % of the block budget
+// - Decoder is a byte-at-a-time state machine: no allocation, resyncs on
+//   the next SYNC after garbage or a bad CRC, and counts what it dropped
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace vox {
+namespace link {
+
+static const uint8_t SYNC        = 0xA5;
+static const size_t  OVERHEAD    = 5;              // sync, type, len, crc16
+static const size_t  MAX_PAYLOAD = 192;
+static const size_t  MAX_FRAME   = MAX_PAYLOAD + OVERHEAD;
+
+enum MsgType : uint8_t {
+  // Teensy -> ESP32
+  MSG_METER   = 0x01,
+  MSG_LEVEL   = 0x02,
+  MSG_REVERB  = 0x03,
+  MSG_DELAY   = 0x04,
+  MSG_DEBUG   = 0x05,
+  MSG_CPU     = 0x06,
+  MSG_POOL    = 0x07,
+  // ESP32 -> Teensy
+  MSG_SET_LEVEL = 0x40,
+  MSG_SET_EQ    = 0x41,
+};
+
+uint16_t crc16(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF);
+
+// Whole frame into out; returns its size, 0 if it doesn't fit
+size_t encodeFrame(uint8_t type, const uint8_t* payload, size_t len, uint8_t* out, size_t room);
+
+class Decoder {
+public:
+  // Feed one received byte; true when a complete, CRC-checked frame is ready
+  // (valid until the next push())
+  bool push(uint8_t b);
+
+  uint8_t        type() const    { return frameType; }
+  const uint8_t* payload() const { return buf; }
+  size_t         length() const  { return len; }
+
+  uint32_t frames = 0;
+  uint32_t crcErrors = 0;
+  uint32_t lengthErrors = 0;
+  uint32_t skipped = 0;            // bytes discarded while hunting for SYNC
+
+private:
+  enum State : uint8_t { WAIT_SYNC, TYPE, LEN, PAYLOAD, CRC_LO, CRC_HI };
+  State    state = WAIT_SYNC;
+  uint8_t  frameType = 0;
+  uint8_t  len = 0;
+  uint8_t  pos = 0;
+  uint16_t crc = 0;
+  uint8_t  crcLo = 0;
+  uint8_t  buf[MAX_PAYLOAD];
+};
+
+// ===================== Messages =====================
+// Each has TYPE, SIZE (payload bytes), pack() and unpack()
+
+struct Meter {                     // level meter segments lit, 0 .. SEGMENTS
+  static const uint8_t TYPE = MSG_METER;
+  static const size_t  SIZE = 2;
+  static const uint8_t SEGMENTS = 29;   // the ESP32 meter sliders' range
+  uint8_t in, out;
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct Level {                     // output level, and SET_LEVEL from the ESP32
+  static const uint8_t TYPE = MSG_LEVEL;
+  static const size_t  SIZE = 1;
+  uint8_t pct;
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct SetLevel : Level {
+  static const uint8_t TYPE = MSG_SET_LEVEL;
+};
+
+struct ReverbState {
+  static const uint8_t TYPE = MSG_REVERB;
+  static const size_t  SIZE = 1;
+  bool on;
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct DelayState {
+  static const uint8_t TYPE = MSG_DELAY;
+  static const size_t  SIZE = 3;
+  bool     on;
+  uint16_t ms;
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct Debug {
+  static const uint8_t TYPE = MSG_DEBUG;
+  static const size_t  SIZE = 16;
+  uint16_t dry, wet, room;         // 1/1000
+  uint16_t pkIn, pkWet, pkMix, pkOut;   // 1/1000 of full scale
+  int16_t  grDb10;                 // dynamics gain reduction, 1/10 dB (<= 0)
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct Cpu {                       // per-node cost, one frame for all nodes
+  static const uint8_t TYPE = MSG_CPU;
+  static const int     MAX_NODES = 10;
+  static const int     BINS = 8;
+  static const size_t  NODE_SIZE = 3 + 6 + BINS;
+  static const size_t  SIZE = 2 + MAX_NODES * NODE_SIZE;   // maximum
+
+  struct Node {
+    char     name[3];              // not NUL-terminated, space padded
+    uint16_t min, avg, max;        // 1/100 % of the block budget
+    uint8_t  hist[BINS];           // saturating counts
+  };
+  uint8_t allPct;                  // AudioProcessorUsageMax()
+  uint8_t count;
+  Node    node[MAX_NODES];
+
+  size_t size() const { return 2 + count * NODE_SIZE; }
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+
+  // cycles -> 1/100 % of budget, saturating
+  static uint16_t share(uint32_t cycles, uint32_t budget);
+};
+static_assert(Cpu::SIZE <= MAX_PAYLOAD, "Cpu frame must fit MAX_PAYLOAD");
+
+struct Pool {                      // AudioMemory blocks
+  static const uint8_t TYPE = MSG_POOL;
+  static const size_t  SIZE = 10;
+  uint16_t capacity;               // AudioMemory(n)
+  uint16_t used, usedMax;          // now, and high-water since boot
+  uint32_t failures;               // allocate() returned no block, since boot
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+struct SetEq {
+  static const uint8_t TYPE = MSG_SET_EQ;
+  static const size_t  SIZE = 3;
+  uint8_t band;
+  int16_t gainDb10;                // 1/10 dB
+  void pack(uint8_t* p) const;
+  bool unpack(const uint8_t* p, size_t n);
+};
+
+template <class M> inline size_t payloadSize(const M&) { return M::SIZE; }
+inline size_t payloadSize(const Cpu& m) { return m.size(); }
+
+// Message -> frame; returns the frame size, 0 if it doesn't fit
+template <class M>
+size_t encode(const M& m, uint8_t* out, size_t room) {
+  uint8_t payload[MAX_PAYLOAD];
+  const size_t n = payloadSize(m);
+  if (n > MAX_PAYLOAD) return 0;
+  m.pack(payload);
+  return encodeFrame(M::TYPE, payload, n, out, room);
+}
+
+// Decoded frame -> message; false on a type or length mismatch
+template <class M>
+bool decode(const Decoder& d, M& m) {
+  return d.type() == M::TYPE && m.unpack(d.payload(), d.length());
+}
+
+} // namespace link
+} // namespace vox
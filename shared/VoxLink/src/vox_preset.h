@@ -0,0 +1,117 @@
+// VOX EFX - effect presets: one complete chain state per slot
+// - Preset is a packed POD: recall copies it whole, storage writes its bytes
+//   as they are (only the Teensy reads them back, so unlike link payloads
+//   the layout may follow the compiler)
+// - Each slot is sealed in a PresetRecord: magic, PRESET_VERSION and a
+//   CRC-16 (vox_link.h crc16) over everything before the CRC. A record
+//   that fails any of them is not a preset: get() returns nullptr
+// - Bump PRESET_VERSION whenever Preset's fields change; older records are
+//   then rejected instead of read with the wrong layout
+// - EQ types and frequencies are the EQ panel's fixed layout
+//   (vox_config.h EQ_BANDS); a preset holds the band gains, as SET_EQ does
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vox_link.h"
+
+namespace vox {
+namespace link {
+
+static const uint16_t PRESET_MAGIC   = 0x5056;     // "VP"
+static const uint8_t  PRESET_VERSION = 1;
+static const int      PRESET_EQ_BANDS = 6;
+static const int      PRESET_NAME    = 12;        // bytes, NUL-padded
+
+struct __attribute__((packed)) Preset {
+  char    name[PRESET_NAME];
+
+  uint8_t reverbOn;
+  uint8_t delayOn;
+  uint8_t dynamicsOn;
+  uint8_t level;                   // output level, 0..100 %
+
+  float   roomsize, damping;       // 0.0 .. 1.0
+  float   wet, dry;                // mixer gains (wet while reverbOn)
+
+  float   delayMs, delayFeedback, delayToneHz;
+  float   delayModHz, delayModMs;
+  float   delayLevel;              // mixer gain while delayOn
+
+  float   gateDb, gateRangeDb;
+  float   compDb, compRatio, compAttackMs, compReleaseMs, makeupDb;
+  float   ceilingDb, limitReleaseMs, lookaheadMs;
+
+  int16_t eqDb10[PRESET_EQ_BANDS]; // band gains, 1/10 dB
+
+  void setName(const char* s) {
+    memset(name, 0, sizeof(name));
+    for (size_t i = 0; i + 1 < sizeof(name) && s[i]; i++) name[i] = s[i];
+  }
+};
+
+struct __attribute__((packed)) PresetRecord {
+  uint16_t magic;
+  uint8_t  version;
+  uint8_t  size;                   // sizeof(Preset), a second layout check
+  Preset   body;
+  uint16_t crc;
+
+  static const size_t SEALED = sizeof(magic) + sizeof(version) + sizeof(size) + sizeof(Preset);
+
+  void seal(const Preset& p) {
+    magic = PRESET_MAGIC;
+    version = PRESET_VERSION;
+    size = (uint8_t)sizeof(Preset);
+    body = p;
+    crc = crc16((const uint8_t*)this, SEALED);
+  }
+
+  bool valid() const {
+    return magic == PRESET_MAGIC && version == PRESET_VERSION && size == sizeof(Preset) &&
+           crc == crc16((const uint8_t*)this, SEALED);
+  }
+};
+static_assert(sizeof(Preset) < 256, "PresetRecord::size is one byte");
+static_assert(sizeof(PresetRecord) == PresetRecord::SEALED + 2, "PresetRecord must be packed");
+
+template <int N>
+class PresetBank {
+public:
+  static const int SLOTS = N;
+
+  PresetBank() { memset(records, 0, sizeof(records)); }
+
+  void store(int slot, const Preset& p) {
+    if (slot >= 0 && slot < N) records[slot].seal(p);
+  }
+
+  // nullptr for an empty, corrupt or older-version slot
+  const Preset* get(int slot) const {
+    if (slot < 0 || slot >= N || !records[slot].valid()) return nullptr;
+    return &records[slot].body;
+  }
+
+  // Raw record bytes, for storage
+  const PresetRecord& record(int slot) const { return records[slot]; }
+
+  // Record bytes back from storage; false (slot unchanged) when they don't
+  // check out
+  bool load(int slot, const uint8_t* bytes, size_t n) {
+    if (slot < 0 || slot >= N || n != sizeof(PresetRecord)) return false;
+    PresetRecord r;
+    memcpy(&r, bytes, n);
+    if (!r.valid()) return false;
+    records[slot] = r;
+    return true;
+  }
+
+private:
+  PresetRecord records[N];
+};
+
+} // namespace link
+} // namespace vox
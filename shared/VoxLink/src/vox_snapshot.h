@@ -0,0 +1,54 @@
+// VOX EFX - lock-free "latest value" hand-over between two threads
+// - One writer publishes whole copies of T; one reader picks up the newest
+//   one when it's ready for it (ESP32: link RX task -> LVGL once per frame)
+// - Triple buffer: the writer owns slot[back], the reader slot[front];
+//   ready holds the newest published slot plus FRESH while it's unread
+// - Neither side ever waits or retries. A reader that falls behind skips
+//   straight to the newest copy; one that's ahead keeps its current copy
+// - T is copied with plain assignment, so keep it small and POD-like
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace vox {
+namespace link {
+
+template <class T>
+class Snapshot {
+public:
+  Snapshot() : ready(2) {}
+
+  // Writer: copy v in and hand it over, taking back whatever slot was
+  // waiting (read or not)
+  void publish(const T& v) {
+    slot[back] = v;
+    back = ready.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+    published++;
+  }
+
+  // Reader: switch to the newest copy; false when nothing new since last time
+  bool acquire() {
+    if (!(ready.load(std::memory_order_acquire) & FRESH)) return false;
+    front = ready.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+    return true;
+  }
+
+  // Reader: the copy taken by the last acquire(), T() before the first one
+  const T& current() const { return slot[front]; }
+
+  uint32_t published = 0;        // writer-side counter
+
+private:
+  static const uint8_t FRESH = 0x80;
+
+  T slot[3] = {};
+  uint8_t front = 0;                     // reader only
+  uint8_t back = 1;                      // writer only
+  std::atomic<uint8_t> ready;
+};
+
+} // namespace link
+} // namespace vox
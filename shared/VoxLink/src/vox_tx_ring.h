@@ -0,0 +1,117 @@
+// VOX EFX - lock-free single-producer / single-consumer transmit ring
+// - The producer (loop()) pushes whole records: a frame, or a text line;
+//   writes longer than RECORD_MAX are split into several records
+// - The consumer (a timer ISR feeding the UART) pops one record at a time
+//   into its own buffer, so the bytes it's sending can't be overwritten
+// - Full ring: the producer drops the oldest records, never the new one, and
+//   counts them. Drops and pops both advance tail with a compare-exchange;
+//   pop copies first and only commits if tail didn't move meanwhile
+// - Neither side ever waits for the other. pop() only retries when a drop
+//   raced it, which can't happen on one core (loop() never runs inside the
+//   ISR); push() retries at most once per record the ISR pops meanwhile
+// - Indices are free-running 32-bit counters, N must be a power of two
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace vox {
+namespace link {
+
+template <uint32_t N>
+class TxRing {
+public:
+  static const uint32_t RECORD_MAX = 256;         // payload bytes per record
+  static const uint32_t HEADER = 2;               // record length, little-endian
+
+  static_assert((N & (N - 1)) == 0, "TxRing size must be a power of two");
+  static_assert(N >= 2 * (RECORD_MAX + HEADER), "TxRing must hold two full records");
+
+  TxRing() : head(0), tail(0) {}
+
+  // Producer: queue p[0..n) as one or more records, dropping the oldest
+  // records while there isn't room
+  void push(const uint8_t* p, size_t n) {
+    while (n > 0) {
+      const uint32_t len = n > RECORD_MAX ? RECORD_MAX : (uint32_t)n;
+      pushRecord(p, len);
+      p += len;
+      n -= len;
+    }
+  }
+
+  // Consumer: copy the oldest record into out (RECORD_MAX bytes) and remove
+  // it; returns its length, 0 when the ring is empty
+  size_t pop(uint8_t* out) {
+    for (;;) {
+      uint32_t t = tail.load(std::memory_order_acquire);
+      const uint32_t h = head.load(std::memory_order_acquire);
+      if (t == h) return 0;
+
+      const uint32_t len = lengthAt(t);
+      if (len == 0 || len > RECORD_MAX) continue;   // torn by a concurrent drop; tail has moved
+      copyOut(t + HEADER, out, len);
+      if (tail.compare_exchange_strong(t, t + HEADER + len, std::memory_order_acq_rel)) return len;
+    }
+  }
+
+  uint32_t used() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  // Producer-side counters
+  uint32_t records = 0;          // pushed
+  uint32_t dropped = 0;          // records discarded to make room
+  uint32_t droppedBytes = 0;
+  uint32_t highWater = 0;        // most bytes queued at once
+
+private:
+  static const uint32_t MASK = N - 1;
+
+  void pushRecord(const uint8_t* p, uint32_t len) {
+    const uint32_t need = HEADER + len;
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    for (;;) {
+      uint32_t t = tail.load(std::memory_order_acquire);
+      if (N - (h - t) >= need) break;
+      const uint32_t old = lengthAt(t);
+      if (tail.compare_exchange_strong(t, t + HEADER + old, std::memory_order_acq_rel)) {
+        dropped++;
+        droppedBytes += old;
+      }
+      // else the consumer just popped it: room was made either way
+    }
+
+    put(h, (uint8_t)len);
+    put(h + 1, (uint8_t)(len >> 8));
+    for (uint32_t i = 0; i < len; i++) put(h + HEADER + i, p[i]);
+    head.store(h + need, std::memory_order_release);
+
+    records++;
+    const uint32_t u = h + need - tail.load(std::memory_order_relaxed);
+    if (u > highWater) highWater = u;
+  }
+
+  uint32_t lengthAt(uint32_t i) const {
+    return (uint32_t)get(i) | ((uint32_t)get(i + 1) << 8);
+  }
+
+  void copyOut(uint32_t from, uint8_t* out, uint32_t len) const {
+    for (uint32_t i = 0; i < len; i++) out[i] = get(from + i);
+  }
+
+  // Relaxed byte access: plain LDRB/STRB, but a pop() copying a record that
+  // a drop is overwriting stays well-defined (its compare-exchange fails)
+  uint8_t get(uint32_t i) const     { return buf[i & MASK].load(std::memory_order_relaxed); }
+  void    put(uint32_t i, uint8_t b) { buf[i & MASK].store(b, std::memory_order_relaxed); }
+
+  std::atomic<uint8_t> buf[N];
+  std::atomic<uint32_t> head;    // written by the producer only
+  std::atomic<uint32_t> tail;    // pop() and drops, compare-exchange only
+};
+
+} // namespace link
+} // namespace vox
@@ -0,0 +1,118 @@
+// VOX EFX - DSP kernel micro-benchmarks (lib/VoxDsp vox_bench.h)
+// One source, two builds:
+//   host:   pio run -e bench_native && .pio/build/bench_native/program [--label TEXT] [--csv FILE]
+//           ticks are steady_clock ns; --csv appends the rows to FILE (header
+//           when it's new), so runs from several commits line up in one file
+//   Teensy: pio run -e bench -t upload, then watch the serial monitor
+//           ticks are ARM_DWT_CYCCNT cycles at F_CPU_ACTUAL, interrupts off
+//           while a block runs; any received byte runs the suite again
+// Rows print as BENCH,<csv row>. Label with the commit, e.g.
+//   --label $(git rev-parse --short HEAD)   /   -DVOX_BENCH_LABEL=\"abc123\"
+
+#include "vox_bench.h"
+
+#ifndef VOX_BENCH_LABEL
+#define VOX_BENCH_LABEL "teensy40"
+#endif
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+
+struct CycleTimer {
+  uint32_t t0;
+  void start() {
+    __disable_irq();
+    t0 = ARM_DWT_CYCCNT;
+  }
+  uint32_t stop() {
+    const uint32_t t = ARM_DWT_CYCCNT - t0;
+    __enable_irq();
+    return t;
+  }
+};
+
+static vox::bench::Suite suite;     // ~120 KB of reverb and delay memory, in RAM1
+
+static void printRow(const char* line) {
+  Serial.print("BENCH,");
+  Serial.print(line);
+  Serial.print("\n");
+}
+
+static void runSuite() {
+  CycleTimer t;
+  Serial.printf("BENCH_CPU,F_CPU=%lu,BLOCK=%d\n", (unsigned long)F_CPU_ACTUAL, vox::BLOCK_SAMPLES);
+  vox::bench::runAll(suite, t, VOX_BENCH_LABEL, "cyc", printRow);
+  Serial.printf("BENCH_DONE,SINK=%d\n", suite.sink());
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000) {}
+  runSuite();
+}
+
+void loop() {
+  if (!Serial.available()) return;
+  while (Serial.available()) Serial.read();
+  runSuite();
+}
+
+#else
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+
+struct NsTimer {
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point t0;
+  void start() { t0 = Clock::now(); }
+  uint32_t stop() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+  }
+};
+
+static FILE* csv = nullptr;
+
+static void printRow(const char* line) {
+  printf("BENCH,%s\n", line);
+  if (csv && strcmp(line, vox::bench::HEADER) != 0) fprintf(csv, "%s\n", line);
+}
+
+int main(int argc, char** argv) {
+  std::string label = "host", csvPath;
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    if (a == "--label" && i + 1 < argc)    label = argv[++i];
+    else if (a == "--csv" && i + 1 < argc) csvPath = argv[++i];
+    else {
+      fprintf(stderr, "usage: bench [--label TEXT] [--csv FILE]\n");
+      return 2;
+    }
+  }
+
+  if (!csvPath.empty()) {
+    FILE* probe = fopen(csvPath.c_str(), "r");
+    const bool fresh = !probe;
+    if (probe) fclose(probe);
+    csv = fopen(csvPath.c_str(), "a");
+    if (!csv) {
+      fprintf(stderr, "cannot open %s\n", csvPath.c_str());
+      return 1;
+    }
+    if (fresh) fprintf(csv, "%s\n", vox::bench::HEADER);
+  }
+
+  vox::bench::Suite* suite = new vox::bench::Suite();   // keep the tanks off the stack
+  NsTimer t;
+  vox::bench::runAll(*suite, t, label.c_str(), "ns", printRow);
+  printf("BENCH_DONE,SINK=%d\n", suite->sink());
+  delete suite;
+  if (csv) fclose(csv);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,290 @@
+// VOX EFX - host offline renderer
+// - Runs the firmware's audio graph (lib/VoxDsp vox_graph.h) over a WAV file,
+//   one AUDIO_BLOCK_SAMPLES block at a time, as fast as the host allows
+// - --layout picks the channel layout (vox_layout.h), default VOX_LAYOUT:
+//     mono:   left channel in, mono WAV out (matches "Line-In Left only")
+//     dual:   L/R in, two independent reverbs, stereo WAV out
+//     stereo: L/R in, one shared reverb tank, stereo WAV out
+//   A mono input file feeds both sides of a two-channel layout
+// - Prints throughput and time per block against the 2.9 ms block deadline
+// - --golden DIR rewrites the golden-audio corpus outputs (lib/VoxDsp
+//   vox_golden.h): every input through every preset slot. Only after a
+//   change whose new output has been listened to and is meant to stay
+//
+// Build/run: pio run -e native && .pio/build/native/program in.wav out.wav --fx
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "VoxDsp.h"
+#include "vox_config.h"
+#include "vox_golden.h"
+#include "wav.h"
+
+// ===================== Options =====================
+struct Options {
+  std::string inPath;
+  std::string outPath;
+  std::string goldenDir;
+  bool  fx       = false;
+  int   levelPct = 50;
+  float roomsize = REVERB_ROOMSIZE;
+  float damping  = REVERB_DAMPING;
+  float wet      = WET_LEVEL;
+  float tailSec  = 0.0f;
+  int   repeat   = 1;
+  int   layout   = VOX_LAYOUT;
+  bool  delay    = false;
+  float delayMs  = DELAY_TIME_MS;
+  float delayFb  = DELAY_FEEDBACK;
+  bool  dynamics = DYN_ENABLED;
+  bool  eq       = true;
+  vox::EqBand eqBands[vox::Equalizer::BANDS];
+
+  Options() { memcpy(eqBands, EQ_BANDS, sizeof(eqBands)); }
+};
+
+static void usage() {
+  fprintf(stderr,
+          "usage: render IN.wav OUT.wav [--fx] [--level 0..100] [--room 0..1]\n"
+          "              [--damp 0..1] [--wet 0..1] [--tail SEC] [--repeat N]\n"
+          "              [--layout mono|dual|stereo] [--delay] [--delay-ms MS] [--feedback 0..0.98]\n"
+          "              [--dyn on|off] [--eq on|off] [--eq-gain BAND:DB]\n"
+          "       render --golden DIR\n"
+          "  --fx      reverb on (footswitch state), default off\n"
+          "  --delay   delay on (right footswitch hold), default off\n"
+          "  --dyn     input gate/compressor/limiter, default as in vox_config.h\n"
+          "  --eq      6-band EQ (EQ_BANDS in vox_config.h), default on\n"
+          "  --eq-gain set one band's gain, as SET_EQ over UART (repeatable)\n"
+          "  --tail    append SEC of silence so the reverb tail is rendered\n"
+          "  --repeat  render N times for throughput measurement (writes the last)\n"
+          "  --golden  rewrite the golden-audio outputs in DIR (test/golden)\n");
+}
+
+static bool parseArgs(int argc, char** argv, Options& o) {
+  std::vector<std::string> pos;
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    bool hasVal = (i + 1 < argc);
+    if (a == "--fx") o.fx = true;
+    else if (a == "--level" && hasVal)  o.levelPct = atoi(argv[++i]);
+    else if (a == "--room" && hasVal)   o.roomsize = (float)atof(argv[++i]);
+    else if (a == "--damp" && hasVal)   o.damping  = (float)atof(argv[++i]);
+    else if (a == "--wet" && hasVal)    o.wet      = (float)atof(argv[++i]);
+    else if (a == "--tail" && hasVal)   o.tailSec  = (float)atof(argv[++i]);
+    else if (a == "--repeat" && hasVal) o.repeat   = atoi(argv[++i]);
+    else if (a == "--golden" && hasVal) o.goldenDir = argv[++i];
+    else if (a == "--delay") o.delay = true;
+    else if (a == "--delay-ms" && hasVal) o.delayMs = (float)atof(argv[++i]);
+    else if (a == "--feedback" && hasVal) o.delayFb = (float)atof(argv[++i]);
+    else if (a == "--dyn" && hasVal) {
+      std::string v = argv[++i];
+      if (v == "on")       o.dynamics = true;
+      else if (v == "off") o.dynamics = false;
+      else return false;
+    }
+    else if (a == "--eq" && hasVal) {
+      std::string v = argv[++i];
+      if (v == "on")       o.eq = true;
+      else if (v == "off") o.eq = false;
+      else return false;
+    }
+    else if (a == "--eq-gain" && hasVal) {
+      char* p = argv[++i];
+      long band = strtol(p, &p, 10);
+      if (*p != ':' || band < 0 || band >= vox::Equalizer::BANDS) return false;
+      o.eqBands[band].gainDb = (float)atof(p + 1);
+    }
+    else if (a == "--layout" && hasVal) {
+      std::string l = argv[++i];
+      if (l == "mono")        o.layout = VOX_LAYOUT_MONO;
+      else if (l == "dual")   o.layout = VOX_LAYOUT_DUAL_MONO;
+      else if (l == "stereo") o.layout = VOX_LAYOUT_STEREO;
+      else return false;
+    }
+    else if (a.size() > 2 && a[0] == '-' && a[1] == '-') return false;
+    else pos.push_back(a);
+  }
+  if (!o.goldenDir.empty()) return pos.empty();
+  if (pos.size() != 2 || o.repeat < 1) return false;
+  o.inPath  = pos[0];
+  o.outPath = pos[1];
+  return true;
+}
+
+// ===================== Render =====================
+struct RenderStats {
+  vox::CpuStats blockNs;                      // same accounting as the firmware's CPU, line
+  double totalNs = 0.0;
+  float pkIn = 0, pkWet = 0, pkMix = 0, pkOut = 0;
+};
+
+// Planar channel buffers in, interleaved WAV samples out
+template <int L>
+static void render(const Options& opt, const vox::GraphSettings& gs,
+                   const std::vector<int16_t>* planes, size_t blocks,
+                   WavData& out, RenderStats& rs) {
+  typedef vox::Graph<L> G;
+  const int CH = G::CHANNELS;
+  const int B = vox::BLOCK_SAMPLES;
+  typedef std::chrono::steady_clock Clock;
+
+  out.channels = CH;
+  out.samples.assign(blocks * B * CH, 0);
+  int16_t outBuf[CH][vox::BLOCK_SAMPLES];
+
+  for (int r = 0; r < opt.repeat; r++) {
+    G* g = new G();                           // reverb tanks + delay pool, keep off the stack
+    g->configure(gs);
+    for (int ch = 0; ch < CH; ch++) g->delay[ch].snap();   // start at the set time, no glide
+
+    for (size_t b = 0; b < blocks; b++) {
+      const int16_t* in[CH];
+      int16_t* o[CH];
+      for (int ch = 0; ch < CH; ch++) {
+        in[ch] = &planes[ch][b * B];
+        o[ch] = outBuf[ch];
+      }
+
+      Clock::time_point t0 = Clock::now();
+      g->process(in, o);
+      uint32_t ns = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+      rs.totalNs += ns;
+      rs.blockNs.record(ns);
+
+      int16_t* dst = &out.samples[b * B * CH];
+      for (int i = 0; i < B; i++) {
+        for (int ch = 0; ch < CH; ch++) dst[i * CH + ch] = outBuf[ch][i];
+      }
+    }
+
+    rs.pkIn  = g->peakIn.read();
+    rs.pkWet = g->peakWet.read();
+    rs.pkMix = g->peakMix.read();
+    rs.pkOut = g->peakOut.read();
+    delete g;
+  }
+}
+
+// ===================== Golden corpus =====================
+// GOLDEN,<file>,HASH=<fnv1a>,PEAK=<abs>
+static int writeGoldens(const std::string& dir) {
+  using namespace vox::golden;
+  std::vector<int16_t> in(SAMPLES), out(SAMPLES);
+  for (int input = 0; input < INPUTS; input++) {
+    makeInput(input, in.data(), SAMPLES);
+    for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+      const vox::link::Preset p = presetDefaults(slot);
+      vox::golden::render(presetSettings(p), in.data(), out.data(), SAMPLES);
+
+      char file[256];
+      path(file, sizeof(file), dir.c_str(), input, p.name);
+      if (!writeRaw(file, out.data(), SAMPLES)) {
+        fprintf(stderr, "cannot write %s\n", file);
+        return 1;
+      }
+      int peak = 0;
+      for (int16_t v : out) peak = abs(v) > peak ? abs(v) : peak;
+      printf("GOLDEN,%s,HASH=%08x,PEAK=%d\n", file, hash(out.data(), SAMPLES), peak);
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) { usage(); return 2; }
+  if (!opt.goldenDir.empty()) return writeGoldens(opt.goldenDir);
+
+  WavData in;
+  std::string err;
+  if (!wavRead(opt.inPath, in, err)) { fprintf(stderr, "%s\n", err.c_str()); return 1; }
+  if (in.sampleRate != 44100) {
+    fprintf(stderr, "warning: %u Hz input is rendered as 44100 Hz (no resampling)\n", in.sampleRate);
+  }
+
+  // L/R planes, padded with the tail and up to a whole number of blocks
+  const int B = vox::BLOCK_SAMPLES;
+  size_t frames = in.samples.size() / in.channels;
+  size_t total  = frames + (size_t)(opt.tailSec * vox::SAMPLE_RATE);
+  size_t blocks = (total + B - 1) / B;
+  std::vector<int16_t> planes[2];
+  const int right = in.channels > 1 ? 1 : 0;
+  for (int ch = 0; ch < 2; ch++) planes[ch].assign(blocks * B, 0);
+  for (size_t i = 0; i < frames; i++) {
+    planes[0][i] = in.samples[i * in.channels];
+    planes[1][i] = in.samples[i * in.channels + right];
+  }
+
+  WavData out;
+  out.sampleRate = in.sampleRate;
+
+  vox::GraphSettings gs;
+  gs.roomsize = opt.roomsize;
+  gs.damping  = opt.damping;
+  gs.dry      = DRY_LEVEL;
+  gs.wet      = opt.fx ? opt.wet : 0.0f;
+  gs.level    = (float)(opt.levelPct < 0 ? 0 : opt.levelPct > 100 ? 100 : opt.levelPct) / 100.0f;
+  gs.gainRampMs = GAIN_RAMP_MS;
+  gs.delayMs       = opt.delayMs;
+  gs.delayFeedback = opt.delayFb;
+  gs.delayToneHz   = DELAY_TONE_HZ;
+  gs.delayModHz    = DELAY_MOD_RATE_HZ;
+  gs.delayModMs    = DELAY_MOD_DEPTH_MS;
+  gs.delayMix      = opt.delay ? DELAY_LEVEL : 0.0f;
+  gs.dynamics       = opt.dynamics;
+  gs.gateDb         = DYN_GATE_DB;
+  gs.gateRangeDb    = DYN_GATE_RANGE_DB;
+  gs.compDb         = DYN_COMP_DB;
+  gs.compRatio      = DYN_COMP_RATIO;
+  gs.compAttackMs   = DYN_COMP_ATTACK_MS;
+  gs.compReleaseMs  = DYN_COMP_RELEASE_MS;
+  gs.makeupDb       = DYN_MAKEUP_DB;
+  gs.ceilingDb      = DYN_CEILING_DB;
+  gs.limitReleaseMs = DYN_LIMIT_RELEASE_MS;
+  gs.lookaheadMs    = DYN_LOOKAHEAD_MS;
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) {
+    gs.eq[b] = opt.eqBands[b];
+    if (!opt.eq) gs.eq[b].type = vox::EqType::Off;
+  }
+
+  const double blockBudgetNs = vox::BLOCK_SECONDS * 1e9;
+  RenderStats rs;
+  rs.blockNs.setBudget((uint32_t)blockBudgetNs);
+
+  const char* layoutName;
+  switch (opt.layout) {
+    case VOX_LAYOUT_DUAL_MONO:
+      render<VOX_LAYOUT_DUAL_MONO>(opt, gs, planes, blocks, out, rs);
+      layoutName = vox::Layout<VOX_LAYOUT_DUAL_MONO>::name();
+      break;
+    case VOX_LAYOUT_STEREO:
+      render<VOX_LAYOUT_STEREO>(opt, gs, planes, blocks, out, rs);
+      layoutName = vox::Layout<VOX_LAYOUT_STEREO>::name();
+      break;
+    default:
+      render<VOX_LAYOUT_MONO>(opt, gs, planes, blocks, out, rs);
+      layoutName = vox::Layout<VOX_LAYOUT_MONO>::name();
+      break;
+  }
+
+  if (!wavWrite(opt.outPath, out, err)) { fprintf(stderr, "%s\n", err.c_str()); return 1; }
+
+  vox::CpuStats::Snapshot st;
+  rs.blockNs.takeAndReset(st);
+  const double nBlocks = (double)blocks * opt.repeat;
+  printf("RENDER,LAYOUT=%s,BLOCKS=%.0f,AUDIO_S=%.3f,WALL_S=%.3f,XRT=%.1f\n",
+         layoutName, nBlocks, nBlocks * vox::BLOCK_SECONDS, rs.totalNs * 1e-9,
+         (nBlocks * vox::BLOCK_SECONDS) / (rs.totalNs * 1e-9));
+  printf("BLOCK,MIN_NS=%u,AVG_NS=%u,MAX_NS=%u,BUDGET_NS=%.0f,LOAD=%.2f%%,HIST=%u:%u:%u:%u:%u:%u:%u:%u\n",
+         st.min, st.avg(), st.max, blockBudgetNs, 100.0 * st.avg() / blockBudgetNs,
+         st.hist[0], st.hist[1], st.hist[2], st.hist[3], st.hist[4], st.hist[5], st.hist[6], st.hist[7]);
+  printf("DBG,DRY=%.2f,WET=%.2f,RV=%.2f,PKI=%.2f,PKW=%.2f,PKM=%.2f,PKO=%.2f\n",
+         gs.dry, gs.wet, gs.roomsize, rs.pkIn, rs.pkWet, rs.pkMix, rs.pkOut);
+  return 0;
+}
@@ -0,0 +1,90 @@
+// VOX EFX host tools - minimal 16-bit PCM WAV reader/writer
+
+#include "wav.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t rd32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static void wr32(FILE* f, uint32_t v) {
+  uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+  fwrite(b, 1, 4, f);
+}
+static void wr16(FILE* f, uint16_t v) {
+  uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+  fwrite(b, 1, 2, f);
+}
+
+bool wavRead(const std::string& path, WavData& wav, std::string& err) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) { err = "cannot open " + path; return false; }
+
+  std::vector<uint8_t> buf;
+  uint8_t tmp[4096];
+  size_t n;
+  while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) buf.insert(buf.end(), tmp, tmp + n);
+  fclose(f);
+
+  if (buf.size() < 12 || memcmp(&buf[0], "RIFF", 4) != 0 || memcmp(&buf[8], "WAVE", 4) != 0) {
+    err = path + ": not a RIFF/WAVE file";
+    return false;
+  }
+
+  bool haveFmt = false;
+  size_t pos = 12;
+  while (pos + 8 <= buf.size()) {
+    const uint8_t* ck = &buf[pos];
+    uint32_t len = rd32(ck + 4);
+    size_t body = pos + 8;
+    if (body + len > buf.size()) len = (uint32_t)(buf.size() - body);   // tolerate truncated files
+
+    if (memcmp(ck, "fmt ", 4) == 0 && len >= 16) {
+      uint16_t format = rd16(&buf[body]);
+      wav.channels    = rd16(&buf[body + 2]);
+      wav.sampleRate  = rd32(&buf[body + 4]);
+      uint16_t bits   = rd16(&buf[body + 14]);
+      if ((format != 1 && format != 0xFFFE) || bits != 16 || wav.channels == 0) {
+        err = path + ": only 16-bit PCM is supported";
+        return false;
+      }
+      haveFmt = true;
+    } else if (memcmp(ck, "data", 4) == 0) {
+      if (!haveFmt) { err = path + ": data chunk before fmt"; return false; }
+      wav.samples.resize(len / 2);
+      for (size_t i = 0; i < wav.samples.size(); i++) {
+        wav.samples[i] = (int16_t)rd16(&buf[body + i * 2]);
+      }
+      return true;
+    }
+    pos = body + len + (len & 1);
+  }
+  err = path + ": no data chunk";
+  return false;
+}
+
+bool wavWrite(const std::string& path, const WavData& wav, std::string& err) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) { err = "cannot create " + path; return false; }
+
+  uint32_t dataBytes = (uint32_t)(wav.samples.size() * 2);
+  fwrite("RIFF", 1, 4, f);
+  wr32(f, 36 + dataBytes);
+  fwrite("WAVEfmt ", 1, 8, f);
+  wr32(f, 16);
+  wr16(f, 1);
+  wr16(f, wav.channels);
+  wr32(f, wav.sampleRate);
+  wr32(f, wav.sampleRate * wav.channels * 2);
+  wr16(f, (uint16_t)(wav.channels * 2));
+  wr16(f, 16);
+  fwrite("data", 1, 4, f);
+  wr32(f, dataBytes);
+  for (int16_t s : wav.samples) wr16(f, (uint16_t)s);
+
+  bool ok = (ferror(f) == 0);
+  fclose(f);
+  if (!ok) err = "write failed: " + path;
+  return ok;
+}
@@ -0,0 +1,19 @@
+// VOX EFX host tools - minimal 16-bit PCM WAV reader/writer
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct WavData {
+  uint32_t sampleRate = 44100;
+  uint16_t channels   = 1;
+  std::vector<int16_t> samples;   // interleaved
+};
+
+// Reads RIFF/WAVE PCM 16-bit. Returns false (and sets err) on anything else.
+bool wavRead(const std::string& path, WavData& wav, std::string& err);
+
+// Writes RIFF/WAVE PCM 16-bit.
+bool wavWrite(const std::string& path, const WavData& wav, std::string& err);
@@ -0,0 +1,181 @@
+// VOX EFX - effect settings shared by the firmware and the host renderer
+
+#pragma once
+
+#include "vox_layout.h"
+#include "vox_eq.h"
+#include "vox_graph.h"
+#include "vox_preset.h"
+
+// Channel layout: VOX_LAYOUT_MONO (default), VOX_LAYOUT_DUAL_MONO, VOX_LAYOUT_STEREO.
+// Pick one per build, e.g. build_flags = -DVOX_LAYOUT=VOX_LAYOUT_STEREO
+#ifndef VOX_LAYOUT
+#define VOX_LAYOUT VOX_LAYOUT_MONO
+#endif
+
+// Reverb "roomsize" is typically 0.0 .. 1.0 (smaller -> subtle, larger -> bigger tail)
+static const float REVERB_ROOMSIZE = 0.55f;
+
+// Reverb damping 0.0 .. 1.0 (higher = darker/less bright)
+static const float REVERB_DAMPING = 0.5f;
+
+// Mix levels
+static const float DRY_LEVEL = 1.0f;    // dry always passes
+static const float WET_LEVEL = 0.35f;   // wet mix when enabled
+
+// Mixer/amp gain changes (footswitch toggles, level) ramp linearly over this
+static const float GAIN_RAMP_MS = 20.0f;
+
+// Delay (mixer ch2). Time is the tap-tempo default; taps override it.
+static const float DELAY_TIME_MS      = 375.0f;
+static const float DELAY_FEEDBACK     = 0.35f;    // 0.0 .. 0.98
+static const float DELAY_TONE_HZ      = 4000.0f;  // low-pass in the feedback loop
+static const float DELAY_MOD_RATE_HZ  = 0.5f;
+static const float DELAY_MOD_DEPTH_MS = 1.0f;     // 0 .. 5
+static const float DELAY_LEVEL        = 0.35f;    // wet mix when enabled
+static const float DELAY_TAP_SUBDIV   = 1.0f;     // delay = tapped beat x this (0.75 = dotted 8th)
+
+// Delay pool: VOX_DELAY_MAX_MS per channel (lib/VoxDsp vox_delay.h, default 1000).
+// In DMAMEM (RAM2) by default; -DVOX_DELAY_PSRAM=1 moves it to EXTMEM for
+// boards with PSRAM fitted, where VOX_DELAY_MAX_MS can go up to 11000.
+#ifndef VOX_DELAY_PSRAM
+#define VOX_DELAY_PSRAM 0
+#endif
+
+// Dynamics (input, ahead of reverb/delay/dry): gate -> compressor -> limiter
+static const bool  DYN_ENABLED          = true;
+static const float DYN_GATE_DB          = -60.0f;   // gate threshold
+static const float DYN_GATE_RANGE_DB    = 0.0f;     // 0 = gate off
+static const float DYN_COMP_DB          = -18.0f;   // compressor threshold
+static const float DYN_COMP_RATIO       = 3.0f;
+static const float DYN_COMP_ATTACK_MS   = 5.0f;
+static const float DYN_COMP_RELEASE_MS  = 120.0f;
+static const float DYN_MAKEUP_DB        = 3.0f;
+static const float DYN_CEILING_DB       = -1.0f;    // brickwall limiter
+static const float DYN_LIMIT_RELEASE_MS = 60.0f;
+static const float DYN_LOOKAHEAD_MS     = 2.0f;     // 0 .. 5
+
+// EQ (after dynamics): 6 bands, the EQ panel's layout. Flat by default;
+// shelves/peaks at 0 dB and Off bands cost nothing. A SET_EQ frame from
+// the ESP32 (shared/VoxLink) changes a band's gain at run time.
+static const vox::EqBand EQ_BANDS[vox::Equalizer::BANDS] = {
+  //  type                   Hz        dB     Q
+  { vox::EqType::Off,        80.0f,    0.0f,  0.707f },  // high-pass (Off or HighPass)
+  { vox::EqType::LowShelf,   120.0f,   0.0f,  0.707f },
+  { vox::EqType::Peak,       400.0f,   0.0f,  1.0f   },
+  { vox::EqType::Peak,       1000.0f,  0.0f,  1.0f   },
+  { vox::EqType::Peak,       3000.0f,  0.0f,  1.0f   },
+  { vox::EqType::HighShelf,  6000.0f,  0.0f,  0.707f },
+};
+static const float EQ_GAIN_MAX_DB = 12.0f;  // +/- range accepted over UART
+
+// Level meters (MTR line, METER frames): segments lit, evenly spaced in dB
+// from the first to the last (lib/VoxDsp vox_meter.h, thresholds computed
+// at compile time). The count is the ESP32 sliders' range
+static const int       METER_SEGMENTS = vox::link::Meter::SEGMENTS;
+static constexpr float METER_FLOOR_DB = -48.0f;   // first segment
+static constexpr float METER_TOP_DB   = -6.0f;    // all lit (1.5 dB steps)
+
+// Presets (shared/VoxLink vox_preset.h). Slot 0 is the settings above with
+// both effects off, as the pedal boots; the others change a few of them.
+// Holding the left footswitch steps to the next slot.
+static const int   PRESET_SLOTS    = 4;
+static const float PRESET_XFADE_MS = 250.0f;   // recall: mixer gains (wet tails) fade over this
+
+static_assert(vox::link::PRESET_EQ_BANDS == vox::Equalizer::BANDS, "a preset holds every EQ band");
+
+static inline vox::link::Preset presetDefaults(int slot) {
+  vox::link::Preset p;
+  p.setName("DEFAULT");
+  p.reverbOn   = 0;
+  p.delayOn    = 0;
+  p.dynamicsOn = DYN_ENABLED;
+  p.level      = 50;
+  p.roomsize   = REVERB_ROOMSIZE;
+  p.damping    = REVERB_DAMPING;
+  p.wet        = WET_LEVEL;
+  p.dry        = DRY_LEVEL;
+  p.delayMs       = DELAY_TIME_MS;
+  p.delayFeedback = DELAY_FEEDBACK;
+  p.delayToneHz   = DELAY_TONE_HZ;
+  p.delayModHz    = DELAY_MOD_RATE_HZ;
+  p.delayModMs    = DELAY_MOD_DEPTH_MS;
+  p.delayLevel    = DELAY_LEVEL;
+  p.gateDb         = DYN_GATE_DB;
+  p.gateRangeDb    = DYN_GATE_RANGE_DB;
+  p.compDb         = DYN_COMP_DB;
+  p.compRatio      = DYN_COMP_RATIO;
+  p.compAttackMs   = DYN_COMP_ATTACK_MS;
+  p.compReleaseMs  = DYN_COMP_RELEASE_MS;
+  p.makeupDb       = DYN_MAKEUP_DB;
+  p.ceilingDb      = DYN_CEILING_DB;
+  p.limitReleaseMs = DYN_LIMIT_RELEASE_MS;
+  p.lookaheadMs    = DYN_LOOKAHEAD_MS;
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) p.eqDb10[b] = (int16_t)(EQ_BANDS[b].gainDb * 10.0f);
+
+  switch (slot) {
+    case 1:   // big room
+      p.setName("HALL");
+      p.reverbOn = 1;
+      p.roomsize = 0.85f;
+      p.damping  = 0.35f;
+      p.wet      = 0.45f;
+      break;
+    case 2:   // short single echo
+      p.setName("SLAP");
+      p.delayOn       = 1;
+      p.delayMs       = 110.0f;
+      p.delayFeedback = 0.1f;
+      p.delayLevel    = 0.4f;
+      break;
+    case 3:   // long modulated echoes into a room
+      p.setName("AMBIENT");
+      p.reverbOn      = 1;
+      p.delayOn       = 1;
+      p.roomsize      = 0.75f;
+      p.wet           = 0.4f;
+      p.delayMs       = 480.0f;
+      p.delayFeedback = 0.5f;
+      p.delayToneHz   = 2500.0f;
+      p.delayModMs    = 2.0f;
+      p.eqDb10[5]     = -30;   // darker top
+      break;
+    default:
+      break;
+  }
+  return p;
+}
+
+// What applyEffectState() and the EQ bands set on the chain for preset p,
+// as host graph settings (host/render.cpp --golden, test_golden)
+static inline vox::GraphSettings presetSettings(const vox::link::Preset& p) {
+  vox::GraphSettings gs;
+  gs.roomsize   = p.roomsize;
+  gs.damping    = p.damping;
+  gs.dry        = p.dry;
+  gs.wet        = p.reverbOn ? p.wet : 0.0f;
+  gs.level      = (float)(p.level > 100 ? 100 : p.level) / 100.0f;
+  gs.gainRampMs = GAIN_RAMP_MS;
+  gs.delayMs       = p.delayMs;
+  gs.delayFeedback = p.delayFeedback;
+  gs.delayToneHz   = p.delayToneHz;
+  gs.delayModHz    = p.delayModHz;
+  gs.delayModMs    = p.delayModMs;
+  gs.delayMix      = p.delayOn ? p.delayLevel : 0.0f;
+  gs.dynamics       = p.dynamicsOn != 0;
+  gs.gateDb         = p.gateDb;
+  gs.gateRangeDb    = p.gateRangeDb;
+  gs.compDb         = p.compDb;
+  gs.compRatio      = p.compRatio;
+  gs.compAttackMs   = p.compAttackMs;
+  gs.compReleaseMs  = p.compReleaseMs;
+  gs.makeupDb       = p.makeupDb;
+  gs.ceilingDb      = p.ceilingDb;
+  gs.limitReleaseMs = p.limitReleaseMs;
+  gs.lookaheadMs    = p.lookaheadMs;
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) {
+    gs.eq[b] = EQ_BANDS[b];
+    gs.eq[b].gainDb = p.eqDb10[b] * 0.1f;
+  }
+  return gs;
+}
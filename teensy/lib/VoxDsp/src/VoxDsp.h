@@ -0,0 +1,24 @@
+// VOX EFX - portable DSP kernels (Teensy firmware + host tools)
+
+#pragma once
+
+#include "vox_block.h"
+#include "vox_simd.h"
+#include "vox_layout.h"
+#include "vox_freeverb.h"
+#include "vox_reverb.h"
+#include "vox_delay.h"
+#include "vox_tap_tempo.h"
+#include "vox_footswitch.h"
+#include "vox_ramp.h"
+#include "vox_dynamics.h"
+#include "vox_eq.h"
+#include "vox_mixer.h"
+#include "vox_amp.h"
+#include "vox_peak.h"
+#include "vox_meter.h"
+#include "vox_graph.h"
+#include "vox_chain.h"
+#include "vox_cpu_stats.h"
+#include "vox_pool_cal.h"
+#include "vox_log_store.h"
@@ -0,0 +1,32 @@
+// VOX EFX - output amplifier kernel (AudioAmplifier math, with a ramped gain)
+// Gain changes ramp per block (vox_ramp.h); a settled gain is bit-exact
+// with AudioAmplifier.
+
+#pragma once
+
+#include "vox_block.h"
+#include "vox_ramp.h"
+
+namespace vox {
+
+class Amplifier {
+public:
+  void gain(float n) { level.set(gainToQ16(n)); }
+
+  void ramp(Ramp::Shape s, float ms) { level.shape(s, ms); }
+  void snap()                        { level.snap(); }
+
+  // Returns false once the gain has settled at 0 (AudioAmplifier transmits
+  // nothing then).
+  bool update(const int16_t* in, int16_t* out) {
+    const Ramp::Segment seg = level.next();
+    if ((seg.settled() && seg.q16() == 0) || !in) return false;
+    Ramp::scale(seg, in, out);
+    return true;
+  }
+
+private:
+  Ramp level;
+};
+
+} // namespace vox
@@ -0,0 +1,236 @@
+// VOX EFX - per-kernel micro-benchmarks (bench/bench_main.cpp, host and Teensy)
+// - Suite holds one instance of every per-block kernel, set up as the graph
+//   uses it, fed -12 dBFS noise. run(k) is one block of kernel k and nothing
+//   else; prepare(k) (untimed) restores its input or flips its ramp target
+// - measure() times RUNS blocks after WARMUP with a Timer (start(), then
+//   stop() returns ticks: ARM_DWT_CYCCNT cycles on the Teensy with interrupts
+//   off, steady_clock ns on the host). The cost of an empty block (timer
+//   and call overhead) is measured the same way and subtracted
+// - One CSV row per kernel (HEADER): min/avg/max ticks per block and min
+//   per sample (the min is the steadiest figure across runs and commits)
+// - A new kernel is a KERNELS entry, its state here and a case in prepare()
+//   and run()
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vox_block.h"
+#include "vox_simd.h"
+#include "vox_ramp.h"
+#include "vox_peak.h"
+#include "vox_mixer.h"
+#include "vox_amp.h"
+#include "vox_freeverb.h"
+#include "vox_reverb.h"
+#include "vox_eq.h"
+#include "vox_delay.h"
+#include "vox_dynamics.h"
+#include "vox_cpu_stats.h"
+
+namespace vox {
+namespace bench {
+
+static const int WARMUP = 32;
+static const int RUNS   = 512;
+
+static const char* const HEADER = "label,kernel,runs,min,avg,max,unit,per_sample";
+
+enum Kernel {
+  NONE,             // empty block: the overhead subtracted from the rest
+  PEAK,
+  MIXER,            // 3 inputs (wet, dry, delay), gains settled
+  MIXER_RAMP,       // same, a gain ramping every block
+  AMP,
+  AMP_RAMP,
+  COMBS,            // the 8 reverb combs (4 x combPair)
+  ALLPASSES,        // one diffuser: sum scale, 4 allpasses, output scale
+  REVERB,           // ReverbTank<1>: input scale, combs, allpasses, output scale
+  REVERB_STEREO,    // ReverbTank<2>: shared combs, two diffusers
+  FREEVERB_REF,     // sample-at-a-time reference port
+  BIQUAD,           // one active EQ band
+  EQ6,              // all six EQ bands active
+  DELAY,            // modulated read + filtered feedback write
+  DYNAMICS,         // gate, compressor, look-ahead limiter
+  KERNELS
+};
+
+inline const char* name(int k) {
+  static const char* const NAMES[KERNELS] = {
+    "none", "peak", "mixer", "mixer_ramp", "amp", "amp_ramp", "combs", "allpasses",
+    "reverb", "reverb_stereo", "freeverb_ref", "biquad", "eq6", "delay", "dynamics",
+  };
+  return k >= 0 && k < KERNELS ? NAMES[k] : "?";
+}
+
+// Large (reverb tanks, delay pool): allocate statically or on the heap
+class Suite {
+public:
+  static const uint32_t DELAY_POOL = Delay::poolSamples(100);
+
+  Suite() {
+    uint32_t r = 1;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) {
+      r = r * 1664525u + 1013904223u;
+      noise[i] = (int16_t)((int32_t)(r >> 16) - 32768) / 4;   // -12 dBFS
+      r = r * 1664525u + 1013904223u;
+      noise2[i] = (int16_t)((int32_t)(r >> 16) - 32768) / 4;
+    }
+
+    for (int m = 0; m < 2; m++) {
+      mixer[m].ramp(Ramp::LINEAR, 20.0f);
+      mixer[m].gain(0, 0.35f);
+      mixer[m].gain(1, 1.0f);
+      mixer[m].gain(2, 0.35f);
+      mixer[m].snap();
+      amp[m].ramp(Ramp::LINEAR, 20.0f);
+      amp[m].gain(0.5f);
+      amp[m].snap();
+    }
+
+    reverb::initLines(comb, reverb::COMBS, reverb::COMB_LEN, 0, combMem);
+    reverb::initLines(ap, reverb::ALLPASSES, reverb::ALLPASS_LEN, 0, apMem);
+    const int damp1 = (int)(0.5f * 13107.2f);
+    dampPacked = pack16((int16_t)(32768 - damp1), (int16_t)damp1);
+    feedback = (int)(0.55f * 9175.04f) + 22937;
+    tank.roomsize(0.55f);
+    stereo.roomsize(0.55f);
+    freeverb.roomsize(0.55f);
+
+    EqBand b = { EqType::Peak, 1000.0f, 6.0f, 1.0f };
+    biquad.setBand(3, b);
+    const EqBand six[Equalizer::BANDS] = {
+      { EqType::HighPass,  80.0f,   0.0f,  0.707f },
+      { EqType::LowShelf,  120.0f,  3.0f,  0.707f },
+      { EqType::Peak,      400.0f,  -2.0f, 1.0f   },
+      { EqType::Peak,      1000.0f, 4.0f,  1.0f   },
+      { EqType::Peak,      3000.0f, -3.0f, 1.0f   },
+      { EqType::HighShelf, 6000.0f, 2.0f,  0.707f },
+    };
+    for (int i = 0; i < Equalizer::BANDS; i++) eq6.setBand(i, six[i]);
+
+    delay.begin(delayMem, DELAY_POOL);
+    delay.time(80.0f);
+    delay.snap();
+    delay.feedback(0.35f);
+    delay.tone(4000.0f);
+    delay.modulation(0.5f, 1.0f);
+
+    dynamics.bypass(false);
+    dynamics.compressor(-18.0f, 3.0f, 3.0f);
+    dynamics.lookahead(2.0f);
+  }
+
+  // Untimed, before every run(k)
+  void prepare(int k) {
+    switch (k) {
+      case MIXER_RAMP: flip = !flip; mixer[1].gain(1, flip ? 0.5f : 1.0f); break;
+      case AMP_RAMP:   flip = !flip; amp[1].gain(flip ? 0.25f : 0.5f); break;
+      case ALLPASSES:  for (int i = 0; i < BLOCK_SAMPLES; i++) sum[i] = noise[i] * 4; break;
+      case BIQUAD:     biquad.passthrough(); break;   // the ISR-side set switch
+      case EQ6:        eq6.passthrough(); break;
+      default: break;
+    }
+  }
+
+  // One block of kernel k
+  void run(int k) {
+    const int16_t* in3[4] = { noise2, noise, out2, nullptr };
+    switch (k) {
+      case PEAK:          peak.update(noise); break;
+      case MIXER:         mixer[0].update(in3, out); break;
+      case MIXER_RAMP:    mixer[1].update(in3, out); break;
+      case AMP:           amp[0].update(noise, out); break;
+      case AMP_RAMP:      amp[1].update(noise, out); break;
+      case COMBS:
+        for (int c = 0; c < reverb::COMBS; c += 2) reverb::combPair(&comb[c], noise, sum, dampPacked, feedback, c == 0);
+        break;
+      case ALLPASSES:
+        reverb::diffuse(ap, sum, work);
+        break;
+      case REVERB:        tank.update(noise, out); break;
+      case REVERB_STEREO: {
+        const int16_t* i2[2] = { noise, noise2 };
+        int16_t* o2[2] = { out, out2 };
+        stereo.process(i2, o2);
+        break;
+      }
+      case FREEVERB_REF:  freeverb.update(noise, out); break;
+      case BIQUAD:        biquad.update(noise, out); break;
+      case EQ6:           eq6.update(noise, out); break;
+      case DELAY:         delay.update(noise, out); break;
+      case DYNAMICS:      dynamics.update(noise, out); break;
+      default: break;
+    }
+  }
+
+  // The last output, so nothing is optimised away
+  int16_t sink() const { return (int16_t)(out[0] ^ out2[0] ^ work[0] ^ (int16_t)sum[0]); }
+
+private:
+  int16_t noise[BLOCK_SAMPLES], noise2[BLOCK_SAMPLES];
+  int16_t out[BLOCK_SAMPLES] = {}, out2[BLOCK_SAMPLES] = {}, work[BLOCK_SAMPLES] = {};
+  int32_t sum[BLOCK_SAMPLES] = {};
+  bool    flip = false;
+
+  Peak      peak;
+  Mixer4    mixer[2];
+  Amplifier amp[2];
+
+  int16_t    combMem[reverb::COMB_MEM];
+  int16_t    apMem[reverb::ALLPASS_MEM];
+  ReverbLine comb[reverb::COMBS];
+  ReverbLine ap[reverb::ALLPASSES];
+  uint32_t   dampPacked;
+  int32_t    feedback;
+
+  ReverbTank<1> tank;
+  ReverbTank<2> stereo;
+  Freeverb      freeverb;
+  Equalizer     biquad, eq6;
+  Delay         delay;
+  int16_t       delayMem[DELAY_POOL];
+  Dynamics      dynamics;
+};
+
+template <class Timer>
+CpuStats::Snapshot measure(Suite& s, int k, Timer& t) {
+  for (int i = 0; i < WARMUP; i++) {
+    s.prepare(k);
+    s.run(k);
+  }
+  CpuStats st;
+  for (int i = 0; i < RUNS; i++) {
+    s.prepare(k);
+    t.start();
+    s.run(k);
+    st.record(t.stop());
+  }
+  CpuStats::Snapshot snap;
+  st.takeAndReset(snap);
+  return snap;
+}
+
+// Every kernel, one CSV row each through print(const char* line) (no
+// newline; HEADER first)
+template <class Timer, class Print>
+void runAll(Suite& s, Timer& t, const char* label, const char* unit, Print print) {
+  print(HEADER);
+  const uint32_t overhead = measure(s, NONE, t).min;
+  for (int k = NONE + 1; k < KERNELS; k++) {
+    const CpuStats::Snapshot r = measure(s, k, t);
+    const uint32_t lo  = r.min > overhead ? r.min - overhead : 0;
+    const uint32_t avg = r.avg() > overhead ? r.avg() - overhead : 0;
+    const uint32_t hi  = r.max > overhead ? r.max - overhead : 0;
+    const uint32_t per100 = (uint32_t)((uint64_t)lo * 100 / BLOCK_SAMPLES);
+    char line[128];
+    snprintf(line, sizeof(line), "%s,%s,%u,%u,%u,%u,%s,%u.%02u", label, name(k), (unsigned)r.count,
+             (unsigned)lo, (unsigned)avg, (unsigned)hi, unit, (unsigned)(per100 / 100), (unsigned)(per100 % 100));
+    print(line);
+  }
+}
+
+} // namespace bench
+} // namespace vox
@@ -0,0 +1,9 @@
+// VOX EFX - shared block constants (see vox_block.h)
+
+#include "vox_block.h"
+
+namespace vox {
+
+const int16_t ZERO_BLOCK[BLOCK_SAMPLES] = { 0 };
+
+} // namespace vox
@@ -0,0 +1,50 @@
+// VOX EFX - block constants and fixed-point helpers shared by every kernel
+// - Plain C++ (no Arduino / Audio.h), so kernels build on the host too
+// - Helpers mirror the Teensy Audio Library's dspinst.h semantics bit-for-bit
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef AUDIO_BLOCK_SAMPLES
+#define AUDIO_BLOCK_SAMPLES 128
+#endif
+
+namespace vox {
+
+static const int   BLOCK_SAMPLES = AUDIO_BLOCK_SAMPLES;
+static const float SAMPLE_RATE   = 44100.0f;                            // Teensy 4.x I2S rate
+static const float BLOCK_SECONDS = (float)AUDIO_BLOCK_SAMPLES / SAMPLE_RATE;   // ~2.9 ms
+
+// A block of silence, for absent (nullptr) inputs
+extern const int16_t ZERO_BLOCK[BLOCK_SAMPLES];
+
+// Q16 gain used by AudioMixer4 / AudioAmplifier (65536 == 1.0)
+static const int32_t GAIN_UNITY = 65536;
+
+static inline int32_t gainToQ16(float g) {
+  if (g > 32767.0f) g = 32767.0f;
+  else if (g < -32767.0f) g = -32767.0f;
+  return (int32_t)(g * 65536.0f);
+}
+
+// Clamp to int16 range (signed_saturate_rshift(n, 16, 0))
+static inline int16_t saturate16(int32_t n) {
+  if (n > 32767) return 32767;
+  if (n < -32768) return -32768;
+  return (int16_t)n;
+}
+
+// (mult * x) >> 16, like signed_multiply_32x16b()
+static inline int32_t mulQ16(int32_t mult, int16_t x) {
+  return (int32_t)(((int64_t)mult * x) >> 16);
+}
+
+// Shift right rounding toward zero, then saturate (Freeverb's sat16)
+static inline int16_t sat16(int32_t n, int rshift) {
+  if (n < 0) n += (1 << rshift) - 1;
+  n = n >> rshift;
+  return saturate16(n);
+}
+
+} // namespace vox
@@ -0,0 +1,201 @@
+// VOX EFX - the effect chain as data, shared by the firmware and host tests
+// - NODES lists the node kinds, EDGES the patch cords of one channel; the
+//   firmware (src/effect_chain.h) builds and wires one copy per channel
+//   from these tables, so a new stage is an INFO row and its EDGES lines
+// - Checked at compile time (static_asserts below): every port exists, no
+//   input has two drivers, every output feeds 1..MAX_FANOUT inputs, and
+//   the edges form a DAG
+// - ORDER is the AudioStream update order: a topological order picked
+//   greedily so each block is released as soon as possible (a tap runs
+//   right after the node it taps). BLOCKS_PER_CHANNEL is the most graph
+//   blocks alive at once in that order; DECLARED_BLOCKS_PER_CHANNEL is the
+//   same for plain NODES order, for comparison
+// Block model: a node's output block lives from its update() until the
+// last consumer's update() has run; while a node runs, its inputs and its
+// own output are all allocated
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vox {
+namespace chain {
+
+enum Node : uint8_t {
+  IN,         // AudioInputI2S, output port = channel
+  DYN,        // gate/comp/limiter
+  EQ,         // 6-band parametric
+  REVERB,     // output/input port = the tank's port for the channel
+  DELAY,
+  MIX,        // port 0 wet, 1 dry, 2 delay
+  AMP,        // output level
+  OUT,        // AudioOutputI2S, input port = channel
+  PEAK_IN,
+  PEAK_WET,
+  PEAK_MIX,
+  PEAK_OUT,
+  NODES
+};
+
+struct NodeInfo {
+  const char* name;
+  uint8_t inputs;     // ports per channel
+  bool    output;     // transmits a block per channel
+};
+
+constexpr NodeInfo INFO[NODES] = {
+  { "IN",  0, true  },
+  { "DYN", 1, true  },
+  { "EQ",  1, true  },
+  { "RV",  1, true  },
+  { "DLY", 1, true  },
+  { "MX",  4, true  },
+  { "AMP", 1, true  },
+  { "OUT", 1, false },
+  { "PKI", 1, false },
+  { "PKW", 1, false },
+  { "PKM", 1, false },
+  { "PKO", 1, false },
+};
+
+struct Edge {
+  Node    from;
+  Node    to;
+  uint8_t port;       // input port of `to`
+};
+
+// One channel's patch cords
+constexpr Edge EDGES[] = {
+  { IN,     DYN,      0 },    // dynamics first
+  { DYN,    EQ,       0 },    // then EQ
+  { EQ,     REVERB,   0 },    // feed reverb
+  { IN,     PEAK_IN,  0 },    // input peak
+  { EQ,     MIX,      1 },    // dry -> mixer ch1
+  { REVERB, MIX,      0 },    // wet -> mixer ch0
+  { REVERB, PEAK_WET, 0 },    // wet peak
+  { EQ,     DELAY,    0 },    // feed delay
+  { DELAY,  MIX,      2 },    // delay -> mixer ch2
+  { MIX,    AMP,      0 },    // mixer -> amp
+  { MIX,    PEAK_MIX, 0 },
+  { AMP,    PEAK_OUT, 0 },
+  { AMP,    OUT,      0 },    // mono: left out only
+};
+constexpr int EDGE_COUNT = sizeof(EDGES) / sizeof(EDGES[0]);
+
+// A block's reference count is 8 bits; the real limit is the destination
+// list walked in every transmit()
+constexpr int MAX_FANOUT = 4;
+
+// AudioInputI2S holds an L and an R block while filling them; AudioOutputI2S
+// holds two per channel while playing them
+constexpr int IO_BLOCKS_FIXED = 2;
+constexpr int IO_BLOCKS_PER_CHANNEL = 2;
+
+// ---- checks ----
+
+constexpr int fanOut(int n) {
+  int f = 0;
+  for (int e = 0; e < EDGE_COUNT; e++) f += EDGES[e].from == n;
+  return f;
+}
+
+constexpr bool portsExist() {
+  for (int e = 0; e < EDGE_COUNT; e++) {
+    if (EDGES[e].from >= NODES || EDGES[e].to >= NODES) return false;
+    if (!INFO[EDGES[e].from].output) return false;
+    if (EDGES[e].port >= INFO[EDGES[e].to].inputs) return false;
+  }
+  return true;
+}
+
+constexpr bool oneDriverPerInput() {
+  for (int a = 0; a < EDGE_COUNT; a++) {
+    for (int b = a + 1; b < EDGE_COUNT; b++) {
+      if (EDGES[a].to == EDGES[b].to && EDGES[a].port == EDGES[b].port) return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool fanOutInRange() {
+  for (int n = 0; n < NODES; n++) {
+    const int f = fanOut(n);
+    if (INFO[n].output && (f < 1 || f > MAX_FANOUT)) return false;
+  }
+  return true;
+}
+
+// ---- scheduling ----
+
+struct Schedule {
+  Node order[NODES] = {};
+  int  count = 0;     // < NODES: the edges have a cycle
+  int  peak = 0;      // most blocks alive at once, per channel
+};
+
+// Every input of n comes from a placed node
+constexpr bool ready(int n, const bool* placed) {
+  for (int e = 0; e < EDGE_COUNT; e++) {
+    if (EDGES[e].to == n && !placed[EDGES[e].from]) return false;
+  }
+  return true;
+}
+
+// Blocks released once n runs: sources whose only unplaced consumer is n
+constexpr int freedBy(int n, const bool* placed) {
+  int freed = 0;
+  for (int src = 0; src < NODES; src++) {
+    bool feedsN = false, other = false;
+    for (int e = 0; e < EDGE_COUNT; e++) {
+      if (EDGES[e].from != src) continue;
+      if (EDGES[e].to == n) feedsN = true;
+      else if (!placed[EDGES[e].to]) other = true;
+    }
+    if (feedsN && !other) freed++;
+  }
+  return freed;
+}
+
+// greedy: of the ready nodes, run the one leaving the fewest blocks alive;
+// otherwise (and on ties) the first in NODES order
+constexpr Schedule schedule(bool greedy) {
+  Schedule s;
+  bool placed[NODES] = {};
+  int live = 0;
+  for (int step = 0; step < NODES; step++) {
+    int best = -1, bestLive = 0;
+    for (int n = 0; n < NODES; n++) {
+      if (placed[n] || !ready(n, placed)) continue;
+      const int after = live - freedBy(n, placed) + (INFO[n].output ? 1 : 0);
+      if (best < 0 || (greedy && after < bestLive)) {
+        best = n;
+        bestLive = after;
+      }
+    }
+    if (best < 0) return s;
+    const int during = live + (INFO[best].output ? 1 : 0);
+    if (during > s.peak) s.peak = during;
+    live = bestLive;
+    placed[best] = true;
+    s.order[s.count++] = (Node)best;
+  }
+  return s;
+}
+
+constexpr Schedule ORDER = schedule(true);
+constexpr int BLOCKS_PER_CHANNEL = ORDER.peak;
+constexpr int DECLARED_BLOCKS_PER_CHANNEL = schedule(false).peak;
+
+// Graph blocks plus I2S buffers for a build with `channels` channels
+constexpr int blocks(int channels, int perChannel = BLOCKS_PER_CHANNEL) {
+  return perChannel * channels + IO_BLOCKS_FIXED + IO_BLOCKS_PER_CHANNEL * channels;
+}
+
+static_assert(portsExist(), "vox::chain: an edge uses a missing node or port");
+static_assert(oneDriverPerInput(), "vox::chain: an input port has two drivers");
+static_assert(fanOutInRange(), "vox::chain: an output feeds nothing or more than MAX_FANOUT inputs");
+static_assert(ORDER.count == NODES, "vox::chain: the edges have a cycle");
+static_assert(ORDER.order[0] == IN, "vox::chain: the I2S input must update first");
+
+} // namespace chain
+} // namespace vox
@@ -0,0 +1,84 @@
+// VOX EFX - per-node DSP cost accumulator
+// - record() runs in the audio ISR once per block: no division, no floats
+// - Histogram bins are fractions of the block deadline (AUDIO_BLOCK_SAMPLES / fs):
+//     <1% <2% <5% <10% <20% <50% <100% >=100% (missed the deadline)
+// - The reader copies with interrupts disabled, then formats at leisure
+
+#pragma once
+
+#include "vox_block.h"
+
+namespace vox {
+
+class CpuStats {
+public:
+  static const int BINS = 8;
+
+  struct Snapshot {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t hist[BINS];
+
+    uint32_t avg() const { return count ? (uint32_t)(sum / count) : 0; }
+
+    // Fold in another window (e.g. the same node on the other channel)
+    void merge(const Snapshot& o) {
+      if (o.count == 0) return;
+      if (count == 0) { *this = o; return; }
+      if (o.min < min) min = o.min;
+      if (o.max > max) max = o.max;
+      sum += o.sum;
+      count += o.count;
+      for (int i = 0; i < BINS; i++) {
+        uint32_t h = (uint32_t)hist[i] + o.hist[i];
+        hist[i] = h > 0xFFFF ? 0xFFFF : (uint16_t)h;
+      }
+    }
+  };
+
+  CpuStats() {
+    setBudget(600000000u / 44100u * BLOCK_SAMPLES);   // 600 MHz default
+    reset();
+  }
+
+  // budget = cycles (or ns on the host) available per block
+  void setBudget(uint32_t budget) {
+    static const uint16_t PERMILLE[BINS - 1] = { 10, 20, 50, 100, 200, 500, 1000 };
+    for (int i = 0; i < BINS - 1; i++) edge[i] = (uint32_t)((uint64_t)budget * PERMILLE[i] / 1000);
+  }
+
+  uint32_t budget() const { return edge[BINS - 2]; }
+
+  void record(uint32_t cycles) {
+    if (cycles < s.min) s.min = cycles;
+    if (cycles > s.max) s.max = cycles;
+    s.sum += cycles;
+    s.count++;
+    int b = 0;
+    while (b < BINS - 1 && cycles >= edge[b]) b++;
+    if (s.hist[b] != 0xFFFF) s.hist[b]++;
+  }
+
+  // Copy and restart the window. On the Teensy call with interrupts disabled.
+  void takeAndReset(Snapshot& out) {
+    out = s;
+    if (out.count == 0) out.min = 0;
+    reset();
+  }
+
+  void reset() {
+    s.count = 0;
+    s.min = 0xFFFFFFFFu;
+    s.max = 0;
+    s.sum = 0;
+    for (int i = 0; i < BINS; i++) s.hist[i] = 0;
+  }
+
+private:
+  uint32_t edge[BINS - 1];
+  Snapshot s;
+};
+
+} // namespace vox
@@ -0,0 +1,138 @@
+// VOX EFX - modulated digital delay (see vox_delay.h)
+
+#include "vox_delay.h"
+#include "vox_simd.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace vox {
+
+void Delay::begin(int16_t* mem, uint32_t samples) {
+  if (samples < GUARD + MIN_SAMPLES) mem = nullptr;   // too small to delay anything
+  buf = mem;
+  len = mem ? samples : 0;
+  writeIndex = 0;
+  lowpass = 0;
+  lfoPhase = 0;
+  if (buf) memset(buf, 0, len * sizeof(int16_t));
+  timeSamples(MIN_SAMPLES);
+  snap();
+}
+
+void Delay::time(float ms) {
+  if (ms < 0.0f) ms = 0.0f;
+  timeSamples((uint32_t)(ms * (SAMPLE_RATE / 1000.0f) + 0.5f));
+}
+
+void Delay::timeSamples(uint32_t n) {
+  const uint32_t hi = maxDelaySamples();
+  if (n > hi) n = hi;
+  if (n < (uint32_t)MIN_SAMPLES) n = MIN_SAMPLES;
+  target = (int32_t)(n << FRAC_BITS);
+}
+
+void Delay::feedback(float n) {
+  if (n > 0.98f) n = 0.98f;
+  else if (n < 0.0f) n = 0.0f;
+  fbkQ15 = (int32_t)(n * 32768.0f);
+}
+
+void Delay::tone(float hz) {
+  const float nyquist = SAMPLE_RATE * 0.5f;
+  if (hz >= nyquist) { toneQ15 = 32767; return; }
+  if (hz < 20.0f) hz = 20.0f;
+  float a = 1.0f - expf(-2.0f * 3.14159265f * hz / SAMPLE_RATE);
+  toneQ15 = (int32_t)(a * 32767.0f);
+}
+
+void Delay::modulation(float rateHz, float depthMs) {
+  if (rateHz < 0.0f) rateHz = 0.0f;
+  float depth = depthMs * (SAMPLE_RATE / 1000.0f);
+  if (depth > (float)DEPTH_MAX) depth = (float)DEPTH_MAX;
+  else if (depth < 0.0f) depth = 0.0f;
+  lfoInc = (uint32_t)(rateHz * (4294967296.0f / SAMPLE_RATE));
+  depthQ12 = (int32_t)(depth * (float)(1 << FRAC_BITS));
+}
+
+// Ring -> linear, at most two spans
+void Delay::copyOut(uint32_t start, int16_t* dst, int n) const {
+  uint32_t first = len - start;
+  if ((uint32_t)n <= first) {
+    memcpy(dst, buf + start, n * sizeof(int16_t));
+  } else {
+    memcpy(dst, buf + start, first * sizeof(int16_t));
+    memcpy(dst + first, buf, (n - first) * sizeof(int16_t));
+  }
+}
+
+// Linear -> ring, at most two spans
+void Delay::copyIn(uint32_t start, const int16_t* src, int n) {
+  uint32_t first = len - start;
+  if ((uint32_t)n <= first) {
+    memcpy(buf + start, src, n * sizeof(int16_t));
+  } else {
+    memcpy(buf + start, src, first * sizeof(int16_t));
+    memcpy(buf, src + first, (n - first) * sizeof(int16_t));
+  }
+}
+
+void Delay::update(const int16_t* in, int16_t* out) {
+  if (!buf) {
+    memset(out, 0, BLOCK_SAMPLES * sizeof(int16_t));
+    return;
+  }
+  if (!in) in = ZERO_BLOCK;
+
+  // One coherent parameter set per block
+  const int32_t fbk   = fbkQ15;
+  const int32_t coef  = toneQ15;
+  const uint32_t inc  = lfoInc;
+  const int32_t depth = depthQ12;
+
+  // Glide: delay moves linearly from start to end across the block
+  const int32_t start = current;
+  int32_t delta = target - start;
+  const int32_t glide = GLIDE_MAX << FRAC_BITS;
+  if (delta > glide) delta = glide;
+  else if (delta < -glide) delta = -glide;
+  const int32_t step = delta / BLOCK_SAMPLES;
+  const int32_t end = start + step * BLOCK_SAMPLES;
+  current = end;
+
+  // Read window covering every tap of this block (+1 for interpolation)
+  const int32_t lo = (start < end ? start : end) >> FRAC_BITS;
+  const int32_t hi = ((start > end ? start : end) + depth) >> FRAC_BITS;
+  const int32_t far = hi + 1;                         // oldest sample needed
+  const int span = BLOCK_SAMPLES + (far - lo) + 1;
+  int16_t window[BLOCK_SAMPLES + GLIDE_MAX + DEPTH_MAX + 4];
+  copyOut((writeIndex + len - (uint32_t)far) % len, window, span);
+
+  int16_t next[BLOCK_SAMPLES];
+  int32_t lp = lowpass;
+  uint32_t phase = lfoPhase;
+  int32_t d = start;
+  for (int i = 0; i < BLOCK_SAMPLES; i++) {
+    const uint32_t tri = (phase & 0x80000000u) ? ~phase : phase;   // 0 .. 2^31-1
+    const int32_t mod = (int32_t)(((int64_t)tri * depth) >> 31);
+    const int32_t rel = ((i + far) << FRAC_BITS) - (d + mod);     // >= 0 by construction
+    const int16_t* s = window + (rel >> FRAC_BITS);
+    const int32_t frac = rel & ((1 << FRAC_BITS) - 1);
+    const int32_t v = s[0] + (((s[1] - s[0]) * frac) >> FRAC_BITS);
+
+    out[i] = (int16_t)v;
+    lp += ((v - lp) * coef) >> 15;
+    next[i] = (int16_t)ssat16(in[i] + ((lp * fbk) >> 15));
+
+    phase += inc;
+    d += step;
+  }
+  lowpass = lp;
+  lfoPhase = phase;
+
+  copyIn(writeIndex, next, BLOCK_SAMPLES);
+  writeIndex += BLOCK_SAMPLES;
+  if (writeIndex >= len) writeIndex -= len;
+}
+
+} // namespace vox
@@ -0,0 +1,80 @@
+// VOX EFX - modulated digital delay with a filtered feedback loop
+// - Ring buffer in caller-supplied memory (a static pool on the Teensy, sized
+//   by VOX_DELAY_MAX_MS and placed in DMAMEM or PSRAM), so long delays never
+//   touch AudioMemory blocks
+// - Per block: the read window is copied out of the ring and the new block is
+//   written back in at most two memcpy spans each; the per-sample loop works
+//   on linear scratch with no wrap checks
+// - Delay time glides toward its target (at most GLIDE_MAX samples per block),
+//   and a triangle LFO adds 0..depth of modulation; reads are interpolated
+// - Feedback path: one-pole low-pass (tone) then Q15 feedback gain
+// - Setters are single 32-bit stores, safe from loop() while the ISR runs
+
+#pragma once
+
+#include "vox_block.h"
+
+// Longest delay the pool has room for, per channel
+#ifndef VOX_DELAY_MAX_MS
+#define VOX_DELAY_MAX_MS 1000
+#endif
+
+// Q12 sample positions must fit an int32
+static_assert(VOX_DELAY_MAX_MS <= 11000, "VOX_DELAY_MAX_MS: at most 11 s per channel");
+
+namespace vox {
+
+class Delay {
+public:
+  static const int FRAC_BITS = 12;                    // delay times are Q12 samples
+  static const int GLIDE_MAX = BLOCK_SAMPLES / 4;     // samples of delay change per block
+  static const int DEPTH_MAX = 221;                   // ~5 ms of modulation
+  // Reads must finish before the block is written back: one block + interpolation
+  static const int MIN_SAMPLES = BLOCK_SAMPLES + 2;
+
+  // Pool samples needed per channel for maxMs of delay (incl. modulation)
+  static constexpr uint32_t poolSamples(uint32_t maxMs) {
+    return (uint32_t)((uint64_t)maxMs * 44100u / 1000u) + DEPTH_MAX + BLOCK_SAMPLES + 4;
+  }
+
+  // mem is cleared here; it must outlive the Delay
+  void begin(int16_t* mem, uint32_t samples);
+
+  uint32_t maxDelaySamples() const { return len > GUARD ? len - GUARD : 0; }
+
+  void time(float ms);             // target delay, glides there
+  void timeSamples(uint32_t n);
+  void feedback(float n);          // 0.0 .. 0.98
+  void tone(float hz);             // feedback low-pass cutoff
+  void modulation(float rateHz, float depthMs);
+
+  // Jump to the target delay without gliding (e.g. while muted)
+  void snap() { current = target; }
+
+  float timeMs() const { return (float)(target >> FRAC_BITS) * 1000.0f / SAMPLE_RATE; }
+
+  // in may be nullptr (silence in, the repeats keep going); out = delayed signal only
+  void update(const int16_t* in, int16_t* out);
+
+private:
+  static const uint32_t GUARD = BLOCK_SAMPLES + DEPTH_MAX + 4;
+
+  void copyOut(uint32_t start, int16_t* dst, int n) const;
+  void copyIn(uint32_t start, const int16_t* src, int n);
+
+  int16_t* buf = nullptr;
+  uint32_t len = 0;
+  uint32_t writeIndex = 0;
+
+  int32_t  current = 0;                  // Q12, glide state (ISR only)
+  int32_t  lowpass = 0;                  // tone filter state (ISR only)
+  uint32_t lfoPhase = 0;                 // ISR only
+
+  volatile int32_t  target = 0;          // Q12 samples
+  volatile int32_t  fbkQ15 = 0;
+  volatile int32_t  toneQ15 = 32767;
+  volatile uint32_t lfoInc = 0;          // phase step per sample
+  volatile int32_t  depthQ12 = 0;
+};
+
+} // namespace vox
@@ -0,0 +1,215 @@
+// VOX EFX - look-ahead dynamics (see vox_dynamics.h)
+
+#include "vox_dynamics.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace vox {
+
+// log2(1 + i/128) in Q10
+static const uint16_t LOG2_FRAC[128] = {
+  0, 11, 23, 34, 45, 57, 68, 79, 90, 100, 111, 122, 132, 143, 153, 164,
+  174, 184, 194, 204, 214, 224, 234, 244, 254, 264, 273, 283, 292, 302, 311, 320,
+  330, 339, 348, 357, 366, 375, 384, 393, 402, 411, 419, 428, 436, 445, 454, 462,
+  470, 479, 487, 495, 504, 512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 591,
+  599, 607, 614, 622, 629, 637, 644, 652, 659, 667, 674, 681, 689, 696, 703, 710,
+  717, 724, 731, 738, 745, 752, 759, 766, 773, 780, 787, 793, 800, 807, 813, 820,
+  827, 833, 840, 846, 853, 859, 866, 872, 879, 885, 891, 898, 904, 910, 916, 922,
+  929, 935, 941, 947, 953, 959, 965, 971, 977, 983, 989, 995, 1001, 1007, 1012, 1018,
+};
+
+// 2^(i/256) in Q15
+static const uint16_t EXP2_FRAC[256] = {
+  32768, 32857, 32946, 33035, 33125, 33215, 33305, 33395, 33486, 33576, 33667, 33759,
+  33850, 33942, 34034, 34126, 34219, 34312, 34405, 34498, 34591, 34685, 34779, 34874,
+  34968, 35063, 35158, 35253, 35349, 35445, 35541, 35637, 35734, 35831, 35928, 36025,
+  36123, 36221, 36319, 36417, 36516, 36615, 36715, 36814, 36914, 37014, 37114, 37215,
+  37316, 37417, 37518, 37620, 37722, 37824, 37927, 38030, 38133, 38236, 38340, 38444,
+  38548, 38653, 38757, 38863, 38968, 39074, 39180, 39286, 39392, 39499, 39606, 39714,
+  39821, 39929, 40037, 40146, 40255, 40364, 40473, 40583, 40693, 40804, 40914, 41025,
+  41136, 41248, 41360, 41472, 41584, 41697, 41810, 41923, 42037, 42151, 42265, 42380,
+  42495, 42610, 42726, 42841, 42958, 43074, 43191, 43308, 43425, 43543, 43661, 43780,
+  43898, 44017, 44137, 44256, 44376, 44497, 44617, 44738, 44859, 44981, 45103, 45225,
+  45348, 45471, 45594, 45718, 45842, 45966, 46091, 46216, 46341, 46467, 46593, 46719,
+  46846, 46973, 47100, 47228, 47356, 47484, 47613, 47742, 47871, 48001, 48131, 48262,
+  48393, 48524, 48655, 48787, 48920, 49052, 49185, 49319, 49452, 49586, 49721, 49856,
+  49991, 50126, 50262, 50399, 50535, 50672, 50810, 50947, 51085, 51224, 51363, 51502,
+  51642, 51782, 51922, 52063, 52204, 52346, 52488, 52630, 52773, 52916, 53059, 53203,
+  53347, 53492, 53637, 53782, 53928, 54074, 54221, 54368, 54515, 54663, 54811, 54960,
+  55109, 55258, 55408, 55558, 55709, 55860, 56012, 56163, 56316, 56468, 56622, 56775,
+  56929, 57083, 57238, 57393, 57549, 57705, 57861, 58018, 58176, 58333, 58491, 58650,
+  58809, 58968, 59128, 59289, 59449, 59611, 59772, 59934, 60097, 60260, 60423, 60587,
+  60751, 60916, 61081, 61247, 61413, 61579, 61746, 61914, 62081, 62250, 62419, 62588,
+  62757, 62928, 63098, 63269, 63441, 63613, 63785, 63958, 64132, 64306, 64480, 64655,
+  64830, 65006, 65182, 65359,
+};
+
+static const float DB_PER_OCTAVE = 6.0206f;
+static const int32_t GAIN_MIN = -16 * Dynamics::LOG_ONE;   // ~-96 dB
+static const int32_t GAIN_MAX = 4 * Dynamics::LOG_ONE;     // ~+24 dB
+
+static inline int32_t dbToLog2(float db) {
+  return (int32_t)lroundf(db / DB_PER_OCTAVE * Dynamics::LOG_ONE);
+}
+
+int32_t Dynamics::levelLog2(int32_t a) {
+  if (a <= 0) return GAIN_MIN;
+  const int e = 31 - __builtin_clz((uint32_t)a);                   // 0..15
+  const int idx = (e >= 7 ? (a >> (e - 7)) : (a << (7 - e))) & 127;
+  return (e - 15) * LOG_ONE + LOG2_FRAC[idx];
+}
+
+uint32_t Dynamics::gainQ16(int32_t g) {
+  if (g < GAIN_MIN) g = GAIN_MIN;
+  else if (g > GAIN_MAX) g = GAIN_MAX;
+  const int shift = (g >> 10) + 1;                                  // Q15 table -> Q16
+  const uint32_t base = EXP2_FRAC[(g & 1023) >> 2];
+  return shift >= 0 ? base << shift : base >> -shift;
+}
+
+int32_t Dynamics::smooth(int32_t state, int32_t targetQ10, int32_t coefQ31) {
+  const int64_t diff = (int64_t)targetQ10 * 65536 - state;
+  return state + (int32_t)((diff * coefQ31) >> 31);
+}
+
+// One-pole coefficient reaching ~63% in ms; 0 ms = instant
+int32_t Dynamics::coefForMs(float ms) {
+  if (ms <= 0.0f) return 0x7FFFFFFF;
+  const float a = 1.0f - expf(-1000.0f / (ms * SAMPLE_RATE));
+  return (int32_t)(a * 2147483647.0f);
+}
+
+Dynamics::Dynamics() {
+  memset(history, 0, sizeof(history));
+  gate(-70.0f, 0.0f);
+  gateTimes(1.0f, 150.0f);
+  compressor(0.0f, 1.0f, 0.0f);
+  compressorTimes(5.0f, 120.0f);
+  limiter(0.0f, 50.0f);
+  lookahead(0.0f);
+}
+
+void Dynamics::gate(float thresholdDb, float rangeDb) {
+  if (rangeDb < 0.0f) rangeDb = 0.0f;
+  else if (rangeDb > 90.0f) rangeDb = 90.0f;
+  gateThr = dbToLog2(thresholdDb);
+  gateRange = dbToLog2(rangeDb);
+}
+
+void Dynamics::gateTimes(float openMs, float closeMs) {
+  gateOpen = coefForMs(openMs);
+  gateClose = coefForMs(closeMs);
+}
+
+void Dynamics::compressor(float thresholdDb, float ratio, float makeupDb) {
+  if (ratio < 1.0f) ratio = 1.0f;
+  if (thresholdDb > 0.0f) thresholdDb = 0.0f;
+  if (makeupDb > 24.0f) makeupDb = 24.0f;
+  else if (makeupDb < 0.0f) makeupDb = 0.0f;
+  compThr = dbToLog2(thresholdDb);
+  compSlope = (int32_t)((1.0f - 1.0f / ratio) * 32767.0f);
+  makeup = dbToLog2(makeupDb);
+}
+
+void Dynamics::compressorTimes(float attackMs, float releaseMs) {
+  compAttack = coefForMs(attackMs);
+  compRelease = coefForMs(releaseMs);
+}
+
+void Dynamics::limiter(float ceilingDb, float releaseMs) {
+  if (ceilingDb > 0.0f) ceilingDb = 0.0f;
+  else if (ceilingDb < -40.0f) ceilingDb = -40.0f;
+  ceiling = dbToLog2(ceilingDb);
+  ceilingLin = (int32_t)(32767.0f * powf(10.0f, ceilingDb / 20.0f));
+  limRelease = coefForMs(releaseMs);
+}
+
+void Dynamics::lookahead(float ms) {
+  int n = (int)(ms * (SAMPLE_RATE / 1000.0f) + 0.5f);
+  if (n < 0) n = 0;
+  else if (n > LOOKAHEAD_MAX) n = LOOKAHEAD_MAX;
+  delaySamples = n;
+}
+
+int32_t Dynamics::takeGainReduction() {
+  const int32_t g = minGain;
+  minGain = 0;
+  return g;
+}
+
+float Dynamics::gainReductionDb(int32_t raw) { return (float)raw * (DB_PER_OCTAVE / LOG_ONE); }
+
+// history = [LOOKAHEAD_MAX previous samples | this block]
+void Dynamics::idle(const int16_t* in) {
+  memcpy(history + LOOKAHEAD_MAX, in ? in : ZERO_BLOCK, BLOCK_SAMPLES * sizeof(int16_t));
+  memmove(history, history + BLOCK_SAMPLES, LOOKAHEAD_MAX * sizeof(int16_t));
+}
+
+void Dynamics::update(const int16_t* in, int16_t* out) {
+  if (!in) in = ZERO_BLOCK;
+  if (bypassed) {
+    memcpy(out, in, BLOCK_SAMPLES * sizeof(int16_t));
+    idle(in);
+    return;
+  }
+  memcpy(history + LOOKAHEAD_MAX, in, BLOCK_SAMPLES * sizeof(int16_t));
+
+  // One coherent parameter set per block
+  const int32_t n       = delaySamples;
+  const int32_t gThr    = gateThr,    gRange = gateRange;
+  const int32_t gOpen   = gateOpen,   gClose = gateClose;
+  const int32_t cThr    = compThr,    slope  = compSlope;
+  const int32_t cAtk    = compAttack, cRel   = compRelease;
+  const int32_t mkup    = makeup;
+  const int32_t ceil    = ceiling,    lRel   = limRelease;
+  const int32_t ceilLin = ceilingLin;
+
+  int32_t gs = gateState, cs = compState, ls = limState, hold = limHold;
+  int32_t lowest = minGain;
+  const int16_t* now = history + LOOKAHEAD_MAX;
+  const int16_t* late = now - n;
+
+  for (int i = 0; i < BLOCK_SAMPLES; i++) {
+    const int32_t x = now[i];
+    const int32_t level = levelLog2(x < 0 ? -x : x);
+
+    // Gate: full range below threshold; opens fast, closes slowly
+    const int32_t gt = level < gThr ? -gRange : 0;
+    gs = smooth(gs, gt, gt > (gs >> 16) ? gOpen : gClose);
+
+    // Compressor: (level - threshold) * (1 - 1/ratio) of reduction above threshold
+    const int32_t over = level - cThr;
+    const int32_t ct = over > 0 ? -((over * slope) >> 15) : 0;
+    cs = smooth(cs, ct, ct < (cs >> 16) ? cAtk : cRel);
+
+    const int32_t pre = (gs >> 16) + (cs >> 16) + mkup;
+
+    // Limiter: instant attack, held for the look-ahead so the gain is
+    // already down when this sample reaches the output
+    int32_t need = ceil - (level + pre);
+    if (need > 0) need = 0;
+    if (need <= (ls >> 16)) {
+      ls = need * 65536;
+      hold = n;
+    } else if (hold > 0) {
+      hold--;
+    } else {
+      ls = smooth(ls, need, lRel);
+    }
+
+    const int32_t reduction = (gs >> 16) + (cs >> 16) + (ls >> 16);
+    if (reduction < lowest) lowest = reduction;
+
+    const int32_t y = (int32_t)(((int64_t)late[i] * gainQ16(reduction + mkup)) >> 16);
+    out[i] = (int16_t)(y > ceilLin ? ceilLin : (y < -ceilLin ? -ceilLin : y));
+  }
+
+  gateState = gs; compState = cs; limState = ls; limHold = hold;
+  minGain = lowest;
+
+  // Keep the newest LOOKAHEAD_MAX samples at the front
+  memmove(history, history + BLOCK_SAMPLES, LOOKAHEAD_MAX * sizeof(int16_t));
+}
+
+} // namespace vox
@@ -0,0 +1,83 @@
+// VOX EFX - look-ahead dynamics: gate -> compressor -> brickwall limiter
+// - Gain computer works in the log domain (Q10 octaves, 1/1024 of 6.02 dB):
+//   |x| -> log2 via CLZ + a 128-entry table, gain -> linear via a 256-entry
+//   exp2 table; no log10f/powf per sample
+// - Gains are smoothed in the log domain (attack/release one-poles), the
+//   limiter with instant attack and a hold as long as the look-ahead
+// - Look-ahead 0..5 ms: the detector sees the input now, the gain is applied
+//   to the input delayed through a small linear history buffer
+// - The output is finally clamped to the ceiling, so it never exceeds it
+// - Setters convert dB/ms to fixed point here, outside the ISR; each field is
+//   one 32-bit store
+
+#pragma once
+
+#include "vox_block.h"
+
+namespace vox {
+
+class Dynamics {
+public:
+  static const int LOOKAHEAD_MAX = 224;     // samples, a little over 5 ms
+  static const int LOG_ONE = 1024;          // one octave in Q10
+
+  Dynamics();
+
+  void bypass(bool b) { bypassed = b; }
+  bool isBypassed() const { return bypassed; }
+
+  void gate(float thresholdDb, float rangeDb);            // rangeDb 0 = gate off
+  void gateTimes(float openMs, float closeMs);
+  void compressor(float thresholdDb, float ratio, float makeupDb);
+  void compressorTimes(float attackMs, float releaseMs);
+  void limiter(float ceilingDb, float releaseMs);
+  void lookahead(float ms);
+
+  // Deepest gain reduction since the last call, in dB (<= 0); for meters.
+  // update() (the audio ISR) lowers the same value: on the Teensy the raw
+  // read-and-reset must run with interrupts off (AudioEffectVoxDynamics)
+  float takeGainReductionDb() { return gainReductionDb(takeGainReduction()); }
+  int32_t takeGainReduction();                            // raw, Q10 log2
+  static float gainReductionDb(int32_t raw);
+
+  // in may be nullptr (silence)
+  void update(const int16_t* in, int16_t* out);
+
+  // Bypassed block: keep the look-ahead history current without processing,
+  // so re-enabling doesn't replay stale audio
+  void idle(const int16_t* in);
+
+  // Q10 octave helpers (exposed for tests)
+  static int32_t levelLog2(int32_t absSample);     // |x| 0..32768 -> Q10, 0 dBFS = 0
+  static uint32_t gainQ16(int32_t log2Q10);         // Q10 octaves -> linear Q16
+
+private:
+  // Smoothing state is Q26 (Q10 << 16) so slow releases don't stall
+  static int32_t smooth(int32_t state, int32_t targetQ10, int32_t coefQ31);
+  static int32_t coefForMs(float ms);
+
+  int16_t history[LOOKAHEAD_MAX + BLOCK_SAMPLES];
+
+  int32_t compState = 0;
+  int32_t gateState = 0;
+  int32_t limState  = 0;                // <= 0
+  int32_t limHold   = 0;
+  volatile int32_t minGain = 0;         // Q10; update() lowers it, takeGainReduction() resets it
+
+  volatile bool    bypassed = false;
+  volatile int32_t gateThr = -16 * LOG_ONE;
+  volatile int32_t gateRange = 0;
+  volatile int32_t gateOpen = 0;        // smoothing coefficients are Q31
+  volatile int32_t gateClose = 0;
+  volatile int32_t compThr = 0;
+  volatile int32_t compSlope = 0;       // Q15, 1 - 1/ratio
+  volatile int32_t makeup = 0;
+  volatile int32_t compAttack = 0;
+  volatile int32_t compRelease = 0;
+  volatile int32_t ceiling = 0;         // Q10
+  volatile int32_t ceilingLin = 32767;
+  volatile int32_t limRelease = 0;
+  volatile int32_t delaySamples = 0;
+};
+
+} // namespace vox
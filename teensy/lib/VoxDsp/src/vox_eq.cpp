@@ -0,0 +1,154 @@
+// VOX EFX - 6-band parametric EQ (see vox_eq.h)
+
+#include "vox_eq.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace vox {
+
+Equalizer::Equalizer() : ready(2) {
+  for (int i = 0; i < BANDS; i++) {
+    bands[i] = EqBand{ EqType::Off, 1000.0f, 0.0f, 0.707f };
+    active[i] = false;
+  }
+  memset(set, 0, sizeof(set));
+  reset();
+}
+
+void Equalizer::reset() {
+  for (int i = 0; i < BANDS; i++) z1[i] = z2[i] = 0.0f;
+}
+
+// RBJ Audio EQ Cookbook
+bool Equalizer::design(const EqBand& b, Biquad& out) {
+  if (b.type == EqType::Off) return false;
+  const bool shaped = (b.type == EqType::LowShelf || b.type == EqType::HighShelf || b.type == EqType::Peak);
+  if (shaped && fabsf(b.gainDb) < 0.01f) return false;
+
+  float f = b.freqHz;
+  if (f < 10.0f) f = 10.0f;
+  else if (f > SAMPLE_RATE * 0.45f) f = SAMPLE_RATE * 0.45f;
+  const float q = b.q < 0.1f ? 0.1f : b.q;
+
+  const float w0 = 2.0f * 3.14159265f * f / SAMPLE_RATE;
+  const float cw = cosf(w0);
+  const float alpha = sinf(w0) / (2.0f * q);
+  const float A = powf(10.0f, b.gainDb / 40.0f);
+  float b0, b1, b2, a0, a1, a2;
+
+  switch (b.type) {
+    case EqType::Peak:
+      b0 = 1.0f + alpha * A;  b1 = -2.0f * cw;  b2 = 1.0f - alpha * A;
+      a0 = 1.0f + alpha / A;  a1 = -2.0f * cw;  a2 = 1.0f - alpha / A;
+      break;
+    case EqType::LowShelf: {
+      const float s = 2.0f * sqrtf(A) * alpha;
+      b0 = A * ((A + 1.0f) - (A - 1.0f) * cw + s);
+      b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cw);
+      b2 = A * ((A + 1.0f) - (A - 1.0f) * cw - s);
+      a0 = (A + 1.0f) + (A - 1.0f) * cw + s;
+      a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cw);
+      a2 = (A + 1.0f) + (A - 1.0f) * cw - s;
+      break;
+    }
+    case EqType::HighShelf: {
+      const float s = 2.0f * sqrtf(A) * alpha;
+      b0 = A * ((A + 1.0f) + (A - 1.0f) * cw + s);
+      b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cw);
+      b2 = A * ((A + 1.0f) + (A - 1.0f) * cw - s);
+      a0 = (A + 1.0f) - (A - 1.0f) * cw + s;
+      a1 = 2.0f * ((A - 1.0f) - (A + 1.0f) * cw);
+      a2 = (A + 1.0f) - (A - 1.0f) * cw - s;
+      break;
+    }
+    case EqType::HighPass:
+      b0 = (1.0f + cw) * 0.5f;  b1 = -(1.0f + cw);  b2 = b0;
+      a0 = 1.0f + alpha;        a1 = -2.0f * cw;    a2 = 1.0f - alpha;
+      break;
+    case EqType::LowPass:
+      b0 = (1.0f - cw) * 0.5f;  b1 = 1.0f - cw;     b2 = b0;
+      a0 = 1.0f + alpha;        a1 = -2.0f * cw;    a2 = 1.0f - alpha;
+      break;
+    default:
+      return false;
+  }
+
+  out.b0 = b0 / a0;
+  out.b1 = b1 / a0;
+  out.b2 = b2 / a0;
+  out.a1 = a1 / a0;
+  out.a2 = a2 / a0;
+  return true;
+}
+
+void Equalizer::setBand(int i, const EqBand& b) {
+  if (i < 0 || i >= BANDS) return;
+  bands[i] = b;
+  active[i] = design(b, designed[i]);
+  publish();
+}
+
+void Equalizer::publish() {
+  CoeffSet& s = set[back];
+  s.count = 0;
+  for (int i = 0; i < BANDS; i++) {
+    if (!active[i]) continue;
+    s.bq[s.count] = designed[i];
+    s.slot[s.count] = (uint8_t)i;
+    s.count++;
+  }
+
+  // Hand the finished set over; take back whatever was waiting (read or not)
+  back = ready.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+bool Equalizer::passthrough() {
+  // Block boundary: switch to the newest set if one was published
+  if (ready.load(std::memory_order_acquire) & FRESH) {
+    front = ready.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+  }
+  if (set[front].count != 0) return false;
+  reset();                               // bands come back from silence
+  return true;
+}
+
+void Equalizer::update(const int16_t* in, int16_t* out) {
+  if (!passthrough()) {
+    process(in, out);
+    return;
+  }
+  memcpy(out, in ? in : ZERO_BLOCK, BLOCK_SAMPLES * sizeof(int16_t));
+}
+
+void Equalizer::process(const int16_t* in, int16_t* out) {
+  if (!in) in = ZERO_BLOCK;
+  const CoeffSet& s = set[front];
+
+  float x[BLOCK_SAMPLES];
+  for (int i = 0; i < BLOCK_SAMPLES; i++) x[i] = (float)in[i];
+
+  // Band-outer: each band's coefficients and state stay in registers for
+  // the whole block
+  for (int k = 0; k < s.count; k++) {
+    const Biquad c = s.bq[k];
+    const int slot = s.slot[k];
+    float s1 = z1[slot], s2 = z2[slot];
+    for (int i = 0; i < BLOCK_SAMPLES; i++) {
+      const float v = x[i];
+      const float y = c.b0 * v + s1;
+      s1 = c.b1 * v - c.a1 * y + s2;
+      s2 = c.b2 * v - c.a2 * y;
+      x[i] = y;
+    }
+    z1[slot] = s1;
+    z2[slot] = s2;
+  }
+
+  for (int i = 0; i < BLOCK_SAMPLES; i++) {
+    const float y = x[i];
+    out[i] = y >= 32767.0f ? 32767 : (y <= -32768.0f ? -32768 : (int16_t)y);
+  }
+}
+
+} // namespace vox
@@ -0,0 +1,85 @@
+// VOX EFX - 6-band parametric EQ (cascaded biquads, Direct Form II transposed)
+// - Band types: low/high shelf, peak, high-pass, low-pass (RBJ cookbook)
+// - Coefficients are designed in setBand() on the caller's side (loop()),
+//   never in the ISR, and handed over through a lock-free triple buffer:
+//   passthrough() picks up the newest complete set at the start of a block,
+//   and process() runs that set, so a block always runs one coherent set and setBand() never waits on the ISR
+// - Bands that are Off, or shelves/peaks at 0 dB, are left out of the cascade;
+//   with none active the block passes through bit-exact
+// - Filter state is kept per band slot, so enabling one band doesn't
+//   disturb the others
+
+#pragma once
+
+#include <atomic>
+
+#include "vox_block.h"
+
+namespace vox {
+
+enum class EqType : uint8_t { Off, LowShelf, HighShelf, Peak, HighPass, LowPass };
+
+struct EqBand {
+  EqType type;
+  float  freqHz;
+  float  gainDb;       // shelves and peaks
+  float  q;            // peak bandwidth / shelf slope / HPF-LPF resonance
+};
+
+class Equalizer {
+public:
+  static const int BANDS = 6;
+
+  Equalizer();
+
+  // loop() side: designs band i and publishes the whole set
+  void setBand(int i, const EqBand& b);
+  const EqBand& band(int i) const { return bands[i]; }
+
+  // ISR side, once per block before process(): switches to the newest
+  // published set and returns true when it has no active band, so the
+  // caller can forward the block as is
+  bool passthrough();
+
+  // ISR side, after passthrough() returned false: filters with the set that
+  // call switched to, without looking for a newer one. in may be nullptr
+  // (silence)
+  void process(const int16_t* in, int16_t* out);
+
+  // passthrough() and then process() or a copy, for callers that always
+  // want an output block
+  void update(const int16_t* in, int16_t* out);
+
+  // Clear the filter state (e.g. after a bypass)
+  void reset();
+
+private:
+  struct Biquad {
+    float b0, b1, b2, a1, a2;            // a0 normalised to 1
+  };
+  struct CoeffSet {
+    Biquad  bq[BANDS];
+    uint8_t slot[BANDS];                 // active band slots, in order
+    uint8_t count;
+  };
+
+  static bool design(const EqBand& b, Biquad& out);   // false = identity
+  void publish();
+
+  // Writer side (loop)
+  EqBand  bands[BANDS];
+  Biquad  designed[BANDS];
+  bool    active[BANDS];
+
+  // Triple buffer: the ISR owns set[front], the writer set[back];
+  // ready holds the newest published index plus FRESH when unread
+  static const uint8_t FRESH = 0x80;
+  CoeffSet set[3];
+  uint8_t  front = 0;                    // ISR only
+  uint8_t  back = 1;                     // writer only
+  std::atomic<uint8_t> ready;
+
+  float z1[BANDS], z2[BANDS];            // DF2T state per band slot (ISR only)
+};
+
+} // namespace vox
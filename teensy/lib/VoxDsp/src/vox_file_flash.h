@@ -0,0 +1,117 @@
+// VOX EFX - NOR flash in a host file, for LogStore tests (host only)
+// - Same interface and rules as src/flash_store.h: program() can only
+//   clear bits, erase() sets a whole sector to 0xFF
+// - cutAfter(n, seed) simulates power loss: the n-th program()/erase()
+//   from now is torn (a program lands only partly and its last byte is
+//   half-programmed; an erase leaves random bytes) and every later one is
+//   lost. Reopening the file is the reboot
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace vox {
+
+template <uint32_t BYTES, uint32_t SECTOR_BYTES = 4096, uint32_t PAGE_BYTES = 256>
+class FileFlash {
+public:
+  static const uint32_t SIZE   = BYTES;
+  static const uint32_t SECTOR = SECTOR_BYTES;
+  static const uint32_t PAGE   = PAGE_BYTES;
+
+  ~FileFlash() { close(); }
+
+  // Creates an erased flash when the file doesn't exist
+  bool open(const char* path) {
+    close();
+    f = fopen(path, "r+b");
+    if (!f) {
+      f = fopen(path, "w+b");
+      if (!f) return false;
+      for (uint32_t i = 0; i < SIZE; i++) fputc(0xFF, f);
+    }
+    cut = 0;
+    dead = false;
+    return true;
+  }
+
+  void close() {
+    if (f) fclose(f);
+    f = nullptr;
+  }
+
+  void cutAfter(uint32_t ops, uint32_t seed) {
+    cut = ops;
+    rng = seed ? seed : 1;
+  }
+
+  bool powerLost() const { return dead; }
+  uint32_t programs = 0;
+  uint32_t erases = 0;
+
+  void read(uint32_t off, void* dst, uint32_t n) const {
+    fseek(f, (long)off, SEEK_SET);
+    if (fread(dst, 1, n, f) != n) {
+      for (uint32_t i = 0; i < n; i++) ((uint8_t*)dst)[i] = 0xFF;
+    }
+  }
+
+  void program(uint32_t off, const void* src, uint32_t n) {
+    if (dead || off % PAGE + n > PAGE) return;   // real parts wrap inside the page
+    programs++;
+    uint32_t keep = n;
+    uint8_t lastMask = 0xFF;
+    if (torn()) {
+      keep = next() % (n + 1);
+      lastMask = (uint8_t)next();
+    }
+    uint8_t old[PAGE];
+    read(off, old, n);
+    for (uint32_t i = 0; i < keep; i++) {
+      uint8_t v = ((const uint8_t*)src)[i];
+      if (i + 1 == keep && lastMask != 0xFF) v |= lastMask;   // half-programmed
+      old[i] &= v;
+    }
+    write(off, old, n);
+  }
+
+  void erase(uint32_t off) {
+    if (dead) return;
+    erases++;
+    off -= off % SECTOR;
+    uint8_t s[SECTOR];
+    const bool t = torn();
+    for (uint32_t i = 0; i < SECTOR; i++) s[i] = t ? (uint8_t)next() : 0xFF;
+    write(off, s, SECTOR);
+  }
+
+private:
+  // True for the op the cut lands on; from then on nothing is written
+  bool torn() {
+    if (!cut) return false;
+    if (--cut) return false;
+    dead = true;
+    return true;
+  }
+
+  uint32_t next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+
+  void write(uint32_t off, const uint8_t* p, uint32_t n) {
+    fseek(f, (long)off, SEEK_SET);
+    fwrite(p, 1, n, f);
+    fflush(f);
+  }
+
+  FILE*    f = nullptr;
+  uint32_t cut = 0;
+  uint32_t rng = 1;
+  bool     dead = false;
+};
+
+} // namespace vox
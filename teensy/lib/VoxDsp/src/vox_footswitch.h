@@ -0,0 +1,54 @@
+// VOX EFX - footswitch press/hold state machine (debounce included)
+// - update() is fed the raw switch level every loop(); at most one event
+//   per call:
+//     PRESS  debounced press, stamped with its time (tap tempo timing)
+//     HOLD   still down holdMs after the press, once per press
+//     TAP    released before HOLD fired: the short-press action
+//   so a hold never also runs the short-press action
+// - Every accepted edge (press or release) locks out further edges for
+//   debounceMs; an edge that comes inside the lockout is taken once it
+//   ends if the level still differs
+// - Pure logic on millis() timestamps, shared by the firmware and host tests
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vox {
+
+class Footswitch {
+public:
+  enum Event : uint8_t { NONE, PRESS, HOLD, TAP };
+
+  explicit Footswitch(uint32_t holdMs, uint32_t debounceMs = 50) : hold(holdMs), debounce(debounceMs) {}
+
+  Event update(bool isDown, uint32_t nowMs) {
+    if (isDown != down && nowMs - edgeMs >= debounce) {
+      down = isDown;
+      edgeMs = nowMs;
+      if (down) {
+        pressMs = nowMs;
+        held = false;
+        return PRESS;
+      }
+      return held ? NONE : TAP;
+    }
+    if (down && !held && nowMs - pressMs >= hold) {
+      held = true;
+      return HOLD;
+    }
+    return NONE;
+  }
+
+  bool     isDown() const    { return down; }
+  uint32_t pressedMs() const { return pressMs; }   // time of the last PRESS
+
+private:
+  uint32_t hold, debounce;
+  uint32_t edgeMs = 0;
+  uint32_t pressMs = 0;
+  bool     down = false;
+  bool     held = false;
+};
+
+} // namespace vox
@@ -0,0 +1,80 @@
+// VOX EFX - mono Freeverb kernel (see vox_freeverb.h)
+
+#include "vox_freeverb.h"
+
+#include <string.h>
+
+namespace vox {
+
+#define VOX_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+void Freeverb::reset() {
+  memset(comb1buf, 0, sizeof(comb1buf));
+  memset(comb2buf, 0, sizeof(comb2buf));
+  memset(comb3buf, 0, sizeof(comb3buf));
+  memset(comb4buf, 0, sizeof(comb4buf));
+  memset(comb5buf, 0, sizeof(comb5buf));
+  memset(comb6buf, 0, sizeof(comb6buf));
+  memset(comb7buf, 0, sizeof(comb7buf));
+  memset(comb8buf, 0, sizeof(comb8buf));
+  comb1index = comb2index = comb3index = comb4index = 0;
+  comb5index = comb6index = comb7index = comb8index = 0;
+  comb1filter = comb2filter = comb3filter = comb4filter = 0;
+  comb5filter = comb6filter = comb7filter = comb8filter = 0;
+  combdamp1 = 6553;
+  combdamp2 = 26215;
+  combfeedback = 27524;
+
+  memset(allpass1buf, 0, sizeof(allpass1buf));
+  memset(allpass2buf, 0, sizeof(allpass2buf));
+  memset(allpass3buf, 0, sizeof(allpass3buf));
+  memset(allpass4buf, 0, sizeof(allpass4buf));
+  allpass1index = allpass2index = allpass3index = allpass4index = 0;
+}
+
+static inline int16_t combStep(int16_t* buf, uint16_t len, uint16_t& index, int16_t& filter,
+                               int16_t input, int32_t damp1, int32_t damp2, int32_t feedback) {
+  int16_t bufout = buf[index];
+  filter = sat16(bufout * damp2 + filter * damp1, 15);
+  buf[index] = sat16(input + sat16(filter * feedback, 15), 0);
+  if (++index >= len) index = 0;
+  return bufout;
+}
+
+static inline int16_t allpassStep(int16_t* buf, uint16_t len, uint16_t& index, int16_t input) {
+  int16_t bufout = buf[index];
+  buf[index] = (int16_t)(input + (bufout >> 1));
+  if (++index >= len) index = 0;
+  return sat16(bufout - input, 1);
+}
+
+void Freeverb::update(const int16_t* in, int16_t* out) {
+  const int32_t d1 = combdamp1, d2 = combdamp2, fb = combfeedback;
+
+  for (int i = 0; i < BLOCK_SAMPLES; i++) {
+    int16_t input = in ? sat16(in[i] * 8738, 17) : 0;   // numerical headroom
+    int32_t sum = 0;
+
+    sum += combStep(comb1buf, VOX_LEN(comb1buf), comb1index, comb1filter, input, d1, d2, fb);
+    sum += combStep(comb2buf, VOX_LEN(comb2buf), comb2index, comb2filter, input, d1, d2, fb);
+    sum += combStep(comb3buf, VOX_LEN(comb3buf), comb3index, comb3filter, input, d1, d2, fb);
+    sum += combStep(comb4buf, VOX_LEN(comb4buf), comb4index, comb4filter, input, d1, d2, fb);
+    sum += combStep(comb5buf, VOX_LEN(comb5buf), comb5index, comb5filter, input, d1, d2, fb);
+    sum += combStep(comb6buf, VOX_LEN(comb6buf), comb6index, comb6filter, input, d1, d2, fb);
+    sum += combStep(comb7buf, VOX_LEN(comb7buf), comb7index, comb7filter, input, d1, d2, fb);
+    sum += combStep(comb8buf, VOX_LEN(comb8buf), comb8index, comb8filter, input, d1, d2, fb);
+
+    int16_t output = sat16((int32_t)((int64_t)sum * 31457), 17);   // wraps like the M7
+
+    output = allpassStep(allpass1buf, VOX_LEN(allpass1buf), allpass1index, output);
+    output = allpassStep(allpass2buf, VOX_LEN(allpass2buf), allpass2index, output);
+    output = allpassStep(allpass3buf, VOX_LEN(allpass3buf), allpass3index, output);
+    output = allpassStep(allpass4buf, VOX_LEN(allpass4buf), allpass4index, output);
+
+    out[i] = sat16(output * 30, 0);
+  }
+}
+
+#undef VOX_LEN
+
+} // namespace vox
@@ -0,0 +1,60 @@
+// VOX EFX - mono Freeverb kernel
+// - Sample-for-sample port of the Teensy Audio Library's AudioEffectFreeverb
+//   (MIT licence, PJRC), so host renders match what the pedal produces
+// - 8 parallel combs with damping -> 4 series allpasses, Q15 integer math
+
+#pragma once
+
+#include "vox_block.h"
+
+namespace vox {
+
+class Freeverb {
+public:
+  Freeverb() { reset(); }
+
+  void reset();
+
+  // 0.0 .. 1.0 (smaller -> subtle, larger -> bigger tail)
+  void roomsize(float n) {
+    if (n > 1.0f) n = 1.0f;
+    else if (n < 0.0f) n = 0.0f;
+    combfeedback = (int)(n * 9175.04f) + 22937;
+  }
+
+  // 0.0 .. 1.0 (higher = darker/less bright)
+  void damping(float n) {
+    if (n > 1.0f) n = 1.0f;
+    else if (n < 0.0f) n = 0.0f;
+    int x1 = (int)(n * 13107.2f);
+    combdamp1 = x1;
+    combdamp2 = 32768 - x1;
+  }
+
+  // in may be nullptr (treated as silence, the tail keeps ringing)
+  void update(const int16_t* in, int16_t* out);
+
+private:
+  int16_t comb1buf[1116];
+  int16_t comb2buf[1188];
+  int16_t comb3buf[1277];
+  int16_t comb4buf[1356];
+  int16_t comb5buf[1422];
+  int16_t comb6buf[1491];
+  int16_t comb7buf[1557];
+  int16_t comb8buf[1617];
+  uint16_t comb1index, comb2index, comb3index, comb4index;
+  uint16_t comb5index, comb6index, comb7index, comb8index;
+  int16_t comb1filter, comb2filter, comb3filter, comb4filter;
+  int16_t comb5filter, comb6filter, comb7filter, comb8filter;
+  int32_t combdamp1, combdamp2;
+  int32_t combfeedback;
+
+  int16_t allpass1buf[556];
+  int16_t allpass2buf[441];
+  int16_t allpass3buf[341];
+  int16_t allpass4buf[225];
+  uint16_t allpass1index, allpass2index, allpass3index, allpass4index;
+};
+
+} // namespace vox
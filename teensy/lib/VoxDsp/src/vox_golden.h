@@ -0,0 +1,312 @@
+// VOX EFX - golden-audio regression corpus and metrics (host only)
+// - Inputs are generated with integer math only, so every host builds the
+//   same samples: a synthetic voice (sawtooth glottal source with vibrato
+//   through three formant resonators, three vowels), a linear sine sweep
+//   20 Hz -> 16 kHz, a single impulse and silence. The signal stops at
+//   SIGNAL_BLOCKS; the rest is silence so tails are rendered
+// - Each input runs through MonoGraph with one preset's settings
+//   (vox_config.h presetSettings) and is compared with its golden output,
+//   test/golden/<input>_<preset>.s16 (raw mono s16le, BLOCKS blocks), two
+//   ways:
+//     exact:     every sample equal
+//     tolerance: RMS of the difference <= TOL_RMS_DBFS, and the Welch
+//                spectra (2048-point Hann, 50 % overlap) differ by at most
+//                TOL_SPECTRAL_DB in every 1/3-octave band 50 Hz .. 16 kHz
+//                within SPECTRAL_RANGE_DB of the loudest band
+//   A refactor that claims "same output" must pass exact; one that trades
+//   precision for speed (fixed point, reordered sums) must pass tolerance
+// - Goldens are rewritten by the renderer: program --golden test/golden
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "vox_block.h"
+#include "vox_graph.h"
+
+namespace vox {
+namespace golden {
+
+static const int BLOCKS        = 128;                 // ~0.37 s
+static const int SIGNAL_BLOCKS = 96;
+static const int SAMPLES       = BLOCKS * BLOCK_SAMPLES;
+
+static const double TOL_RMS_DBFS      = -70.0;
+static const double TOL_SPECTRAL_DB   = 0.5;
+static const double SPECTRAL_RANGE_DB = 50.0;
+static const double SILENT_DBFS       = -200.0;       // RMS of an all-zero difference
+
+enum Input { VOICE, SWEEP, IMPULSE, SILENCE, INPUTS };
+
+inline const char* inputName(int i) {
+  static const char* const names[INPUTS] = { "voice", "sweep", "impulse", "silence" };
+  return i >= 0 && i < INPUTS ? names[i] : "?";
+}
+
+// ---- corpus ----
+
+// Full-circle phase in, Q15 sine out (parabola with one correction term,
+// within 0.1 % of sin)
+inline int32_t isin(uint32_t phase) {
+  const int32_t x = (int32_t)phase >> 16;                  // -1 .. 1 in Q15
+  const int32_t ax = x < 0 ? -x : x;
+  const int32_t y = (int32_t)(((int64_t)4 * x * (32768 - ax)) >> 15);
+  const int32_t ay = y < 0 ? -y : y;
+  return y + (int32_t)(((int64_t)7373 * ((int32_t)(((int64_t)y * ay) >> 15) - y)) >> 15);
+}
+
+inline int16_t sat16(int32_t v) {
+  return (int16_t)(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+}
+
+// Two-pole resonator, Q14 coefficients
+struct Resonator {
+  int32_t a1, a2;
+  int32_t y1 = 0, y2 = 0;
+
+  int32_t step(int32_t x) {
+    const int32_t y = (int32_t)(((int64_t)a1 * y1 + (int64_t)a2 * y2) >> 14) + x;
+    y2 = y1;
+    y1 = y;
+    return y;
+  }
+};
+
+inline void makeVoice(int16_t* out, int n) {
+  // 2 r cos(w), -r^2 in Q14 for F1..F3 of /a/, /i/, /u/
+  static const int32_t VOWELS[3][3][2] = {
+    { { 32351, -16129 }, { 32000, -16106 }, { 30199, -16015 } },   // 700, 1220, 2600 Hz
+    { { 32529, -16175 }, { 30760, -16106 }, { 29482, -16015 } },   // 300, 2300, 3000 Hz
+    { { 32518, -16175 }, { 32324, -16152 }, { 30521, -16015 } },   //  350, 800, 2400 Hz
+  };
+  const int SYLLABLE = SIGNAL_BLOCKS * BLOCK_SAMPLES / 3;
+  const int ATTACK = 256, RELEASE = 768, GAP = 512;
+  const uint32_t F0_INC = 13634817;                         // 140 Hz
+  const uint32_t VIB_INC = 486958;                          // 5 Hz
+
+  uint32_t phase = 0, vib = 0, noise = 12345;
+  Resonator f[3];
+  for (int i = 0; i < n; i++) {
+    const int syl = i / SYLLABLE;
+    const int pos = i % SYLLABLE;
+    if (syl >= 3) {
+      out[i] = 0;
+      continue;
+    }
+    if (pos == 0) {
+      for (int k = 0; k < 3; k++) {
+        f[k].a1 = VOWELS[syl][k][0];
+        f[k].a2 = VOWELS[syl][k][1];
+      }
+    }
+    const int on = SYLLABLE - GAP;
+    int32_t env = 0;                                        // Q15
+    if (pos < ATTACK) env = pos * 32767 / ATTACK;
+    else if (pos < on - RELEASE) env = 32767;
+    else if (pos < on) env = (on - pos) * 32767 / RELEASE;
+
+    // +/- 3 % vibrato
+    phase += F0_INC + (uint32_t)(((int64_t)F0_INC * 983 * isin(vib)) >> 30);
+    vib += VIB_INC;
+    noise = noise * 1664525u + 1013904223u;
+    const int32_t src = ((int32_t)(phase >> 16) - 32768 + ((int32_t)(noise >> 24) - 128) * 8) * env >> 15;
+
+    const int32_t x = src >> 7;
+    const int32_t y = f[0].step(x) + f[1].step(x >> 1) / 2 + f[2].step(x >> 2) / 4;
+    out[i] = sat16(y >> 4);
+  }
+}
+
+inline void makeSweep(int16_t* out, int n) {
+  const int len = SIGNAL_BLOCKS * BLOCK_SAMPLES;
+  const int64_t INC0 = 1947831, INC1 = 1558264779;         // 20 Hz, 16 kHz
+  uint32_t phase = 0;
+  for (int i = 0; i < n; i++) {
+    if (i >= len) {
+      out[i] = 0;
+      continue;
+    }
+    out[i] = sat16(isin(phase) / 2);                        // -6 dBFS
+    phase += (uint32_t)(INC0 + (INC1 - INC0) * i / len);
+  }
+}
+
+inline void makeInput(int input, int16_t* out, int n) {
+  switch (input) {
+    case VOICE: makeVoice(out, n); break;
+    case SWEEP: makeSweep(out, n); break;
+    case IMPULSE:
+      memset(out, 0, sizeof(int16_t) * n);
+      if (n > 64) out[64] = 26214;                          // 0.8 FS, off the block edge
+      break;
+    default:
+      memset(out, 0, sizeof(int16_t) * n);
+      break;
+  }
+}
+
+// FNV-1a over the samples, to pin the corpus itself
+inline uint32_t hash(const int16_t* p, int n) {
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < n; i++) {
+    h = (h ^ (uint8_t)p[i]) * 16777619u;
+    h = (h ^ (uint8_t)((uint16_t)p[i] >> 8)) * 16777619u;
+  }
+  return h;
+}
+
+// ---- rendering ----
+
+// One preset's output for the whole input, as the pedal renders it from
+// the block after a recall has settled
+inline void render(const GraphSettings& gs, const int16_t* in, int16_t* out, int n) {
+  MonoGraph* g = new MonoGraph();                           // delay pool, keep off the stack
+  g->configure(gs);
+  g->delay[0].snap();
+  for (int b = 0; b + BLOCK_SAMPLES <= n; b += BLOCK_SAMPLES) g->update(in + b, out + b);
+  delete g;
+}
+
+// ---- metrics ----
+
+struct Diff {
+  int    first = -1;          // first differing sample, -1 when bit-exact
+  int    count = 0;           // differing samples
+  int    maxAbs = 0;
+  double rmsDbfs = SILENT_DBFS;
+  double spectralDb = 0.0;    // worst band
+
+  bool exact() const { return first < 0; }
+  bool withinTolerance() const { return rmsDbfs <= TOL_RMS_DBFS && spectralDb <= TOL_SPECTRAL_DB; }
+};
+
+// In-place radix-2 FFT, n a power of two
+inline void fft(double* re, double* im, int n) {
+  for (int i = 1, j = 0; i < n; i++) {
+    int bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      double t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  for (int len = 2; len <= n; len <<= 1) {
+    const double a = -2.0 * M_PI / len;
+    for (int i = 0; i < n; i += len) {
+      for (int k = 0; k < len / 2; k++) {
+        const double wr = cos(a * k), wi = sin(a * k);
+        double* ur = re + i + k;
+        double* ui = im + i + k;
+        const double vr = ur[len / 2] * wr - ui[len / 2] * wi;
+        const double vi = ur[len / 2] * wi + ui[len / 2] * wr;
+        ur[len / 2] = *ur - vr;
+        ui[len / 2] = *ui - vi;
+        *ur += vr;
+        *ui += vi;
+      }
+    }
+  }
+}
+
+static const int FFT_SIZE = 2048;
+static const int BANDS = 26;                                // 50 Hz * 2^(k/3), to ~16 kHz
+
+// Welch power per 1/3-octave band
+inline void bandPower(const int16_t* x, int n, double* band) {
+  std::vector<double> psd(FFT_SIZE / 2 + 1, 0.0), re(FFT_SIZE), im(FFT_SIZE);
+  for (int at = 0; at + FFT_SIZE <= n; at += FFT_SIZE / 2) {
+    for (int i = 0; i < FFT_SIZE; i++) {
+      re[i] = x[at + i] * (0.5 - 0.5 * cos(2.0 * M_PI * i / FFT_SIZE));
+      im[i] = 0.0;
+    }
+    fft(re.data(), im.data(), FFT_SIZE);
+    for (int k = 0; k <= FFT_SIZE / 2; k++) psd[k] += re[k] * re[k] + im[k] * im[k];
+  }
+  for (int b = 0; b < BANDS; b++) {
+    const double centre = 50.0 * pow(2.0, b / 3.0);
+    const double lo = centre * pow(2.0, -1.0 / 6.0), hi = centre * pow(2.0, 1.0 / 6.0);
+    band[b] = 0.0;
+    for (int k = 1; k <= FFT_SIZE / 2; k++) {
+      const double f = (double)k * SAMPLE_RATE / FFT_SIZE;
+      if (f >= lo && f < hi) band[b] += psd[k];
+    }
+  }
+}
+
+inline Diff compare(const int16_t* ref, const int16_t* dut, int n) {
+  Diff d;
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    const int e = dut[i] - ref[i];
+    if (!e) continue;
+    if (d.first < 0) d.first = i;
+    d.count++;
+    if ((e < 0 ? -e : e) > d.maxAbs) d.maxAbs = e < 0 ? -e : e;
+    sum += (double)e * e;
+  }
+  if (sum > 0.0) d.rmsDbfs = 20.0 * log10(sqrt(sum / n) / 32768.0);
+  if (d.exact()) return d;
+
+  double pr[BANDS], pd[BANDS], top = 0.0;
+  bandPower(ref, n, pr);
+  bandPower(dut, n, pd);
+  for (int b = 0; b < BANDS; b++) {
+    if (pr[b] > top) top = pr[b];
+  }
+  // Bands below the range in both are noise floor; the floor also keeps a
+  // near-empty band from turning a tiny change into many dB
+  const double floor = top * pow(10.0, -SPECTRAL_RANGE_DB / 10.0);
+  for (int b = 0; b < BANDS && top > 0.0; b++) {
+    if (pr[b] < floor && pd[b] < floor) continue;
+    const double db = fabs(10.0 * log10((pd[b] + floor) / (pr[b] + floor)));
+    if (db > d.spectralDb) d.spectralDb = db;
+  }
+  return d;
+}
+
+// ---- golden files ----
+
+inline void path(char* buf, size_t n, const char* dir, int input, const char* preset) {
+  char p[16];
+  size_t i = 0;
+  for (; preset[i] && i + 1 < sizeof(p); i++) {
+    const char c = preset[i];
+    p[i] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+  }
+  p[i] = 0;
+  snprintf(buf, n, "%s/%s_%s.s16", dir, inputName(input), p);
+}
+
+// Exactly n samples, little-endian; false otherwise
+inline bool readRaw(const char* file, int16_t* dst, int n) {
+  FILE* f = fopen(file, "rb");
+  if (!f) return false;
+  bool ok = true;
+  for (int i = 0; i < n && ok; i++) {
+    const int lo = fgetc(f), hi = fgetc(f);
+    ok = lo != EOF && hi != EOF;
+    dst[i] = (int16_t)(uint16_t)(lo | (hi << 8));
+  }
+  ok = ok && fgetc(f) == EOF;
+  fclose(f);
+  return ok;
+}
+
+inline bool writeRaw(const char* file, const int16_t* src, int n) {
+  FILE* f = fopen(file, "wb");
+  if (!f) return false;
+  for (int i = 0; i < n; i++) {
+    fputc((uint16_t)src[i] & 0xFF, f);
+    fputc((uint16_t)src[i] >> 8, f);
+  }
+  return fclose(f) == 0;
+}
+
+} // namespace golden
+} // namespace vox
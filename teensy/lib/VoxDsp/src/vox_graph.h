@@ -0,0 +1,161 @@
+// VOX EFX - host mirror of the audio graph in src/main.cpp (src/effect_chain.h)
+//   in[ch] -> dyn[ch] -> eq[ch] -> reverb -> mix[ch](ch0 wet, ch1 dry, ch2 delay) -> amp[ch] -> out[ch]
+//                        eq[ch] -> delay[ch] ----^
+//   peaks: in (before dynamics), reverb (wet), mix, amp (out); each holds the
+//   max over channels,
+//   as the firmware's meters do
+// One AUDIO_BLOCK_SAMPLES block per call. Nodes run in a topological order
+// of vox_chain.h EDGES; the Teensy's update order (vox::chain::ORDER) only
+// differs in where the taps run, which changes no sample.
+
+#pragma once
+
+#include "vox_block.h"
+#include "vox_layout.h"
+#include "vox_reverb.h"
+#include "vox_delay.h"
+#include "vox_dynamics.h"
+#include "vox_eq.h"
+#include "vox_mixer.h"
+#include "vox_amp.h"
+#include "vox_peak.h"
+
+namespace vox {
+
+struct GraphSettings {
+  float roomsize = 0.55f;
+  float damping  = 0.5f;
+  float dry      = 1.0f;
+  float wet      = 0.0f;     // 0 when the effect is off
+  float level    = 0.5f;     // amp gain
+  float gainRampMs = 20.0f;  // mixer/amp gain changes ramp linearly over this
+
+  float delayMs       = 375.0f;
+  float delayFeedback = 0.35f;
+  float delayToneHz   = 4000.0f;
+  float delayModHz    = 0.5f;
+  float delayModMs    = 1.0f;
+  float delayMix      = 0.0f;  // 0 when the delay is off
+
+  bool  dynamics       = false; // bypassed when false
+  float gateDb         = -60.0f;
+  float gateRangeDb    = 0.0f;
+  float compDb         = -18.0f;
+  float compRatio      = 3.0f;
+  float compAttackMs   = 5.0f;
+  float compReleaseMs  = 120.0f;
+  float makeupDb       = 3.0f;
+  float ceilingDb      = -1.0f;
+  float limitReleaseMs = 60.0f;
+  float lookaheadMs    = 2.0f;
+
+  EqBand eq[Equalizer::BANDS] = {};  // all Off (flat)
+};
+
+template <int L>
+class Graph {
+public:
+  static const int CHANNELS = Layout<L>::CHANNELS;
+
+  static const uint32_t DELAY_POOL = Delay::poolSamples(VOX_DELAY_MAX_MS);
+
+  Dynamics  dyn[CHANNELS];
+  Equalizer eq[CHANNELS];
+  ReverbBank<CHANNELS, Layout<L>::SHARED_TANK> reverb;
+  Delay     delay[CHANNELS];
+  Mixer4    mix[CHANNELS];
+  Amplifier amp[CHANNELS];
+
+  Peak peakIn;
+  Peak peakWet;
+  Peak peakMix;
+  Peak peakOut;
+
+  Graph() {
+    for (int ch = 0; ch < CHANNELS; ch++) delay[ch].begin(delayMem[ch], DELAY_POOL);
+  }
+
+  // Same calls applyEffectState() makes on the pedal
+  void configure(const GraphSettings& s) {
+    reverb.roomsize(s.roomsize);
+    reverb.damping(s.damping);
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      dyn[ch].bypass(!s.dynamics);
+      dyn[ch].gate(s.gateDb, s.gateRangeDb);
+      dyn[ch].compressor(s.compDb, s.compRatio, s.makeupDb);
+      dyn[ch].compressorTimes(s.compAttackMs, s.compReleaseMs);
+      dyn[ch].limiter(s.ceilingDb, s.limitReleaseMs);
+      dyn[ch].lookahead(s.lookaheadMs);
+      for (int b = 0; b < Equalizer::BANDS; b++) eq[ch].setBand(b, s.eq[b]);
+
+      delay[ch].time(s.delayMs);
+      delay[ch].feedback(s.delayFeedback);
+      delay[ch].tone(s.delayToneHz);
+      delay[ch].modulation(s.delayModHz, s.delayModMs);
+
+      mix[ch].ramp(Ramp::LINEAR, s.gainRampMs);
+      amp[ch].ramp(Ramp::LINEAR, s.gainRampMs);
+      mix[ch].gain(1, s.dry);
+      mix[ch].gain(0, s.wet);
+      mix[ch].gain(2, s.delayMix);
+      mix[ch].gain(3, 0.0f);
+      amp[ch].gain(s.level);
+    }
+  }
+
+  // One block per channel in and out (out is zeroed when amp transmits
+  // nothing, as AudioOutputI2S does)
+  void process(const int16_t* const in[CHANNELS], int16_t* const out[CHANNELS]) {
+    int16_t dyned[BLOCK_SAMPLES];
+    int16_t dry[CHANNELS][BLOCK_SAMPLES];
+    int16_t wet[CHANNELS][BLOCK_SAMPLES];
+    int16_t echo[BLOCK_SAMPLES];
+    int16_t mixed[BLOCK_SAMPLES];
+    const int16_t* dryOut[CHANNELS];
+    int16_t* wetOut[CHANNELS];
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      // No input block: the node has nothing to forward (AudioStream semantics)
+      if (in[ch]) {
+        dyn[ch].update(in[ch], dyned);
+        eq[ch].update(dyned, dry[ch]);
+      }
+      dryOut[ch] = in[ch] ? dry[ch] : nullptr;
+      wetOut[ch] = wet[ch];
+    }
+
+    reverb.process(dryOut, wetOut);
+
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      delay[ch].update(dryOut[ch], echo);
+
+      const int16_t* mixIn[4] = { wet[ch], dryOut[ch], echo, nullptr };
+      bool haveMix = mix[ch].update(mixIn, mixed);
+      bool haveOut = amp[ch].update(haveMix ? mixed : nullptr, out[ch]);
+      if (!haveOut) {
+        for (int i = 0; i < BLOCK_SAMPLES; i++) out[ch][i] = 0;
+      }
+
+      peakIn.update(in[ch]);
+      peakWet.update(wet[ch]);
+      peakMix.update(haveMix ? mixed : nullptr);
+      peakOut.update(haveOut ? out[ch] : nullptr);
+    }
+  }
+
+  // Mono convenience
+  void update(const int16_t* in, int16_t* out) {
+    static_assert(CHANNELS == 1, "update(in, out) is mono only; use process()");
+    const int16_t* i[1] = { in };
+    int16_t* o[1] = { out };
+    process(i, o);
+  }
+
+private:
+  int16_t delayMem[CHANNELS][DELAY_POOL];
+};
+
+typedef Graph<VOX_LAYOUT_MONO>      MonoGraph;
+typedef Graph<VOX_LAYOUT_DUAL_MONO> DualMonoGraph;
+typedef Graph<VOX_LAYOUT_STEREO>    StereoGraph;
+
+} // namespace vox
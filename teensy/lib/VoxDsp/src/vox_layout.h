@@ -0,0 +1,36 @@
+// VOX EFX - channel layouts, selected at compile time with -DVOX_LAYOUT=...
+// - MONO:      Line-In Left -> left out (the original pedal)
+// - DUAL_MONO: two independent mono chains, one reverb tank per side
+// - STEREO:    L/R chains fed by one shared comb tank, decorrelated outputs
+// Every layout is built from the same templates; the channel count is a
+// template parameter, so sample loops never branch on it at run time.
+
+#pragma once
+
+#define VOX_LAYOUT_MONO      1
+#define VOX_LAYOUT_DUAL_MONO 2
+#define VOX_LAYOUT_STEREO    3
+
+namespace vox {
+
+template <int L> struct Layout;
+
+template <> struct Layout<VOX_LAYOUT_MONO> {
+  static const int  CHANNELS    = 1;
+  static const bool SHARED_TANK = true;
+  static const char* name() { return "MONO"; }
+};
+
+template <> struct Layout<VOX_LAYOUT_DUAL_MONO> {
+  static const int  CHANNELS    = 2;
+  static const bool SHARED_TANK = false;
+  static const char* name() { return "DUAL"; }
+};
+
+template <> struct Layout<VOX_LAYOUT_STEREO> {
+  static const int  CHANNELS    = 2;
+  static const bool SHARED_TANK = true;
+  static const char* name() { return "STEREO"; }
+};
+
+} // namespace vox
@@ -0,0 +1,278 @@
+// VOX EFX - append-only key/value log in NOR flash (settings persistence)
+// - The region is two banks. The active bank is the one with the valid
+//   header and the highest sequence number; records are appended after
+//   its header and the newest record of a key wins
+//     bank:   | magic u32 | seq u32 | crc16 | pad | record | record | ... | FF ...
+//     record: | 0x5A | key | len u16 | payload[len] | crc16 |
+// - put() only stages a record in RAM; poll() (from loop(), never the audio
+//   ISR) programs it CHUNK bytes at a time, so no call waits for more than
+//   one small flash program (a few bytes: NOR program time grows with the
+//   byte count). Nothing is erased outside begin()
+// - begin() (boot) scans the active bank and stops at the first record
+//   that doesn't check out: a write torn by power loss. It then compacts
+//   (latest record of every key into the other bank, its header written
+//   last) when the log is torn or has less than minFree bytes left (default
+//   half a bank), so a session starts with room for many records rather
+//   than filling up mid-session. A compaction cut short leaves the new bank
+//   without a header, so the old one still wins
+// - Flash: SIZE (two banks of whole sectors), SECTOR (erase unit), PAGE (a
+//   program must not cross one), read(off, dst, n), program(off, src, n)
+//   (NOR: clears bits only), erase(off) (the sector at off to 0xFF);
+//   offsets are from the start of the region. See src/flash_store.h and
+//   vox_file_flash.h
+// - Little-endian fields, CRC-16/CCITT-FALSE as on the UART link
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace vox {
+
+template <class Flash>
+class LogStore {
+public:
+  static const uint32_t BANK        = Flash::SIZE / 2;
+  static const int      MAX_KEYS    = 32;
+  static const uint16_t MAX_PAYLOAD = 128;
+  static const uint32_t CHUNK       = 4;           // bytes per poll()
+
+  struct Stats {
+    uint32_t seq;          // active bank's sequence number
+    uint8_t  bank;
+    uint32_t used;         // bytes of the bank in use
+    uint16_t records;      // in the log, superseded ones included
+    bool     torn;         // begin() found a torn record
+    bool     compacted;    // begin() compacted
+    uint32_t saved;        // records written since begin()
+    uint32_t full;         // put() refused for lack of room
+  };
+
+  // Bytes a record with a len-byte payload takes in the log
+  static constexpr uint32_t recordSize(uint16_t len) { return HEAD + len + 2u; }
+
+  explicit LogStore(Flash& f) : flash(f) {}
+
+  // Boot only: may erase a whole bank (tens of ms per sector)
+  void begin(uint32_t minFree = BANK / 2) {
+    memset(&st, 0, sizeof(st));
+    pending = false;
+
+    int active = -1;
+    uint32_t seq = 0;
+    for (int b = 0; b < 2; b++) {
+      uint32_t s;
+      if (readHeader(b, s) && (active < 0 || s > seq)) {
+        active = b;
+        seq = s;
+      }
+    }
+    if (active < 0) {
+      active = 0;
+      seq = 1;
+      eraseBank(0);
+      writeHeader(0, seq);
+    }
+    bank = (uint8_t)active;
+    st.seq = seq;
+
+    const bool clean = scan();
+    st.torn = !clean;
+    if (!clean || BANK - end < minFree) compact();
+  }
+
+  // Newest record of key into dst; false when there is none or it isn't len bytes
+  bool get(uint8_t key, void* dst, uint16_t len) const {
+    if (key >= MAX_KEYS || index[key] == NONE) return false;
+    uint8_t h[HEAD];
+    flash.read(bankBase(bank) + index[key], h, HEAD);
+    if (get16(h + 2) != len) return false;
+    flash.read(bankBase(bank) + index[key] + HEAD, dst, len);
+    return true;
+  }
+
+  // Stages one record; false while another is being written, when it's too
+  // big, or when the bank has no room left (until the next boot compacts)
+  bool put(uint8_t key, const void* src, uint16_t len) {
+    if (pending || key >= MAX_KEYS || len > MAX_PAYLOAD) return false;
+    const uint32_t size = recordSize(len);
+    if (end + size > BANK) {
+      st.full++;
+      return false;
+    }
+    buf[0] = REC_MAGIC;
+    buf[1] = key;
+    put16(buf + 2, len);
+    memcpy(buf + HEAD, src, len);
+    put16(buf + HEAD + len, crc16(buf, HEAD + len));
+    pendingKey = key;
+    pendingSize = size;
+    written = 0;
+    pending = true;
+    return true;
+  }
+
+  // Programs up to CHUNK bytes of the staged record (never across a CHUNK
+  // boundary, so never across a page); true while there is more to write
+  bool poll() {
+    if (!pending) return false;
+    const uint32_t at = end + written;
+    uint32_t n = CHUNK - at % CHUNK;
+    if (n > pendingSize - written) n = pendingSize - written;
+    flash.program(bankBase(bank) + at, buf + written, n);
+    written += n;
+    if (written < pendingSize) return true;
+
+    index[pendingKey] = end;
+    end += pendingSize;
+    st.used = end;
+    st.records++;
+    st.saved++;
+    pending = false;
+    return false;
+  }
+
+  bool busy() const { return pending; }
+  const Stats& stats() const { return st; }
+
+  static uint16_t crc16(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF) {
+    while (n--) {
+      crc ^= (uint16_t)(*p++) << 8;
+      for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+  }
+
+private:
+  static_assert(Flash::SIZE % (2 * Flash::SECTOR) == 0, "two banks of whole sectors");
+  static_assert(Flash::PAGE % CHUNK == 0, "a chunk must not cross a flash page");
+
+  static const uint32_t BANK_MAGIC = 0x534C5856;   // "VXLS"
+  static const uint8_t  REC_MAGIC  = 0x5A;
+  static const uint32_t HEADER     = 16;           // bank header slot
+  static const uint32_t HEAD       = 4;            // record header
+  static const uint32_t MAX_RECORD = HEAD + MAX_PAYLOAD + 2;
+  static const uint32_t NONE       = 0xFFFFFFFF;
+
+  static uint32_t bankBase(int b) { return (uint32_t)b * BANK; }
+
+  static void put16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+  }
+  static uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+  static void put32(uint8_t* p, uint32_t v) {
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+  }
+  static uint32_t get32(const uint8_t* p) { return get16(p) | ((uint32_t)get16(p + 2) << 16); }
+
+  bool readHeader(int b, uint32_t& seq) const {
+    uint8_t h[10];
+    flash.read(bankBase(b), h, sizeof(h));
+    if (get32(h) != BANK_MAGIC || get16(h + 8) != crc16(h, 8)) return false;
+    seq = get32(h + 4);
+    return true;
+  }
+
+  void writeHeader(int b, uint32_t seq) {
+    uint8_t h[10];
+    put32(h, BANK_MAGIC);
+    put32(h + 4, seq);
+    put16(h + 8, crc16(h, 8));
+    flash.program(bankBase(b), h, sizeof(h));
+  }
+
+  void eraseBank(int b) {
+    for (uint32_t off = 0; off < BANK; off += Flash::SECTOR) flash.erase(bankBase(b) + off);
+  }
+
+  bool erased(uint32_t off, uint32_t n) const {
+    uint8_t tmp[32];
+    while (n) {
+      const uint32_t k = n < sizeof(tmp) ? n : sizeof(tmp);
+      flash.read(bankBase(bank) + off, tmp, k);
+      for (uint32_t i = 0; i < k; i++) {
+        if (tmp[i] != 0xFF) return false;
+      }
+      off += k;
+      n -= k;
+    }
+    return true;
+  }
+
+  // Indexes the active bank; false when it ends in anything but erased flash
+  bool scan() {
+    for (int k = 0; k < MAX_KEYS; k++) index[k] = NONE;
+    st.records = 0;
+    uint32_t off = HEADER;
+    bool clean = true;
+    while (off + HEAD + 2 <= BANK) {
+      flash.read(bankBase(bank) + off, buf, HEAD);
+      const uint16_t len = get16(buf + 2);
+      if (buf[0] == 0xFF && buf[1] == 0xFF && len == 0xFFFF) {
+        const uint32_t left = BANK - off;
+        clean = erased(off, left < MAX_RECORD ? left : MAX_RECORD);
+        break;
+      }
+      if (buf[0] != REC_MAGIC || buf[1] >= MAX_KEYS || len > MAX_PAYLOAD || off + HEAD + len + 2 > BANK) {
+        clean = false;
+        break;
+      }
+      flash.read(bankBase(bank) + off + HEAD, buf + HEAD, len + 2u);
+      if (get16(buf + HEAD + len) != crc16(buf, HEAD + len)) {
+        clean = false;
+        break;
+      }
+      index[buf[1]] = off;
+      st.records++;
+      off += HEAD + len + 2;
+    }
+    end = off;
+    st.used = end;
+    st.bank = bank;
+    return clean;
+  }
+
+  void compact() {
+    const int to = bank ^ 1;
+    eraseBank(to);
+    uint32_t off = HEADER;
+    for (int k = 0; k < MAX_KEYS; k++) {
+      if (index[k] == NONE) continue;
+      flash.read(bankBase(bank) + index[k], buf, HEAD);
+      const uint32_t size = HEAD + get16(buf + 2) + 2;
+      flash.read(bankBase(bank) + index[k], buf, size);
+      // Split at CHUNK boundaries, as poll() does
+      for (uint32_t w = 0; w < size;) {
+        uint32_t n = CHUNK - (off + w) % CHUNK;
+        if (n > size - w) n = size - w;
+        flash.program(bankBase(to) + off + w, buf + w, n);
+        w += n;
+      }
+      off += size;
+    }
+    writeHeader(to, st.seq + 1);   // last: until here the old bank wins
+
+    bank = (uint8_t)to;
+    st.seq++;
+    st.compacted = true;
+    scan();
+  }
+
+  Flash&   flash;
+  uint8_t  bank = 0;
+  uint32_t end = 0;                 // first free byte of the active bank
+  uint32_t index[MAX_KEYS];         // newest record per key, NONE if none
+  Stats    st = {};
+
+  bool     pending = false;
+  uint8_t  pendingKey = 0;
+  uint32_t pendingSize = 0;
+  uint32_t written = 0;
+  uint8_t  buf[MAX_RECORD];         // staged record, or scan/compact scratch
+};
+
+} // namespace vox
@@ -0,0 +1,76 @@
+// VOX EFX - peak -> meter segment mapping
+// - MeterScale<N> holds the N segment thresholds as linear peak levels
+//   (0.0 .. 1.0, as AudioAnalyzePeak reads), evenly spaced in dB from
+//   floorDb (first segment) to topDb (all N lit). They are computed at
+//   compile time (constexpr exp), so the telemetry path has no log10f
+// - segments() is a branchless binary search: the table is padded with
+//   +huge to a power of two, each step is a compare and a conditional add
+//   (IT/csel, no jump), log2 steps for any N. NaN and <= 0 give 0
+// - segments(peaks, out, n) maps n channels per call
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vox {
+
+namespace meter {
+
+// exp(x) for constant expressions: halve into [-0.5, 0.5], Taylor, square back
+constexpr double cexp(double x) {
+  int halvings = 0;
+  while (x > 0.5 || x < -0.5) {
+    x *= 0.5;
+    halvings++;
+  }
+  double term = 1.0, sum = 1.0;
+  for (int k = 1; k < 16; k++) {
+    term *= x / k;
+    sum += term;
+  }
+  while (halvings--) sum *= sum;
+  return sum;
+}
+
+constexpr double dbToLinear(double db) { return cexp(db * 0.11512925464970229); }   // ln(10) / 20
+
+constexpr int pow2AtLeast(int n) {
+  int p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+} // namespace meter
+
+template <int N>
+class MeterScale {
+public:
+  static const int SEGMENTS = N;
+  static const int SLOTS = meter::pow2AtLeast(N + 1);   // the search never reads past N - 1 + padding
+
+  constexpr MeterScale(double floorDb, double topDb) : th() {
+    for (int i = 0; i < SLOTS; i++) {
+      th[i] = i < N ? (float)meter::dbToLinear(floorDb + (topDb - floorDb) * i / (N > 1 ? N - 1 : 1)) : 3.0e38f;
+    }
+  }
+
+  // Segments lit for a linear peak, 0 .. N
+  int segments(float peak) const {
+    int i = 0;
+    for (int step = SLOTS / 2; step > 0; step >>= 1) i += (th[i + step - 1] <= peak) ? step : 0;
+    return i < N ? i : N;                               // peak past the padding (inf)
+  }
+
+  void segments(const float* peaks, uint8_t* out, int n) const {
+    for (int c = 0; c < n; c++) out[c] = (uint8_t)segments(peaks[c]);
+  }
+
+  // Linear level where segment s (1 .. N) lights
+  constexpr float threshold(int s) const { return th[s - 1]; }
+
+private:
+  static_assert(N >= 1 && N < 255, "MeterScale: 1 .. 254 segments");
+  float th[SLOTS];
+};
+
+} // namespace vox
@@ -0,0 +1,50 @@
+// VOX EFX - 4-channel mixer kernel (AudioMixer4 math, with ramped gains)
+// Gain changes ramp per block (vox_ramp.h); a settled gain is bit-exact
+// with AudioMixer4.
+
+#pragma once
+
+#include "vox_block.h"
+#include "vox_ramp.h"
+
+namespace vox {
+
+class Mixer4 {
+public:
+  void gain(unsigned int channel, float level) {
+    if (channel >= 4) return;
+    gains[channel].set(gainToQ16(level));
+  }
+
+  void ramp(Ramp::Shape s, float ms) {
+    for (int ch = 0; ch < 4; ch++) gains[ch].shape(s, ms);
+  }
+
+  // Jump to the current gains at the next block
+  void snap() {
+    for (int ch = 0; ch < 4; ch++) gains[ch].snap();
+  }
+
+  // in[ch] may be nullptr (no block received on that channel).
+  // Returns false when no channel had a block, like the mixer not transmitting.
+  bool update(const int16_t* const in[4], int16_t* out) {
+    bool have = false;
+    for (int ch = 0; ch < 4; ch++) {
+      const Ramp::Segment seg = gains[ch].next();   // ramps run per block, blocks or not
+      const int16_t* src = in[ch];
+      if (!src) continue;
+      if (!have) {
+        Ramp::scale(seg, src, out);
+        have = true;
+      } else {
+        Ramp::accumulate(seg, src, out);
+      }
+    }
+    return have;
+  }
+
+private:
+  Ramp gains[4];
+};
+
+} // namespace vox
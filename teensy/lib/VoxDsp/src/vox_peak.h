@@ -0,0 +1,43 @@
+// VOX EFX - peak tap (same behaviour as AudioAnalyzePeak)
+
+#pragma once
+
+#include "vox_block.h"
+
+namespace vox {
+
+class Peak {
+public:
+  void update(const int16_t* in) {
+    if (!in) return;
+    int16_t lo = 32767, hi = -32768;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) {
+      if (in[i] < lo) lo = in[i];
+      if (in[i] > hi) hi = in[i];
+    }
+    if (lo < minSample) minSample = lo;
+    if (hi > maxSample) maxSample = hi;
+    newOutput = true;
+  }
+
+  bool available() const { return newOutput; }
+
+  // Largest |sample| since the last read, 0.0 .. 1.0; resets the hold.
+  float read() {
+    int lo = minSample, hi = maxSample;
+    minSample = 32767;
+    maxSample = -32768;
+    newOutput = false;
+    if (lo < 0) lo = -lo;
+    if (hi < 0) hi = -hi;
+    if (lo > hi) hi = lo;
+    return (float)hi / 32767.0f;
+  }
+
+private:
+  int16_t minSample = 32767;
+  int16_t maxSample = -32768;
+  bool    newOutput = false;
+};
+
+} // namespace vox
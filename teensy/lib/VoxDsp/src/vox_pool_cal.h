@@ -0,0 +1,95 @@
+// VOX EFX - AudioMemory calibration sequence
+// - Steps through every effect configuration (reverb x delay): apply it,
+//   let ramps and delay tails settle, reset the pool high-water mark, let
+//   the graph run for a window, then read the high-water mark
+// - safe() = peak + margin, the smallest AudioMemory(n) to use for that
+//   configuration; safeAll() covers all of them
+// - Pure logic on millis() timestamps; the firmware does the audio side
+//   (src/main.cpp, VOX_POOL_CALIBRATE)
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vox {
+
+class PoolCalibration {
+public:
+  static const int CONFIGS = 4;              // bit 0 = reverb, bit 1 = delay
+
+  enum Event : uint8_t {
+    NONE,
+    APPLY,          // set reverb() / delay() now
+    RESET_PEAK,     // reset the pool high-water mark now
+    MEASURED,       // peak(config()) is in
+    DONE            // every configuration measured
+  };
+
+  void begin(uint32_t nowMs, uint32_t settleMs, uint32_t windowMs, uint16_t margin) {
+    settle = settleMs;
+    window = windowMs;
+    extra = margin;
+    cfg = 0;
+    state = START;
+    since = nowMs;
+    for (int i = 0; i < CONFIGS; i++) peaks[i] = 0;
+  }
+
+  // Once per loop(); usedMax = the pool's high-water mark right now
+  Event poll(uint32_t nowMs, uint16_t usedMax) {
+    switch (state) {
+      case START:
+        return enter(SETTLING, nowMs, APPLY);
+      case SETTLING:
+        if (nowMs - since < settle) return NONE;
+        return enter(MEASURING, nowMs, RESET_PEAK);
+      case MEASURING:
+        if (nowMs - since < window) return NONE;
+        peaks[cfg] = usedMax;
+        return enter(NEXT, nowMs, MEASURED);
+      case NEXT:
+        if (++cfg == CONFIGS) {
+          cfg = CONFIGS - 1;
+          return enter(FINISHED, nowMs, DONE);
+        }
+        return enter(SETTLING, nowMs, APPLY);
+      default:
+        return NONE;
+    }
+  }
+
+  bool running() const { return state != IDLE && state != FINISHED; }
+  int  config() const { return cfg; }
+  bool reverb() const { return (cfg & 1) != 0; }
+  bool delay() const  { return (cfg & 2) != 0; }
+
+  uint16_t peak(int c) const { return peaks[c]; }
+  uint16_t safe(int c) const { return (uint16_t)(peaks[c] + extra); }
+
+  uint16_t safeAll() const {
+    uint16_t m = 0;
+    for (int i = 0; i < CONFIGS; i++) {
+      if (safe(i) > m) m = safe(i);
+    }
+    return m;
+  }
+
+private:
+  enum State : uint8_t { IDLE, START, SETTLING, MEASURING, NEXT, FINISHED };
+
+  Event enter(State s, uint32_t nowMs, Event e) {
+    state = s;
+    since = nowMs;
+    return e;
+  }
+
+  uint32_t settle = 0;
+  uint32_t window = 0;
+  uint32_t since = 0;
+  uint16_t extra = 0;
+  uint16_t peaks[CONFIGS] = { 0, 0, 0, 0 };
+  int      cfg = 0;
+  State    state = IDLE;
+};
+
+} // namespace vox
@@ -0,0 +1,153 @@
+// VOX EFX - per-block parameter ramp (zipper-free gain changes)
+// - set() is one 32-bit store of the Q16 target, safe from loop(); the ISR
+//   sees the change at the next block and ramps from wherever it is
+// - LINEAR reaches the target in a fixed number of blocks; EXPONENTIAL is a
+//   one-pole with a time constant, stepped per block. Inside a block both
+//   are a straight segment: a start value plus a per-sample step
+// - Segments run in Q24 so one block's rounding stays under 1/4 LSB at full
+//   scale; steps truncate toward zero, so a ramp never overshoots
+// - The first block after construction or snap() starts on the target
+//   (no fade-in from the constructor's value)
+// - A settled ramp applies the plain Q16 gain, bit-exact with mulQ16()
+
+#pragma once
+
+#include <math.h>
+
+#include "vox_block.h"
+
+namespace vox {
+
+class Ramp {
+public:
+  enum Shape : uint8_t { LINEAR, EXPONENTIAL };
+
+  // One block's gain: sample i gets start + i * step (Q24)
+  struct Segment {
+    int32_t start;
+    int32_t step;
+
+    bool    settled() const { return step == 0; }
+    int32_t q16() const     { return start >> 8; }
+  };
+
+  explicit Ramp(int32_t initialQ16 = GAIN_UNITY) : target(initialQ16), value(clampQ24(initialQ16)) {}
+
+  // Ramp shape and length (LINEAR: ms to the target, EXPONENTIAL: time
+  // constant); loop() side. 0 ms still spreads a change over one block
+  void shape(Shape s, float ms) {
+    float blocks = ms * 0.001f / BLOCK_SECONDS;
+    if (s == LINEAR) {
+      blocksPerRamp = blocks <= 0.0f ? 0 : (int32_t)(blocks + 0.999f);
+    } else {
+      // Per-block decay exp(-1 / blocks), Q16
+      coefQ16 = blocks <= 0.0f ? 0 : (int32_t)(expf(-1.0f / blocks) * 65536.0f);
+    }
+    mode = s;
+  }
+
+  void set(int32_t targetQ16) { target = targetQ16; }
+  int32_t get() const         { return target; }
+
+  // Start the next block on the target
+  void snap() { snapPending = true; }
+
+  // ISR side: the segment for this block; advances the ramp one block
+  Segment next() {
+    const int32_t t = target;
+    const int32_t t24 = clampQ24(t);
+    if (snapPending) {
+      snapPending = false;
+      value = t24;
+      last = t;
+      left = 0;
+    }
+    if (t != last) {
+      last = t;
+      left = blocksPerRamp;
+    }
+
+    Segment s;
+    s.start = value;
+    s.step = 0;
+    const int32_t diff = t24 - value;
+    if (diff == 0) return s;
+
+    int32_t end;
+    if (mode == LINEAR) {
+      end = left <= 1 ? t24 : value + diff / left;
+      if (left > 0) left--;
+    } else {
+      end = t24 - (int32_t)(((int64_t)diff * coefQ16) >> 16);
+      if (end - t24 < SETTLE && t24 - end < SETTLE) end = t24;
+    }
+
+    s.step = (end - value) / BLOCK_SAMPLES;
+    if (s.step == 0) {
+      // Less than a step per sample to go (< 1/4 LSB): finish here
+      value = t24;
+      s.start = t24;
+      return s;
+    }
+    value += s.step * BLOCK_SAMPLES;
+    return s;
+  }
+
+  // out = in * gain. Settled at unity copies, settled elsewhere is mulQ16()
+  static void scale(const Segment& s, const int16_t* in, int16_t* out) {
+    if (s.settled()) {
+      const int32_t mult = s.q16();
+      for (int i = 0; i < BLOCK_SAMPLES; i++) {
+        out[i] = (mult == GAIN_UNITY) ? in[i] : saturate16(mulQ16(mult, in[i]));
+      }
+      return;
+    }
+    int32_t g = s.start;
+    const int32_t step = s.step;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) {
+      out[i] = saturate16((int32_t)(((int64_t)g * in[i]) >> 24));
+      g += step;
+    }
+  }
+
+  // out += in * gain (each term saturated, as AudioMixer4 does)
+  static void accumulate(const Segment& s, const int16_t* in, int16_t* out) {
+    if (s.settled()) {
+      const int32_t mult = s.q16();
+      for (int i = 0; i < BLOCK_SAMPLES; i++) {
+        int32_t v = (mult == GAIN_UNITY) ? in[i] : saturate16(mulQ16(mult, in[i]));
+        out[i] = saturate16(out[i] + v);
+      }
+      return;
+    }
+    int32_t g = s.start;
+    const int32_t step = s.step;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) {
+      int32_t v = saturate16((int32_t)(((int64_t)g * in[i]) >> 24));
+      out[i] = saturate16(out[i] + v);
+      g += step;
+    }
+  }
+
+private:
+  static const int32_t SETTLE = 256;             // Q24, 1/65536 gain
+
+  // Gains up to +/-63, so a Q24 difference still fits 32 bits
+  static int32_t clampQ24(int32_t q16) {
+    const int32_t LIM = 63 * GAIN_UNITY;
+    if (q16 > LIM) q16 = LIM;
+    else if (q16 < -LIM) q16 = -LIM;
+    return q16 * 256;
+  }
+
+  volatile int32_t target;
+  volatile bool    snapPending = true;
+  volatile Shape   mode = LINEAR;
+  volatile int32_t blocksPerRamp = 0;
+  volatile int32_t coefQ16 = 0;
+  int32_t value;                                 // Q24, ISR only
+  int32_t last = 0;
+  int32_t left = 0;                              // blocks, LINEAR
+};
+
+} // namespace vox
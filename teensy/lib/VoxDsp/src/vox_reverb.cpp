@@ -0,0 +1,161 @@
+// VOX EFX - block-oriented Q15 Freeverb (see vox_reverb.h)
+
+#include "vox_reverb.h"
+
+#include <string.h>
+
+namespace vox {
+namespace reverb {
+
+const uint16_t COMB_LEN[COMBS] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+const uint16_t ALLPASS_LEN[ALLPASSES] = { 556, 441, 341, 225 };
+
+void initLines(ReverbLine* lines, int count, const uint16_t* lens, int spread, int16_t* mem) {
+  int16_t* p = mem;
+  for (int i = 0; i < count; i++) {
+    lines[i].buf = p;
+    lines[i].len = (uint16_t)(lens[i] + spread);
+    lines[i].index = 0;
+    lines[i].filter = 0;
+    memset(p, 0, lines[i].len * sizeof(int16_t));
+    p += lines[i].len;
+  }
+}
+
+static inline int spanOf(int left, const ReverbLine& l) {
+  int toWrap = l.len - l.index;
+  return left < toWrap ? left : toWrap;
+}
+
+static inline void advance(ReverbLine& l, int n) {
+  l.index += n;
+  if (l.index >= l.len) l.index = 0;
+}
+
+// Delay lines are all longer than a block, so nothing written in this block
+// is read back in it and each span can run independently; the span is the
+// shorter of the two combs' distances to their wrap.
+//
+// Two combs, two samples per step: each comb reads its (o[j], o[j+1]) word
+// once. Sample j's low-pass is SMUAD of (o[j], filter) x (damp2, damp1),
+// sample j+1's is SMUADX of (filter', o[j+1]) x (damp2, damp1), so neither
+// needs the other half unpacked. Both results are convex combinations of
+// int16s and the feedback is < 32768, so they fit without SSAT; the two
+// feedback terms are packed and added to the (x[j], x[j+1]) input word with
+// one QADD16, and the word is written back with one store.
+// DAMPED false: damp1 == 0, so Freeverb's damp2 is 32768 (no Q15 halfword)
+// and its filter output is bufout itself. FIRST: the first pair of the block
+// stores the comb sum instead of adding to it.
+template <bool DAMPED, bool FIRST>
+static void combPairT(ReverbLine* c, const int16_t* input, int32_t* sum, uint32_t damp, int32_t fb) {
+  int i = 0;
+  while (i < BLOCK_SAMPLES) {
+    const int n = spanOf(spanOf(BLOCK_SAMPLES - i, c[0]), c[1]);
+    int16_t* __restrict p0 = c[0].buf + c[0].index;
+    int16_t* __restrict p1 = c[1].buf + c[1].index;
+    const int16_t* __restrict x = input + i;
+    int32_t* __restrict acc = sum + i;
+    int32_t f0 = c[0].filter, f1 = c[1].filter;
+
+    int j = 0;
+    for (; j + 1 < n; j += 2) {
+      const uint32_t o0 = load2(p0 + j), o1 = load2(p1 + j), xx = load2(x + j);
+      int32_t e0, e1;   // sample j's filter output; f0/f1 become sample j+1's
+      if (DAMPED) {
+        e0 = shrz<15>(smuad(pack16((int32_t)o0, f0), damp));
+        e1 = shrz<15>(smuad(pack16((int32_t)o1, f1), damp));
+        f0 = shrz<15>(smuadx(pack16top(e0, o0), damp));
+        f1 = shrz<15>(smuadx(pack16top(e1, o1), damp));
+      } else {
+        e0 = (int16_t)o0; f0 = (int32_t)o0 >> 16;
+        e1 = (int16_t)o1; f1 = (int32_t)o1 >> 16;
+      }
+      store2(p0 + j, qadd16(xx, pack16(shrz<15>(e0 * fb), shrz<15>(f0 * fb))));
+      store2(p1 + j, qadd16(xx, pack16(shrz<15>(e1 * fb), shrz<15>(f1 * fb))));
+      const int32_t s0 = (int16_t)o0 + (int16_t)o1;
+      const int32_t s1 = ((int32_t)o0 >> 16) + ((int32_t)o1 >> 16);
+      if (FIRST) { acc[j] = s0; acc[j + 1] = s1; }
+      else       { acc[j] += s0; acc[j + 1] += s1; }
+    }
+    if (j < n) {
+      const int16_t o0 = p0[j], o1 = p1[j];
+      if (DAMPED) {
+        f0 = shrz<15>(smuad(pack16(o0, f0), damp));
+        f1 = shrz<15>(smuad(pack16(o1, f1), damp));
+      } else {
+        f0 = o0; f1 = o1;
+      }
+      p0[j] = sat16z<0>(x[j] + shrz<15>(f0 * fb));
+      p1[j] = sat16z<0>(x[j] + shrz<15>(f1 * fb));
+      if (FIRST) acc[j] = o0 + o1;
+      else       acc[j] += o0 + o1;
+    }
+
+    c[0].filter = (int16_t)f0; c[1].filter = (int16_t)f1;
+    advance(c[0], n);
+    advance(c[1], n);
+    i += n;
+  }
+}
+
+void combPair(ReverbLine* c, const int16_t* input, int32_t* sum, uint32_t damp, int32_t fbk, bool first) {
+  if (damp >> 16) {
+    if (first) combPairT<true, true>(c, input, sum, damp, fbk);
+    else       combPairT<true, false>(c, input, sum, damp, fbk);
+  } else {
+    if (first) combPairT<false, true>(c, input, sum, damp, fbk);
+    else       combPairT<false, false>(c, input, sum, damp, fbk);
+  }
+}
+
+// Freeverb's 31457 >> 17 comb sum gain; the multiply wraps like the M7's MUL
+static inline int16_t scaleSum(int32_t s) {
+  return sat16z<17>((int32_t)((uint32_t)s * 31457u));
+}
+
+// One pass over the block for the whole diffuser, two samples per step, so
+// the signal between the stages never leaves registers. Per allpass:
+// buffer <- v + (bufout >> 1) wraps per halfword (SHADD16 with zero, SADD16),
+// v <- (bufout - v) / 2 toward zero (hsub16z). A sample's path through the
+// four allpasses only reads each buffer before writing it, as in Freeverb,
+// so running them sample-interleaved instead of allpass by allpass is exact.
+void diffuse(ReverbLine* ap, const int32_t* sum, int16_t* out) {
+  int i = 0;
+  while (i < BLOCK_SAMPLES) {
+    int n = BLOCK_SAMPLES - i;
+    for (int a = 0; a < ALLPASSES; a++) n = spanOf(n, ap[a]);
+    int16_t* __restrict p0 = ap[0].buf + ap[0].index;
+    int16_t* __restrict p1 = ap[1].buf + ap[1].index;
+    int16_t* __restrict p2 = ap[2].buf + ap[2].index;
+    int16_t* __restrict p3 = ap[3].buf + ap[3].index;
+    const int32_t* __restrict s = sum + i;
+    int16_t* __restrict y = out + i;
+
+    int j = 0;
+    for (; j + 1 < n; j += 2) {
+      uint32_t v = pack16(scaleSum(s[j]), scaleSum(s[j + 1]));
+      uint32_t b;
+      b = load2(p0 + j); store2(p0 + j, sadd16(v, halve16(b))); v = hsub16z(b, v);
+      b = load2(p1 + j); store2(p1 + j, sadd16(v, halve16(b))); v = hsub16z(b, v);
+      b = load2(p2 + j); store2(p2 + j, sadd16(v, halve16(b))); v = hsub16z(b, v);
+      b = load2(p3 + j); store2(p3 + j, sadd16(v, halve16(b))); v = hsub16z(b, v);
+      store2(y + j, pack16(sat16z<0>(smulbb(v, 30)), sat16z<0>(smultb(v, 30))));
+    }
+    if (j < n) {
+      int16_t v = scaleSum(s[j]);
+      int16_t* const p[ALLPASSES] = { p0, p1, p2, p3 };
+      for (int a = 0; a < ALLPASSES; a++) {
+        const int16_t b = p[a][j];
+        p[a][j] = (int16_t)(v + (b >> 1));
+        v = sat16z<1>(b - v);
+      }
+      y[j] = sat16z<0>(v * 30);
+    }
+
+    for (int a = 0; a < ALLPASSES; a++) advance(ap[a], n);
+    i += n;
+  }
+}
+
+} // namespace reverb
+} // namespace vox
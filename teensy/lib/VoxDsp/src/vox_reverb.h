@@ -0,0 +1,172 @@
+// VOX EFX - block-oriented Q15 Freeverb
+// - Same roomsize()/damping() API and the same integer math as vox::Freeverb
+//   (and so AudioEffectFreeverb): mono output is bit-exact with it
+// - Each comb/allpass runs over the whole block in wrap-free spans instead of
+//   one sample of all 12 filters at a time, so indices, buffer pointers and
+//   filter state stay in registers
+// - Combs go two per pass, two samples per step: one load and one store per
+//   comb for each sample pair, the damping low-pass is SMUAD/SMUADX on the
+//   packed (bufout, filter) x (damp2, damp1) pair, input + feedback one
+//   QADD16 per pair. The allpass diffuser is one fused pass from the comb
+//   sum to the output, two samples per word (SHADD16/SADD16, SHSUB16/SEL);
+//   saturation is SSAT (vox_simd.h)
+// - ReverbTank<CH>: CH inputs are summed into one shared comb tank, then each
+//   output gets its own allpass diffuser (Freeverb's +23 sample stereo spread).
+//   Stereo costs 8 combs + 8 allpasses instead of 2 x (8 + 4).
+
+#pragma once
+
+#include "vox_block.h"
+#include "vox_simd.h"
+
+namespace vox {
+
+// Delay line with a comb damping state (unused by allpasses)
+struct ReverbLine {
+  int16_t* buf;
+  uint16_t len;
+  uint16_t index;
+  int16_t  filter;
+};
+
+// Building blocks, shared by every channel count and by the kernel benchmarks
+namespace reverb {
+
+static const int COMBS     = 8;
+static const int ALLPASSES = 4;
+static const int STEREO_SPREAD = 23;
+
+extern const uint16_t COMB_LEN[COMBS];
+extern const uint16_t ALLPASS_LEN[ALLPASSES];
+
+static const int COMB_MEM    = 1116 + 1188 + 1277 + 1356 + 1422 + 1491 + 1557 + 1617;
+static const int ALLPASS_MEM = 556 + 441 + 341 + 225;
+
+// Two combs over one block: sum (+)= outputs (first: =), buffers <- input +
+// damped feedback
+void combPair(ReverbLine* c, const int16_t* input, int32_t* sum, uint32_t dampPacked, int32_t feedback, bool first);
+
+// Comb sum -> one output: Freeverb's 31457 >> 17 gain, the 4 allpasses, x30
+void diffuse(ReverbLine* ap, const int32_t* sum, int16_t* out);
+
+// Carve lines out of mem; spread is added to every length
+void initLines(ReverbLine* lines, int count, const uint16_t* lens, int spread, int16_t* mem);
+
+// Input scaling for CH channels summed into the tank (numerical headroom)
+template <int CH> struct TankInput;
+
+template <> struct TankInput<1> {
+  static void mix(const int16_t* const in[1], int16_t* x) {
+    const int16_t* a = in[0] ? in[0] : ZERO_BLOCK;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) x[i] = sat16z<17>(a[i] * 8738);
+  }
+};
+
+template <> struct TankInput<2> {
+  static void mix(const int16_t* const in[2], int16_t* x) {
+    const int16_t* a = in[0] ? in[0] : ZERO_BLOCK;
+    const int16_t* b = in[1] ? in[1] : ZERO_BLOCK;
+    for (int i = 0; i < BLOCK_SAMPLES; i++) x[i] = sat16z<18>((a[i] + b[i]) * 8738);
+  }
+};
+
+} // namespace reverb
+
+template <int CH>
+class ReverbTank {
+public:
+  static const int CHANNELS = CH;
+
+  ReverbTank() { reset(); }
+
+  void reset() {
+    reverb::initLines(comb, reverb::COMBS, reverb::COMB_LEN, 0, combMem);
+    for (int ch = 0; ch < CH; ch++) {
+      reverb::initLines(ap[ch], reverb::ALLPASSES, reverb::ALLPASS_LEN,
+                        ch * reverb::STEREO_SPREAD, allpassMem[ch]);
+    }
+    damping(0.5f);
+    feedback = 27524;
+  }
+
+  // 0.0 .. 1.0 (smaller -> subtle, larger -> bigger tail)
+  void roomsize(float n) {
+    if (n > 1.0f) n = 1.0f;
+    else if (n < 0.0f) n = 0.0f;
+    feedback = (int)(n * 9175.04f) + 22937;
+  }
+
+  // 0.0 .. 1.0 (higher = darker/less bright).
+  // Both coefficients live in one word, so a single store updates them
+  // atomically w.r.t. the audio ISR. x1 == 0 (damp2 = 32768, not a Q15
+  // halfword) is stored as 0: combPair() then passes bufout through.
+  void damping(float n) {
+    if (n > 1.0f) n = 1.0f;
+    else if (n < 0.0f) n = 0.0f;
+    int x1 = (int)(n * 13107.2f);
+    dampPacked = x1 ? pack16((int16_t)(32768 - x1), (int16_t)x1) : 0;
+  }
+
+  // in[ch] may be nullptr (silence in, the tail keeps ringing)
+  void process(const int16_t* const in[CH], int16_t* const out[CH]) {
+    int16_t input[BLOCK_SAMPLES];
+    int32_t sum[BLOCK_SAMPLES];
+
+    reverb::TankInput<CH>::mix(in, input);
+
+    // One coherent parameter set per block
+    const uint32_t damp = dampPacked;
+    const int32_t fbk = feedback;
+    for (int c = 0; c < reverb::COMBS; c += 2) reverb::combPair(&comb[c], input, sum, damp, fbk, c == 0);
+
+    for (int ch = 0; ch < CH; ch++) reverb::diffuse(ap[ch], sum, out[ch]);
+  }
+
+  // Mono convenience, same signature as vox::Freeverb::update()
+  void update(const int16_t* in, int16_t* out) {
+    static_assert(CH == 1, "update(in, out) is mono only; use process()");
+    const int16_t* i[1] = { in };
+    int16_t* o[1] = { out };
+    process(i, o);
+  }
+
+private:
+  int16_t combMem[reverb::COMB_MEM];
+  int16_t allpassMem[CH][reverb::ALLPASS_MEM + reverb::ALLPASSES * reverb::STEREO_SPREAD * (CH - 1)];
+  ReverbLine comb[reverb::COMBS];
+  ReverbLine ap[CH][reverb::ALLPASSES];
+
+  volatile uint32_t dampPacked;   // lo = damp2 (x bufout), hi = damp1 (x filter)
+  volatile int32_t  feedback;
+};
+
+typedef ReverbTank<1> Reverb;
+
+// CH channels of reverb: one shared tank (SHARED) or one mono tank per channel
+template <int CH, bool SHARED> class ReverbBank;
+
+template <int CH>
+class ReverbBank<CH, true> {
+public:
+  void roomsize(float n) { tank.roomsize(n); }
+  void damping(float n)  { tank.damping(n); }
+  void process(const int16_t* const in[CH], int16_t* const out[CH]) { tank.process(in, out); }
+
+private:
+  ReverbTank<CH> tank;
+};
+
+template <int CH>
+class ReverbBank<CH, false> {
+public:
+  void roomsize(float n) { for (int ch = 0; ch < CH; ch++) tank[ch].roomsize(n); }
+  void damping(float n)  { for (int ch = 0; ch < CH; ch++) tank[ch].damping(n); }
+  void process(const int16_t* const in[CH], int16_t* const out[CH]) {
+    for (int ch = 0; ch < CH; ch++) tank[ch].process(&in[ch], &out[ch]);
+  }
+
+private:
+  Reverb tank[CH];
+};
+
+} // namespace vox
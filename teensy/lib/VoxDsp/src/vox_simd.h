@@ -0,0 +1,190 @@
+// VOX EFX - Cortex-M7 DSP-extension helpers with portable fallbacks
+// On the Teensy 4 (ARMv7E-M) these compile to single instructions (SMUAD,
+// SMULBB/SMULTB, SSAT, PKHBT, the *ADD16/*SUB16 halfword SIMD ops); on the
+// host they are plain C with identical results. A packed pair is lo in bits
+// 0..15, hi in bits 16..31.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH_7EM__)
+#define VOX_HAVE_DSP_EXT 1
+#else
+#define VOX_HAVE_DSP_EXT 0
+#endif
+
+namespace vox {
+
+// lo in bits 0..15, hi in bits 16..31 (the low halfword of each, so a value
+// already in int16 range needs no sign extension first)
+static inline uint32_t pack16(int32_t lo, int32_t hi) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t out;
+  asm("pkhbt %0, %1, %2, lsl #16" : "=r"(out) : "r"(lo), "r"(hi));
+  return out;
+#else
+  return (uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+#endif
+}
+
+// lo in bits 0..15, a's own bits 16..31
+static inline uint32_t pack16top(int32_t lo, uint32_t a) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t out;
+  asm("pkhbt %0, %1, %2" : "=r"(out) : "r"(lo), "r"(a));
+  return out;
+#else
+  return (uint16_t)lo | (a & 0xFFFF0000u);
+#endif
+}
+
+// lo(a)*lo(b) + hi(a)*hi(b), both products signed 16x16 (dual MAC)
+static inline int32_t smuad(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("smuad %0, %1, %2" : "=r"(out) : "r"(a), "r"(b));
+  return out;
+#else
+  return (int32_t)(int16_t)a * (int16_t)b + (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+#endif
+}
+
+// lo(a)*hi(b) + hi(a)*lo(b) (dual MAC, one operand's halves exchanged)
+static inline int32_t smuadx(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("smuadx %0, %1, %2" : "=r"(out) : "r"(a), "r"(b));
+  return out;
+#else
+  return (int32_t)(int16_t)a * (int16_t)(b >> 16) + (int32_t)(int16_t)(a >> 16) * (int16_t)b;
+#endif
+}
+
+// lo(a)*lo(b) and hi(a)*lo(b), signed 16x16
+static inline int32_t smulbb(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("smulbb %0, %1, %2" : "=r"(out) : "r"(a), "r"(b));
+  return out;
+#else
+  return (int32_t)(int16_t)a * (int16_t)b;
+#endif
+}
+
+static inline int32_t smultb(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("smultb %0, %1, %2" : "=r"(out) : "r"(a), "r"(b));
+  return out;
+#else
+  return (int32_t)(int16_t)(a >> 16) * (int16_t)b;
+#endif
+}
+
+// Per halfword: a + b saturated to int16
+static inline uint32_t qadd16(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t out;
+  asm("qadd16 %0, %1, %2" : "=r"(out) : "r"(a), "r"(b));
+  return out;
+#else
+  const int32_t lo = (int16_t)a + (int16_t)b, hi = (int16_t)(a >> 16) + (int16_t)(b >> 16);
+  return pack16((int16_t)(lo > 32767 ? 32767 : (lo < -32768 ? -32768 : lo)),
+                (int16_t)(hi > 32767 ? 32767 : (hi < -32768 ? -32768 : hi)));
+#endif
+}
+
+// Per halfword: a + b, wrapping like an int16_t cast
+static inline uint32_t sadd16(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t out;
+  asm("sadd16 %0, %1, %2" : "=r"(out) : "r"(a), "r"(b) : "cc");
+  return out;
+#else
+  return pack16((int16_t)((int16_t)a + (int16_t)b), (int16_t)((int16_t)(a >> 16) + (int16_t)(b >> 16)));
+#endif
+}
+
+// Per halfword: a >> 1 (arithmetic, as SHADD16 with zero)
+static inline uint32_t halve16(uint32_t a) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t out;
+  asm("shadd16 %0, %1, %2" : "=r"(out) : "r"(a), "r"(0u));
+  return out;
+#else
+  return pack16((int16_t)((int16_t)a >> 1), (int16_t)((int16_t)(a >> 16) >> 1));
+#endif
+}
+
+// Per halfword: (a - b) / 2 rounded toward zero, as sat16z<1>(a - b); never
+// saturates. SHSUB16 floors, so the negative lanes take -floor((b - a) / 2)
+// instead, picked by the GE flags of a full-precision SSUB16 (one asm block,
+// the flags don't survive between statements)
+static inline uint32_t hsub16z(uint32_t a, uint32_t b) {
+#if VOX_HAVE_DSP_EXT
+  uint32_t down, up, out;
+  asm("shsub16 %[down], %[a], %[b]\n\t"
+      "shsub16 %[up], %[b], %[a]\n\t"
+      "ssub16 %[up], %[zero], %[up]\n\t"
+      "ssub16 %[out], %[a], %[b]\n\t"
+      "sel %[out], %[down], %[up]"
+      : [down] "=&r"(down), [up] "=&r"(up), [out] "=&r"(out)
+      : [a] "r"(a), [b] "r"(b), [zero] "r"(0u)
+      : "cc");
+  return out;
+#else
+  const int32_t lo = (int16_t)a - (int16_t)b, hi = (int16_t)(a >> 16) - (int16_t)(b >> 16);
+  return pack16((int16_t)(lo / 2), (int16_t)(hi / 2));
+#endif
+}
+
+// Two adjacent int16 samples as one packed word (LDR/STR; the M7 takes
+// unaligned word accesses)
+static inline uint32_t load2(const int16_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline void store2(int16_t* p, uint32_t v) { memcpy(p, &v, sizeof(v)); }
+
+// Clamp to int16 range
+static inline int32_t ssat16(int32_t n) {
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("ssat %0, #16, %1" : "=r"(out) : "r"(n));
+  return out;
+#else
+  return n > 32767 ? 32767 : (n < -32768 ? -32768 : n);
+#endif
+}
+
+// Shift right rounding toward zero, no clamp: for results the caller knows
+// fit (ASR, then ADD with LSR and ASR on the M7)
+template <int RSHIFT>
+static inline int32_t shrz(int32_t n) {
+  return (n + (int32_t)((uint32_t)(n >> 31) >> (32 - RSHIFT))) >> RSHIFT;
+}
+
+// Branchless sat16(): shift right rounding toward zero, then clamp.
+// On the M7 the shift folds into the SSAT (ssat rd, #16, rn, asr #R).
+template <int RSHIFT>
+static inline int16_t sat16z(int32_t n) {
+  n += (n >> 31) & ((1 << RSHIFT) - 1);
+#if VOX_HAVE_DSP_EXT
+  int32_t out;
+  asm("ssat %0, #16, %1, asr %2" : "=r"(out) : "r"(n), "I"(RSHIFT));
+  return (int16_t)out;
+#else
+  return (int16_t)ssat16(n >> RSHIFT);
+#endif
+}
+
+template <>
+inline int16_t sat16z<0>(int32_t n) {
+  return (int16_t)ssat16(n);
+}
+
+} // namespace vox
@@ -0,0 +1,83 @@
+// VOX EFX - tap tempo (footswitch taps -> beat period)
+// - Averages the last few tap intervals; a pause longer than TIMEOUT_MS starts
+//   a new tap sequence, so a stray tap never yields a multi-second delay
+// - untap() takes back the last tap (a footswitch press that turned out to
+//   be a hold), as if it never happened
+// - Pure logic on millis() timestamps, shared by the firmware and host tests
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+namespace vox {
+
+class TapTempo {
+public:
+  static const int      MAX_INTERVALS = 3;
+  static const uint32_t MIN_MS = 60;        // faster than this is switch bounce
+  static const uint32_t TIMEOUT_MS = 2000;
+
+  // Returns true when the tap produced a new period
+  bool tap(uint32_t nowMs) {
+    saveUndo();
+    const uint32_t dt = nowMs - lastMs;
+    const bool first = (count < 0) || dt > TIMEOUT_MS;
+    lastMs = nowMs;
+    if (first) {
+      count = 0;
+      head = 0;
+      return false;
+    }
+    if (dt < MIN_MS) return false;
+
+    intervals[head] = dt;
+    head = (head + 1) % MAX_INTERVALS;
+    if (count < MAX_INTERVALS) count++;
+
+    uint32_t sum = 0;
+    for (int i = 0; i < count; i++) sum += intervals[i];
+    period = sum / count;
+    return true;
+  }
+
+  // Last tapped beat period, 0 before the first pair of taps
+  uint32_t periodMs() const { return period; }
+
+  // Back to the state before the last tap(); once per tap
+  void untap() {
+    if (!canUndo) return;
+    memcpy(intervals, undo.intervals, sizeof(intervals));
+    lastMs = undo.lastMs;
+    period = undo.period;
+    head = undo.head;
+    count = undo.count;
+    canUndo = false;
+  }
+
+private:
+  struct State {
+    uint32_t intervals[MAX_INTERVALS];
+    uint32_t lastMs, period;
+    int head, count;
+  };
+
+  void saveUndo() {
+    memcpy(undo.intervals, intervals, sizeof(intervals));
+    undo.lastMs = lastMs;
+    undo.period = period;
+    undo.head = head;
+    undo.count = count;
+    canUndo = true;
+  }
+
+  uint32_t intervals[MAX_INTERVALS] = { 0, 0, 0 };
+  uint32_t lastMs = 0;
+  uint32_t period = 0;
+  int head = 0;
+  int count = -1;                            // -1 = no tap yet
+  State undo;
+  bool canUndo = false;
+};
+
+} // namespace vox
@@ -0,0 +1,32 @@
+// VOX EFX - AudioMemory pool watch
+// The Audio library's allocate() returns nullptr when the AudioMemory pool
+// is empty and the block is silently skipped. Our AudioStream wrappers derive
+// from AudioStreamVox instead, whose allocate() counts those failures.
+// Library objects (i2sIn) still fail silently: a high-water mark equal to
+// the capacity is the other sign of an undersized pool.
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+class AudioStreamVox : public AudioStream {
+public:
+  using AudioStream::AudioStream;
+
+  // Since boot; written in the audio ISR, a 32-bit load from loop() is atomic
+  static uint32_t allocFailures() { return failures(); }
+
+protected:
+  static audio_block_t* allocate(void) {
+    audio_block_t* b = AudioStream::allocate();
+    if (!b) failures()++;
+    return b;
+  }
+
+private:
+  static volatile uint32_t& failures() {
+    static volatile uint32_t n = 0;
+    return n;
+  }
+};
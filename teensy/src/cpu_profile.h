@@ -0,0 +1,35 @@
+// VOX EFX - per-node CPU profiling for AudioStream objects
+// Profiled<T> is a drop-in for any audio object T: its update() is timed with
+// the Cortex-M7 cycle counter (ARM_DWT_CYCCNT, enabled by the Teensy 4 startup)
+// and accumulated in a vox::CpuStats window that sendDbg() reports and resets.
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "vox_cpu_stats.h"
+
+template <class Node>
+class Profiled : public Node {
+public:
+  Profiled() {
+    // Cycles available per AUDIO_BLOCK_SAMPLES block (~2.9 ms)
+    cpu.setBudget((uint32_t)((float)F_CPU_ACTUAL * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT));
+  }
+
+  virtual void update(void) {
+    uint32_t t0 = ARM_DWT_CYCCNT;
+    Node::update();
+    cpu.record(ARM_DWT_CYCCNT - t0);
+  }
+
+  // Called from loop(): copies the window atomically w.r.t. the audio ISR
+  void takeCpu(vox::CpuStats::Snapshot& out) {
+    __disable_irq();
+    cpu.takeAndReset(out);
+    __enable_irq();
+  }
+
+  vox::CpuStats cpu;
+};
@@ -0,0 +1,170 @@
+// VOX EFX - the pedal's audio graph for one channel layout (vox_layout.h)
+//   i2sIn -> dyn[ch] -> eq[ch] -> reverb -> mix[ch](ch0 wet, ch1 dry, ch2 delay) -> amp[ch] -> i2sOut
+//                       eq[ch] -> delay[ch] ----^
+//   peaks: in (before dynamics), reverb (wet), mix, amp (out) per channel
+// The nodes and cords come from lib/VoxDsp vox_chain.h, checked at compile
+// time. The AudioStream update order is the construction order, so the
+// nodes live in NodeSlots and are built in vox::chain::ORDER (taps right
+// after what they tap, shortest block lifetimes); MONO / DUAL_MONO /
+// STEREO all come from that one description. vox_graph.h mirrors it.
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+#include <new>
+#include <type_traits>
+
+#include "vox_layout.h"
+#include "vox_chain.h"
+#include "cpu_profile.h"
+#include "effect_voxreverb.h"
+#include "effect_voxdelay.h"
+#include "effect_voxdynamics.h"
+#include "effect_voxeq.h"
+#include "effect_voxmixer.h"
+#include "effect_voxamp.h"
+
+// N audio objects, constructed by build() rather than with the owner, so
+// EffectChain decides the update order. Never destroyed (the chain lives
+// for the whole program)
+template <class T, int N>
+class NodeSlots {
+public:
+  void build() { for (int i = 0; i < N; i++) new (&mem[i]) T(); }
+
+  T& operator[](int i) { return *reinterpret_cast<T*>(&mem[i]); }
+  operator T*() { return &(*this)[0]; }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type mem[N];
+};
+
+// Reverb node(s) for CH channels: one shared CH-in/CH-out tank, or CH mono tanks
+template <int CH, bool SHARED> struct ReverbNodes;
+
+template <int CH>
+struct ReverbNodes<CH, true> {
+  static const int UNITS = 1;
+  NodeSlots<Profiled<AudioEffectVoxReverbT<CH>>, UNITS> unit;
+
+  AudioStream& node(int)  { return unit[0]; }
+  uint8_t      port(int ch) const { return (uint8_t)ch; }
+};
+
+template <int CH>
+struct ReverbNodes<CH, false> {
+  static const int UNITS = CH;
+  NodeSlots<Profiled<AudioEffectVoxReverb>, UNITS> unit;
+
+  AudioStream& node(int ch) { return unit[ch]; }
+  uint8_t      port(int) const { return 0; }
+};
+
+template <int L>
+class EffectChain {
+public:
+  static const int CHANNELS = vox::Layout<L>::CHANNELS;
+  typedef ReverbNodes<CHANNELS, vox::Layout<L>::SHARED_TANK> Reverbs;
+
+  // AudioMemory blocks the graph needs at least (vox_chain.h block model)
+  static constexpr int BLOCKS = vox::chain::blocks(CHANNELS);
+
+  NodeSlots<AudioInputI2S, 1>                     i2sIn;     // SGTL5000 ADC (L, R)
+  NodeSlots<Profiled<AudioEffectVoxDynamics>, CHANNELS> dyn; // gate/comp/limiter
+  NodeSlots<Profiled<AudioFilterVoxEq>, CHANNELS> eq;        // 6-band parametric
+  Reverbs                                         reverb;
+  NodeSlots<Profiled<AudioEffectVoxDelay>, CHANNELS> delay;
+  NodeSlots<Profiled<AudioMixerVox4>, CHANNELS>   mix;       // ch0=wet, ch1=dry, ch2=delay
+  NodeSlots<Profiled<AudioAmplifierVox>, CHANNELS> amp;      // output level
+  NodeSlots<AudioOutputI2S, 1>                    i2sOut;    // SGTL5000 DAC (L, R)
+
+  // Peaks (tap points)
+  NodeSlots<Profiled<AudioAnalyzePeak>, CHANNELS> peakIn;
+  NodeSlots<Profiled<AudioAnalyzePeak>, CHANNELS> peakWet;
+  NodeSlots<Profiled<AudioAnalyzePeak>, CHANNELS> peakMix;
+  NodeSlots<Profiled<AudioAnalyzePeak>, CHANNELS> peakOut;
+
+  EffectChain() {
+    using namespace vox::chain;
+    for (int i = 0; i < NODES; i++) build(ORDER.order[i]);
+
+    AudioConnection* c = cords;
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      for (int e = 0; e < EDGE_COUNT; e++) {
+        const Edge& ed = EDGES[e];
+        (c++)->connect(node(ed.from, ch), outPort(ed.from, ch), node(ed.to, ch), inPort(ed.to, ed.port, ch));
+      }
+    }
+  }
+
+  // Gain ramps for every mixer and amp (vox_ramp.h)
+  void gainRamp(vox::Ramp::Shape s, float ms) {
+    for (int ch = 0; ch < CHANNELS; ch++) {
+      mix[ch].ramp(s, ms);
+      amp[ch].ramp(s, ms);
+    }
+  }
+
+  void roomsize(float n) { for (int u = 0; u < Reverbs::UNITS; u++) reverb.unit[u].roomsize(n); }
+  void damping(float n)  { for (int u = 0; u < Reverbs::UNITS; u++) reverb.unit[u].damping(n); }
+
+  // Give each channel's delay its slice of voxDelayPool
+  void beginDelay() {
+    static_assert(sizeof(voxDelayPool) / sizeof(voxDelayPool[0]) >= CHANNELS, "voxDelayPool is sized for VOX_LAYOUT");
+    for (int ch = 0; ch < CHANNELS; ch++) delay[ch].begin(voxDelayPool[ch], VOX_DELAY_POOL_SAMPLES);
+  }
+
+private:
+  void build(vox::chain::Node n) {
+    using namespace vox::chain;
+    switch (n) {
+      case IN:       i2sIn.build(); break;
+      case DYN:      dyn.build(); break;
+      case EQ:       eq.build(); break;
+      case REVERB:   reverb.unit.build(); break;
+      case DELAY:    delay.build(); break;
+      case MIX:      mix.build(); break;
+      case AMP:      amp.build(); break;
+      case OUT:      i2sOut.build(); break;
+      case PEAK_IN:  peakIn.build(); break;
+      case PEAK_WET: peakWet.build(); break;
+      case PEAK_MIX: peakMix.build(); break;
+      case PEAK_OUT: peakOut.build(); break;
+      default:       break;
+    }
+  }
+
+  AudioStream& node(vox::chain::Node n, int ch) {
+    using namespace vox::chain;
+    switch (n) {
+      case IN:       return i2sIn[0];
+      case DYN:      return dyn[ch];
+      case EQ:       return eq[ch];
+      case REVERB:   return reverb.node(ch);
+      case DELAY:    return delay[ch];
+      case MIX:      return mix[ch];
+      case AMP:      return amp[ch];
+      case OUT:      return i2sOut[0];
+      case PEAK_IN:  return peakIn[ch];
+      case PEAK_WET: return peakWet[ch];
+      case PEAK_MIX: return peakMix[ch];
+      default:       return peakOut[ch];
+    }
+  }
+
+  // Per-channel ports of the description -> ports of the shared objects
+  uint8_t outPort(vox::chain::Node n, int ch) const {
+    if (n == vox::chain::IN) return (uint8_t)ch;
+    if (n == vox::chain::REVERB) return reverb.port(ch);
+    return 0;
+  }
+
+  uint8_t inPort(vox::chain::Node n, uint8_t port, int ch) const {
+    if (n == vox::chain::OUT) return (uint8_t)ch;
+    if (n == vox::chain::REVERB) return reverb.port(ch);
+    return port;
+  }
+
+  AudioConnection cords[vox::chain::EDGE_COUNT * CHANNELS];
+};
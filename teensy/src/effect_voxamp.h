@@ -0,0 +1,35 @@
+// VOX EFX - AudioStream wrapper for the ramped amplifier (lib/VoxDsp vox_amp.h)
+// Drop-in for AudioAmplifier: a new gain() ramps in over the next blocks
+// instead of jumping. Transmits nothing once settled at 0, as AudioAmplifier
+// does. gain() is a single 32-bit store, safe to call from loop().
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_amp.h"
+
+class AudioAmplifierVox : public AudioStreamVox {
+public:
+  AudioAmplifierVox() : AudioStreamVox(1, inputQueueArray) {}
+
+  void gain(float n)                        { kernel.gain(n); }
+  void ramp(vox::Ramp::Shape s, float ms)   { kernel.ramp(s, ms); }
+
+  virtual void update(void) {
+    audio_block_t* in = receiveReadOnly(0);
+
+    audio_block_t* out = allocate();
+    if (out) {
+      if (kernel.update(in ? in->data : nullptr, out->data)) transmit(out);
+      release(out);
+    }
+    if (in) release(in);
+  }
+
+private:
+  audio_block_t* inputQueueArray[1];
+  vox::Amplifier kernel;
+};
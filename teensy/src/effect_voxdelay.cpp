@@ -0,0 +1,9 @@
+// VOX EFX - delay line pool (see effect_voxdelay.h)
+
+#include "effect_voxdelay.h"
+
+#if VOX_DELAY_PSRAM
+EXTMEM int16_t voxDelayPool[vox::Layout<VOX_LAYOUT>::CHANNELS][VOX_DELAY_POOL_SAMPLES];
+#else
+DMAMEM int16_t voxDelayPool[vox::Layout<VOX_LAYOUT>::CHANNELS][VOX_DELAY_POOL_SAMPLES];
+#endif
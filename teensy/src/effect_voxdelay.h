@@ -0,0 +1,55 @@
+// VOX EFX - AudioStream wrapper for the modulated delay (lib/VoxDsp vox_delay.h)
+// The delay line lives in voxDelayPool (effect_voxdelay.cpp), not in
+// AudioMemory blocks: DMAMEM by default, EXTMEM with -DVOX_DELAY_PSRAM=1.
+// Parameter setters are single 32-bit stores, safe to call from loop().
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_config.h"
+#include "vox_delay.h"
+
+// Per-channel slice of the pool, and the pool itself (one slice per channel)
+static const uint32_t VOX_DELAY_POOL_SAMPLES = vox::Delay::poolSamples(VOX_DELAY_MAX_MS);
+extern int16_t voxDelayPool[vox::Layout<VOX_LAYOUT>::CHANNELS][VOX_DELAY_POOL_SAMPLES];
+
+class AudioEffectVoxDelay : public AudioStreamVox {
+public:
+  AudioEffectVoxDelay() : AudioStreamVox(1, inputQueueArray) {}
+
+  // Hand over the ring memory (cleared here); silent until called
+  void begin(int16_t* mem, uint32_t samples) {
+    AudioNoInterrupts();
+    kernel.begin(mem, samples);
+    AudioInterrupts();
+  }
+
+  void time(float ms)                         { kernel.time(ms); }
+  void feedback(float n)                      { kernel.feedback(n); }
+  void tone(float hz)                         { kernel.tone(hz); }
+  void modulation(float rateHz, float depthMs) { kernel.modulation(rateHz, depthMs); }
+  float timeMs() const                        { return kernel.timeMs(); }
+
+  virtual void update(void) {
+    audio_block_t* in = receiveReadOnly(0);
+    audio_block_t* out = allocate();
+    if (!out) {
+      if (in) release(in);
+      return;
+    }
+
+    // No input block = silence in; the repeats keep going
+    kernel.update(in ? in->data : nullptr, out->data);
+
+    transmit(out);
+    release(out);
+    if (in) release(in);
+  }
+
+private:
+  audio_block_t* inputQueueArray[1];
+  vox::Delay kernel;
+};
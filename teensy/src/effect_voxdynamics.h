@@ -0,0 +1,64 @@
+// VOX EFX - AudioStream wrapper for the look-ahead dynamics (lib/VoxDsp vox_dynamics.h)
+// Gate -> compressor -> brickwall limiter on the input, ahead of reverb,
+// delay and the dry path. Bypassed, it forwards the input block untouched.
+// Parameter setters are single 32-bit stores, safe to call from loop().
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_dynamics.h"
+
+class AudioEffectVoxDynamics : public AudioStreamVox {
+public:
+  AudioEffectVoxDynamics() : AudioStreamVox(1, inputQueueArray) {}
+
+  void bypass(bool b)                                     { kernel.bypass(b); }
+  void gate(float thresholdDb, float rangeDb)             { kernel.gate(thresholdDb, rangeDb); }
+  void gateTimes(float openMs, float closeMs)             { kernel.gateTimes(openMs, closeMs); }
+  void compressor(float thresholdDb, float ratio, float makeupDb) { kernel.compressor(thresholdDb, ratio, makeupDb); }
+  void compressorTimes(float attackMs, float releaseMs)   { kernel.compressorTimes(attackMs, releaseMs); }
+  void limiter(float ceilingDb, float releaseMs)          { kernel.limiter(ceilingDb, releaseMs); }
+  void lookahead(float ms)                                { kernel.lookahead(ms); }
+
+  // Read-and-reset of the minimum update() keeps, with interrupts off as
+  // AudioAnalyzePeak::read() does, so a block can't land between the two
+  float takeGainReductionDb() {
+    __disable_irq();
+    const int32_t g = kernel.takeGainReduction();
+    __enable_irq();
+    return vox::Dynamics::gainReductionDb(g);
+  }
+
+  virtual void update(void) {
+    audio_block_t* in = receiveReadOnly(0);
+
+    if (kernel.isBypassed()) {
+      kernel.idle(in ? in->data : nullptr);
+      if (in) {
+        transmit(in);
+        release(in);
+      }
+      return;
+    }
+
+    audio_block_t* out = allocate();
+    if (!out) {
+      if (in) release(in);
+      return;
+    }
+
+    // No input block = silence in; the look-ahead still drains
+    kernel.update(in ? in->data : nullptr, out->data);
+
+    transmit(out);
+    release(out);
+    if (in) release(in);
+  }
+
+private:
+  audio_block_t* inputQueueArray[1];
+  vox::Dynamics kernel;
+};
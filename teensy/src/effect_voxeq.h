@@ -0,0 +1,53 @@
+// VOX EFX - AudioStream wrapper for the 6-band parametric EQ (lib/VoxDsp vox_eq.h)
+// Sits after the dynamics, ahead of reverb, delay and the dry path. setBand()
+// designs the biquad on the caller's side (loop()); the new coefficients are
+// picked up at the next block boundary. With every band flat it forwards the
+// input block untouched.
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_eq.h"
+
+class AudioFilterVoxEq : public AudioStreamVox {
+public:
+  static const int BANDS = vox::Equalizer::BANDS;
+
+  AudioFilterVoxEq() : AudioStreamVox(1, inputQueueArray) {}
+
+  void setBand(int i, const vox::EqBand& b)  { kernel.setBand(i, b); }
+  const vox::EqBand& band(int i) const       { return kernel.band(i); }
+
+  virtual void update(void) {
+    audio_block_t* in = receiveReadOnly(0);
+
+    if (kernel.passthrough()) {
+      if (in) {
+        transmit(in);
+        release(in);
+      }
+      return;
+    }
+
+    audio_block_t* out = allocate();
+    if (!out) {
+      if (in) release(in);
+      return;
+    }
+
+    // No input block = silence in; the filter tails still ring out. Runs
+    // the set passthrough() just switched to
+    kernel.process(in ? in->data : nullptr, out->data);
+
+    transmit(out);
+    release(out);
+    if (in) release(in);
+  }
+
+private:
+  audio_block_t* inputQueueArray[1];
+  vox::Equalizer kernel;
+};
@@ -0,0 +1,42 @@
+// VOX EFX - AudioStream wrapper for the ramped 4-channel mixer (lib/VoxDsp vox_mixer.h)
+// Drop-in for AudioMixer4: same gain() API, but a new gain ramps in over
+// the next blocks instead of jumping, so footswitch toggles don't click.
+// gain() is a single 32-bit store, safe to call from loop().
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_mixer.h"
+
+class AudioMixerVox4 : public AudioStreamVox {
+public:
+  AudioMixerVox4() : AudioStreamVox(4, inputQueueArray) {}
+
+  void gain(unsigned int channel, float level)    { kernel.gain(channel, level); }
+  void ramp(vox::Ramp::Shape s, float ms)         { kernel.ramp(s, ms); }
+
+  virtual void update(void) {
+    audio_block_t* in[4];
+    const int16_t* data[4];
+    for (int ch = 0; ch < 4; ch++) {
+      in[ch] = receiveReadOnly(ch);
+      data[ch] = in[ch] ? in[ch]->data : nullptr;
+    }
+
+    audio_block_t* out = allocate();
+    if (out) {
+      if (kernel.update(data, out->data)) transmit(out);
+      release(out);
+    }
+    for (int ch = 0; ch < 4; ch++) {
+      if (in[ch]) release(in[ch]);
+    }
+  }
+
+private:
+  audio_block_t* inputQueueArray[4];
+  vox::Mixer4 kernel;
+};
@@ -0,0 +1,55 @@
+// VOX EFX - AudioStream wrapper for the block Q15 reverb (lib/VoxDsp vox_reverb.h)
+// Drop-in for AudioEffectFreeverb: same roomsize()/damping() API, same output,
+// less CPU per block. Parameter setters are single 32-bit stores, so they are
+// safe to call from loop() while the audio ISR runs.
+// AudioEffectVoxReverbT<2> has two inputs and two outputs around one shared
+// comb tank (see vox::ReverbTank).
+
+#pragma once
+
+#include <Arduino.h>
+#include <Audio.h>
+
+#include "audio_pool.h"
+#include "vox_reverb.h"
+
+template <int CH>
+class AudioEffectVoxReverbT : public AudioStreamVox {
+public:
+  AudioEffectVoxReverbT() : AudioStreamVox(CH, inputQueueArray) {}
+
+  void roomsize(float n) { kernel.roomsize(n); }
+  void damping(float n)  { kernel.damping(n); }
+
+  virtual void update(void) {
+    audio_block_t* in[CH];
+    audio_block_t* out[CH];
+    const int16_t* src[CH];
+    int16_t* dst[CH];
+
+    bool ok = true;
+    for (int ch = 0; ch < CH; ch++) {
+      in[ch] = receiveReadOnly(ch);
+      out[ch] = allocate();
+      if (!out[ch]) ok = false;
+      src[ch] = in[ch] ? in[ch]->data : nullptr;   // no block = silence in; the tail keeps ringing
+      dst[ch] = out[ch] ? out[ch]->data : nullptr;
+    }
+
+    if (ok) kernel.process(src, dst);
+
+    for (int ch = 0; ch < CH; ch++) {
+      if (out[ch]) {
+        if (ok) transmit(out[ch], ch);
+        release(out[ch]);
+      }
+      if (in[ch]) release(in[ch]);
+    }
+  }
+
+private:
+  audio_block_t* inputQueueArray[CH];
+  vox::ReverbTank<CH> kernel;
+};
+
+typedef AudioEffectVoxReverbT<1> AudioEffectVoxReverb;
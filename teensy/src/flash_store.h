@@ -0,0 +1,47 @@
+// VOX EFX - LogStore backend (lib/VoxDsp vox_log_store.h): 64 KB of the
+// Teensy 4.0's program flash, just below the EEPROM emulation
+// (0x601F0000..), through the same RAM-resident flash routines the core's
+// EEPROM code uses.
+// eepromemu_flash_write() runs with interrupts off until the program is
+// done. W25Q16JV datasheet worst case: 50 us for the first byte plus 12 us
+// per further byte (programMaxUs()), so LogStore's CHUNK is kept small. A
+// sector erase takes tens of milliseconds, which LogStore only does in
+// begin() from setup().
+
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+extern "C" {
+void eepromemu_flash_write(void* addr, const void* data, uint32_t len);
+void eepromemu_flash_erase_sector(void* addr);
+}
+extern unsigned long _flashimagelen;        // linker: bytes of program image
+
+class TeensyFlash {
+public:
+  static const uint32_t FLASH_START = 0x60000000;
+  static const uint32_t BASE   = 0x601E0000;
+  static const uint32_t SIZE   = 0x10000;
+  static const uint32_t SECTOR = 4096;
+  static const uint32_t PAGE   = 256;
+
+  // Datasheet worst case for programming n bytes (tBP1 + (n - 1) * tBP2)
+  static constexpr uint32_t programMaxUs(uint32_t n) { return 50 + (n - 1) * 12; }
+
+  // False when the program image has grown into the region
+  static bool fits() { return FLASH_START + (uint32_t)(uintptr_t)&_flashimagelen <= BASE; }
+
+  void read(uint32_t off, void* dst, uint32_t n) const { memcpy(dst, (const void*)(uintptr_t)(BASE + off), n); }
+
+  void program(uint32_t off, const void* src, uint32_t n) {
+    eepromemu_flash_write((void*)(uintptr_t)(BASE + off), src, n);
+    arm_dcache_delete((void*)(uintptr_t)(BASE + off), n);
+  }
+
+  void erase(uint32_t off) {
+    eepromemu_flash_erase_sector((void*)(uintptr_t)(BASE + off));
+    arm_dcache_delete((void*)(uintptr_t)(BASE + off), SECTOR);
+  }
+};
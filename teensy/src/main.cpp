@@ -1,173 +1,479 @@
-// VOX EFX - MONO REVERB DROP-IN (Teensy 4.0 + Audio Shield Rev D)
-// - Mono path: Line-In Left only
-// - Reverb effect (AudioEffectReverb)
-// - Footswitch toggles Reverb ON/OFF
-// - UART telemetry to ESP32 (Serial4) and header monitor (Serial1)
+// VOX EFX - REVERB DROP-IN (Teensy 4.0 + Audio Shield Rev D)
+// - Channel layout chosen at build time (VOX_LAYOUT, include/vox_config.h):
+//   MONO (default, Line-In Left only), DUAL_MONO or STEREO
+// - Reverb effect (AudioEffectVoxReverb: block Q15 Freeverb, lib/VoxDsp)
+// - Input dynamics (AudioEffectVoxDynamics: gate, compressor, look-ahead limiter)
+// - Delay effect (AudioEffectVoxDelay: modulated, filtered feedback, ring in DMAMEM/PSRAM)
+// - Left footswitch toggles Reverb ON/OFF; hold it to recall the next preset
+// - Right footswitch taps the delay tempo; hold it to toggle Delay ON/OFF
+// - UART telemetry to ESP32 (Serial4, binary frames: shared/VoxLink) and
+//   text lines to the header monitor (Serial1); loop() only queues them,
+//   a timer ISR drains the queues (src/uart_tx.h), so telemetry never blocks
+// - CPU, line: per-node cycles per audio block (min/avg/max + histogram)
+// - BOOT, line (once): microseconds per setup() phase, see sendBoot()
+// - `live` (level, reverb/delay on/off, ...) and the preset slot persist in
+//   a log in spare program flash (src/flash_store.h); STORE, lines
+// - PRE, line: preset recall (vox_preset.h, PRESET_SLOTS in vox_config.h)
+// - MON,GRAPH line (once): node update order and the graph's block need
+// - POOL, line + frame: AudioMemory use, high-water and allocation failures;
+//   a VOX_POOL_CALIBRATE build measures each effect configuration instead
 
 #include <Arduino.h>
 #include <Audio.h>
 #include <math.h>
 
+#include "vox_config.h"
+#include "effect_chain.h"
+#include "vox_tap_tempo.h"
+#include "vox_footswitch.h"
+#include "vox_pool_cal.h"
+#include "vox_log_store.h"
+#include "vox_meter.h"
+#include "vox_link.h"
+#include "vox_boot_trace.h"
+#include "uart_tx.h"
+#include "flash_store.h"
+
 // ===================== Pins =====================
-static const int PIN_STOMP_LEFT = 14;   // Effect ON/OFF (active low)
+static const int PIN_STOMP_LEFT  = 14;  // Effect ON/OFF on release / hold = next preset (active low)
+static const int PIN_STOMP_RIGHT = 15;  // Tap tempo (timed on press) / hold = Delay ON/OFF (active low)
+static const uint32_t STOMP_HOLD_MS = 800;
 
 // ===================== UARTs =====================
-#define ESP_SERIAL Serial4              // to ESP32 (confirmed working for you)
-#define MON_SERIAL Serial1              // header monitor pins 0(RX1),1(TX1)
+#define ESP_UART Serial4                // to ESP32 (confirmed working for you)
+#define MON_UART Serial1                // header monitor pins 0(RX1),1(TX1)
 static const uint32_t MON_BAUD = 115200;
 
-// ===================== Effect settings =====================
-// Reverb "roomsize" is typically 0.0 .. 1.0 (smaller -> subtle, larger -> bigger tail)
-static const float REVERB_ROOMSIZE = 0.55f;
-
-// Mix levels
-static const float WET_LEVEL = 0.35f;   // wet mix when enabled
-
-// ===================== Audio objects (MONO) =====================
-AudioInputI2S            i2sIn;          // SGTL5000 ADC
-AudioEffectFreeverb      reverb;         // mono reverb
-AudioMixer4              mix;            // ch0=wet, ch1=dry
-AudioAmplifier           amp;            // output level
-AudioOutputI2S           i2sOut;         // SGTL5000 DAC
-AudioControlSGTL5000     sgtl5000;
-
-// Peaks (tap points)
-AudioAnalyzePeak         peakIn;
-AudioAnalyzePeak         peakWet;
-AudioAnalyzePeak         peakMix;
-AudioAnalyzePeak         peakOut;
-
-// ===================== Patch cords (MONO) =====================
-// Feed reverb from input (mono left)
-AudioConnection          patchCord1(i2sIn, 0, reverb, 0);
-
-// Tap input peak
-AudioConnection          patchCord2(i2sIn, 0, peakIn, 0);
+// Telemetry never writes the UARTs from loop(): it queues into these, and
+// txTimer drains them into the ports' TX buffers (src/uart_tx.h)
+static UartTx<1024> espTx(ESP_UART);
+static UartTx<4096> monTx(MON_UART);
+#define ESP_SERIAL espTx
+#define MON_SERIAL monTx
+
+static IntervalTimer txTimer;
+static const uint32_t TX_DRAIN_US = 1000;  // 40-byte port buffer lasts ~3.5 ms at 115200
+
+// ===================== AudioMemory =====================
+// VOX_AUDIO_BLOCKS (platformio.ini) sizes the pool. A -DVOX_POOL_CALIBRATE=1
+// build runs with a 200-block pool instead, steps through reverb x delay
+// and prints the high-water mark and a safe VOX_AUDIO_BLOCKS for each
+// (POOL,CAL lines); play into the pedal and leave the footswitches alone
+// while it runs
+#ifndef VOX_AUDIO_BLOCKS
+#define VOX_AUDIO_BLOCKS 80
+#endif
+#ifndef VOX_POOL_CALIBRATE
+#define VOX_POOL_CALIBRATE 0
+#endif
+#if VOX_POOL_CALIBRATE
+#define VOX_POOL_BLOCKS 200                     // large enough never to be the limit
+static const uint32_t POOL_CAL_SETTLE_MS = 2000;   // ramps and delay tails
+static const uint32_t POOL_CAL_WINDOW_MS = 10000;
+static const uint16_t POOL_CAL_MARGIN    = 2;      // blocks on top of the peak
+#else
+#define VOX_POOL_BLOCKS VOX_AUDIO_BLOCKS
+#endif
 
-// Dry path to mixer channel 1
-AudioConnection          patchCord3(i2sIn, 0, mix, 1);
-
-// Wet path to mixer channel 0
-AudioConnection          patchCord4(reverb, 0, mix, 0);
-
-// Tap wet peak from reverb output
-AudioConnection          patchCord5(reverb, 0, peakWet, 0);
-
-// Mixer -> amp -> out (left only)
-AudioConnection          patchCord6(mix, 0, amp, 0);
-AudioConnection          patchCord7(mix, 0, peakMix, 0);
-AudioConnection          patchCord8(amp, 0, peakOut, 0);
-AudioConnection          patchCord9(amp, 0, i2sOut, 0);    // left out only
+// ===================== Effect settings =====================
+// REVERB_ROOMSIZE / REVERB_DAMPING / DRY_LEVEL / WET_LEVEL and the DELAY_* /
+// DYN_* settings live in include/vox_config.h so the host renderer (host/render.cpp)
+// uses the same values. They are preset 0; the pedal runs from `live`, a
+// copy of the last recalled preset that the footswitches and UART then edit.
+
+// ===================== Audio objects =====================
+// src/effect_chain.h: i2sIn -> dyn -> reverb/delay -> mix(ch0=wet, ch1=dry,
+// ch2=delay) -> amp -> i2sOut,
+// with in/wet/mix/out peaks, per channel of the build layout.
+// Profiled<> times each update() per block; see sendCpu()
+typedef EffectChain<VOX_LAYOUT> Chain;
+static const int CH = Chain::CHANNELS;
+static_assert(Chain::BLOCKS <= VOX_POOL_BLOCKS, "AudioMemory is smaller than the chain's block need (vox_chain.h)");
+
+Chain                chain;
+AudioControlSGTL5000 sgtl5000;
 
 // ===================== State =====================
-static bool effectEnabled = false;
-static int  levelPct = 50;     // 0..100
+static vox::link::PresetBank<PRESET_SLOTS> presets;   // presetDefaults() in setup()
+static vox::link::Preset live;                        // the chain's current state
+static int presetSlot = 0;
+static bool presetXfade = false;                      // gain ramps still at PRESET_XFADE_MS
+static uint32_t presetXfadeUs = 0;
+static bool stateDirty = false;                       // live changed since the last save
+static uint32_t stateChangedMs = 0;
+static vox::TapTempo tapTempo;
+static vox::EqBand eqBands[vox::Equalizer::BANDS];   // EQ_BANDS layout, live.eqDb10 gains
 
 static float gDry = 1.0f;
 static float gWet = 0.0f;
 
+// setup() timeline (shared/VoxLink vox_boot_trace.h)
+static vox::link::BootTrace<12> bootTrace;
+static void bootMark(const char* phase) { bootTrace.mark(phase, micros()); }
+
+static void markDirty() {
+  stateDirty = true;
+  stateChangedMs = millis();
+}
+
 static inline float levelToGain(int pct) {
   pct = constrain(pct, 0, 100);
   return (float)pct / 100.0f;
 }
 
 // ===================== Helpers =====================
+static void drainTx() {
+  espTx.drain();
+  monTx.drain();
+}
+
 static void monPrint(const char* s) { MON_SERIAL.print(s); }
 
-static int peakToSegments(float peak) {
-  if (peak <= 0.0001f) return 0;
-  float db = 20.0f * log10f(peak);
-  const float th[8] = {-42, -36, -30, -24, -18, -12, -9, -6};
-  int seg = 0;
-  for (int i = 0; i < 8; i++) if (db >= th[i]) seg = i + 1;
-  return constrain(seg, 0, 8);
+// One binary frame to the ESP32 (shared/VoxLink vox_link.h)
+template <class M>
+static void sendFrame(const M& m) {
+  uint8_t frame[vox::link::MAX_FRAME];
+  size_t n = vox::link::encode(m, frame, sizeof(frame));
+  if (n) ESP_SERIAL.send(frame, n);
+}
+
+// 0.0 .. 65.5 -> 1/1000 for link frames
+static uint16_t toMilli(float v) {
+  if (v <= 0.0f) return 0;
+  if (v >= 65.535f) return 65535;
+  return (uint16_t)(v * 1000.0f + 0.5f);
 }
 
+static constexpr vox::MeterScale<METER_SEGMENTS> meterScale(METER_FLOOR_DB, METER_TOP_DB);
+static_assert(meterScale.threshold(1) > 0.0f && meterScale.threshold(METER_SEGMENTS) < 1.0f,
+              "meter thresholds must lie inside the peak range");
+
 // ===================== Routing control =====================
 static void applyEffectState() {
   // Freeverb parameters
-  reverb.roomsize(REVERB_ROOMSIZE);   // 0.0 .. 1.0
-  reverb.damping(0.5f);               // 0.0 .. 1.0 (higher = darker/less bright)
+  chain.roomsize(live.roomsize);    // 0.0 .. 1.0
+  chain.damping(live.damping);      // 0.0 .. 1.0 (higher = darker/less bright)
+
+  gDry = live.dry;
+  gWet = live.reverbOn ? live.wet : 0.0f;
+
+  // Mixer mapping: ch1 = dry, ch0 = wet, ch2 = delay
+  for (int ch = 0; ch < CH; ch++) {
+    chain.dyn[ch].bypass(!live.dynamicsOn);
+    chain.dyn[ch].gate(live.gateDb, live.gateRangeDb);
+    chain.dyn[ch].compressor(live.compDb, live.compRatio, live.makeupDb);
+    chain.dyn[ch].compressorTimes(live.compAttackMs, live.compReleaseMs);
+    chain.dyn[ch].limiter(live.ceilingDb, live.limitReleaseMs);
+    chain.dyn[ch].lookahead(live.lookaheadMs);
+
+    chain.delay[ch].time(live.delayMs);
+    chain.delay[ch].feedback(live.delayFeedback);
+    chain.delay[ch].tone(live.delayToneHz);
+    chain.delay[ch].modulation(live.delayModHz, live.delayModMs);
+
+    chain.mix[ch].gain(1, gDry);
+    chain.mix[ch].gain(0, gWet);
+    chain.mix[ch].gain(2, live.delayOn ? live.delayLevel : 0.0f);
+    chain.mix[ch].gain(3, 0.0f);
+
+    chain.amp[ch].gain(levelToGain(live.level));
+  }
+}
 
-  gDry = 1.0f;
-  gWet = effectEnabled ? WET_LEVEL : 0.0f;
 
-  // Mixer mapping: ch1 = dry, ch0 = wet
-  mix.gain(1, gDry);
-  mix.gain(0, gWet);
-  mix.gain(2, 0.0f);
-  mix.gain(3, 0.0f);
+// Designs the biquad here in loop(); the audio ISR swaps it in at the
+// next block boundary
+static void applyEqBand(int band) {
+  for (int ch = 0; ch < CH; ch++) chain.eq[ch].setBand(band, eqBands[band]);
+}
 
-  amp.gain(levelToGain(levelPct));
+// EQ,<band>,<gain dB>
+static void sendEq(int band) {
+  MON_SERIAL.print("EQ,");
+  MON_SERIAL.print(band);
+  MON_SERIAL.print(",");
+  MON_SERIAL.print(eqBands[band].gainDb, 1);
+  MON_SERIAL.print("\n");
 }
 
+static void setEqGain(int band, float db) {
+  if (band < 0 || band >= vox::Equalizer::BANDS) return;
+  eqBands[band].gainDb = constrain(db, -EQ_GAIN_MAX_DB, EQ_GAIN_MAX_DB);
+  live.eqDb10[band] = (int16_t)lroundf(eqBands[band].gainDb * 10.0f);
+  applyEqBand(band);
+  sendEq(band);
+  markDirty();
+}
+
+// REV,<0|1>
+static void sendReverb() {
+  vox::link::ReverbState rev;
+  rev.on = live.reverbOn;
+  sendFrame(rev);
+
+  MON_SERIAL.print("REV,");
+  MON_SERIAL.print(live.reverbOn ? 1 : 0);
+  MON_SERIAL.print("\n");
+}
 
 static void toggleEffect() {
-  effectEnabled = !effectEnabled;
+  live.reverbOn = !live.reverbOn;
   applyEffectState();
+  sendReverb();
+  markDirty();
+}
 
-  ESP_SERIAL.print("REV,");
-  ESP_SERIAL.print(effectEnabled ? 1 : 0);
-  ESP_SERIAL.print("\n");
+// DLY,<0|1>,<ms>
+static void sendDelay() {
+  int ms = (int)(chain.delay[0].timeMs() + 0.5f);
 
-  MON_SERIAL.print("REV,");
-  MON_SERIAL.print(effectEnabled ? 1 : 0);
+  vox::link::DelayState dly;
+  dly.on = live.delayOn;
+  dly.ms = (uint16_t)ms;
+  sendFrame(dly);
+
+  MON_SERIAL.print("DLY,");
+  MON_SERIAL.print(live.delayOn ? 1 : 0);
+  MON_SERIAL.print(",");
+  MON_SERIAL.print(ms);
   MON_SERIAL.print("\n");
 }
 
+static void toggleDelay() {
+  live.delayOn = !live.delayOn;
+  applyEffectState();
+  sendDelay();
+  markDirty();
+}
+
+// Right footswitch: the tap is timed on the press (tapTempo), the delay
+// re-timed on release once the press is known not to be a hold
+static bool tapPending = false;
+
+static void tapDelayPress(uint32_t pressMs) {
+  tapPending = tapTempo.tap(pressMs);
+}
+
+static void tapDelayCancel() {
+  tapTempo.untap();
+  tapPending = false;
+}
+
+static void tapDelayTempo() {
+  if (!tapPending) return;
+  tapPending = false;
+  live.delayMs = (float)tapTempo.periodMs() * DELAY_TAP_SUBDIV;
+  for (int ch = 0; ch < CH; ch++) chain.delay[ch].time(live.delayMs);   // glides there
+  sendDelay();
+  markDirty();
+}
+
 static void sendLevel() {
-  ESP_SERIAL.print("LVL,");
-  ESP_SERIAL.print(levelPct);
-  ESP_SERIAL.print("\n");
+  vox::link::Level lvl;
+  lvl.pct = live.level;
+  sendFrame(lvl);
 
   MON_SERIAL.print("LVL,");
-  MON_SERIAL.print(levelPct);
+  MON_SERIAL.print(live.level);
   MON_SERIAL.print("\n");
 }
 
 static void applyLevel(int pct) {
   pct = constrain(pct, 0, 100);
-  if (pct == levelPct) return;
-  levelPct = pct;
+  if (pct == live.level) return;
+  live.level = (uint8_t)pct;
 
-  amp.gain(levelToGain(levelPct));
+  for (int ch = 0; ch < CH; ch++) chain.amp[ch].gain(levelToGain(live.level));
   sendLevel();
+  markDirty();
 }
 
-// ===================== UART RX (VOL,<0-100>) from ESP32 =====================
-static void pollUart() {
-  static char line[64];
-  static size_t n = 0;
-
-  while (ESP_SERIAL.available()) {
-    char c = (char)ESP_SERIAL.read();
-    if (c == '\r') continue;
-
-    if (c == '\n') {
-      line[n] = '\0';
-      if (n > 0 && strncmp(line, "VOL", 3) == 0) {
-        const char* p = line + 3;
-        while (*p && (*p == ',' || *p == ':' || *p == ' ')) p++;
-        applyLevel(atoi(p));
-      }
-      n = 0;
-    } else {
-      if (n < sizeof(line) - 1) line[n++] = c;
-      else n = 0;
+// ===================== Presets =====================
+// Recall copies the slot into `live` whole, then applies it with the audio
+// update held off (AudioNoInterrupts): each setter is a store the ISR picks
+// up at its next update(), so the whole preset lands on one block boundary,
+// at most a block after the footswitch. Mixer gains ramp over
+// PRESET_XFADE_MS rather than GAIN_RAMP_MS, so the old reverb and delay
+// tails fade out under the new mix instead of being cut; the tank and the
+// delay lines are never cleared, and a new delay time glides as a tap does.
+static const uint32_t PRESET_LATCH_US = (uint32_t)(2.0f * vox::BLOCK_SECONDS * 1e6f);
+
+// Applies `live` as one change; returns how long the audio update was held off
+static uint32_t applyLive() {
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) eqBands[b].gainDb = live.eqDb10[b] * 0.1f;
+
+  const uint32_t t0 = micros();
+  AudioNoInterrupts();
+  chain.gainRamp(vox::Ramp::LINEAR, PRESET_XFADE_MS);
+  applyEffectState();
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) applyEqBand(b);
+  AudioInterrupts();
+  const uint32_t held = micros() - t0;
+  presetXfade = true;
+  presetXfadeUs = micros();
+  return held;
+}
+
+// State frames, then PRE,<slot>,<name>,US=<time the audio update was held off>[,RESTORED]
+static void sendPreset(uint32_t heldUs, bool restored) {
+  sendReverb();
+  sendDelay();
+  sendLevel();
+  char name[vox::link::PRESET_NAME + 1];
+  memcpy(name, live.name, vox::link::PRESET_NAME);
+  name[vox::link::PRESET_NAME] = '\0';
+  char line[64];
+  int n = snprintf(line, sizeof(line), "PRE,%d,%s,US=%lu%s\n", presetSlot, name, (unsigned long)heldUs,
+                   restored ? ",RESTORED" : "");
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+static void recallPreset(int slot) {
+  const vox::link::Preset* p = presets.get(slot);
+  if (!p) {
+    char line[32];
+    int n = snprintf(line, sizeof(line), "PRE,%d,INVALID\n", slot);
+    if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+    return;
+  }
+  live = *p;
+  presetSlot = slot;
+  sendPreset(applyLive(), false);
+  markDirty();
+}
+
+// The ramps take their length when they first see the new targets, the
+// block after recall; from then on toggles and level ramp as usual again
+static void pollPresetXfade() {
+  if (!presetXfade || micros() - presetXfadeUs < PRESET_LATCH_US) return;
+  presetXfade = false;
+  chain.gainRamp(vox::Ramp::LINEAR, GAIN_RAMP_MS);
+}
+
+// ===================== Persistence =====================
+// `live` and the preset slot survive power cycles as one KEY_STATE record
+// in the flash log (vox_log_store.h, src/flash_store.h). A change is saved
+// once nothing else has changed for SAVE_IDLE_MS, so a level sweep is one
+// record; pollStore() then programs LogStore::CHUNK bytes per loop() and
+// never runs from the audio ISR. Boot compacts the log unless at least
+// STORE_MIN_FREE bytes are left, so a session always starts with room for
+// hundreds of saves; should it fill anyway, STORE,FULL is sent once.
+typedef vox::LogStore<TeensyFlash> Store;
+static TeensyFlash flash;
+static Store store(flash);
+static bool storeOk = false;             // program image ends below the region
+static uint32_t storePollMaxUs = 0;
+
+static const uint32_t SAVE_IDLE_MS = 2000;
+static const uint8_t  KEY_STATE = 1;
+
+struct __attribute__((packed)) SavedState {
+  uint8_t slot;
+  vox::link::PresetRecord live;          // sealed: version and CRC checked on restore
+};
+static_assert(sizeof(SavedState) <= Store::MAX_PAYLOAD, "SavedState must fit one log record");
+
+static const uint32_t STORE_MIN_FREE = Store::BANK / 2;
+
+// Longest a poll() may hold up loop(), interrupts off included; POLL_US in
+// the STORE line is the measured maximum
+static const uint32_t STORE_POLL_BUDGET_US = 100;
+static_assert(TeensyFlash::programMaxUs(Store::CHUNK) < STORE_POLL_BUDGET_US, "one chunk must program within the budget");
+static_assert(STORE_MIN_FREE / Store::recordSize(sizeof(SavedState)) >= 100, "boot leaves room for 100+ saves");
+
+// STORE,BANK=<0|1>,SEQ=<n>,USED=<bytes>,REC=<n>,TORN=<0|1>,COMPACT=<0|1>,SAVED=<n>,FULL=<n>,POLL_US=<max>
+// (STORE,OFF when the program image reaches into the region)
+// STORE,FULL,USED=<bytes>,BANK=<bytes> (once, on the first save refused for
+// lack of room: settings stop persisting until a reboot compacts)
+static void sendStoreFull() {
+  char line[64];
+  int n = snprintf(line, sizeof(line), "STORE,FULL,USED=%lu,BANK=%lu\n", (unsigned long)store.stats().used,
+                   (unsigned long)Store::BANK);
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+static void sendStore() {
+  char line[128];
+  const Store::Stats& st = store.stats();
+  int n = storeOk
+              ? snprintf(line, sizeof(line), "STORE,BANK=%u,SEQ=%lu,USED=%lu,REC=%u,TORN=%d,COMPACT=%d,SAVED=%lu,FULL=%lu,POLL_US=%lu\n",
+                         (unsigned)st.bank, (unsigned long)st.seq, (unsigned long)st.used, (unsigned)st.records,
+                         st.torn ? 1 : 0, st.compacted ? 1 : 0, (unsigned long)st.saved, (unsigned long)st.full,
+                         (unsigned long)storePollMaxUs)
+              : snprintf(line, sizeof(line), "STORE,OFF\n");
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+static void pollStore(uint32_t now) {
+  if (!storeOk) return;
+  if (stateDirty && !store.busy() && now - stateChangedMs >= SAVE_IDLE_MS) {
+    SavedState s;
+    s.slot = (uint8_t)presetSlot;
+    s.live.seal(live);
+    stateDirty = false;
+    if (!store.put(KEY_STATE, &s, sizeof(s))) {              // log full: FULL counts it until a reboot
+      if (store.stats().full == 1) sendStoreFull();
+      sendStore();
     }
   }
+  if (!store.busy()) return;
+
+  const uint32_t t0 = micros();
+  const bool more = store.poll();
+  const uint32_t us = micros() - t0;
+  if (us > storePollMaxUs) storePollMaxUs = us;
+  if (!more) sendStore();
 }
 
-// ===================== Debounce =====================
-static bool fallingEdgeDebounced(int pin, uint32_t &lastMs, uint32_t debounceMs = 200) {
-  static uint8_t lastState = HIGH;
-  uint8_t nowState = digitalRead(pin);
-  uint32_t now = millis();
+// Boot: the state saved last, else preset 0
+static void restoreState() {
+  SavedState s;
+  if (!storeOk || !store.get(KEY_STATE, &s, sizeof(s)) || !s.live.valid() || s.slot >= PRESET_SLOTS) {
+    recallPreset(0);
+    stateDirty = false;
+    return;
+  }
+  live = s.live.body;
+  presetSlot = s.slot;
+  sendPreset(applyLive(), true);
+}
+
+// ===================== UART RX (SET_LEVEL / SET_EQ frames) from ESP32 =====================
+// The ESP32 UI has no level or EQ control yet, so nothing sends these frames
+static vox::link::Decoder linkRx;
+
+static void pollUart() {
+  while (ESP_UART.available()) {
+    if (!linkRx.push((uint8_t)ESP_UART.read())) continue;
+
+    vox::link::SetLevel lvl;
+    vox::link::SetEq eq;
+    if (vox::link::decode(linkRx, lvl)) {
+      applyLevel(lvl.pct);
+    } else if (vox::link::decode(linkRx, eq)) {
+      setEqGain(eq.band, eq.gainDb10 * 0.1f);
+    }
+  }
+}
 
-  bool edge = (lastState == HIGH && nowState == LOW && (now - lastMs) > debounceMs);
-  if (edge) lastMs = now;
-  lastState = nowState;
-  return edge;
+// ===================== Footswitches =====================
+// One state machine per footswitch (vox_footswitch.h): short-press actions
+// run on release (TAP), so a hold only runs its own action
+static vox::Footswitch stompLeft(STOMP_HOLD_MS);
+static vox::Footswitch stompRight(STOMP_HOLD_MS);
+
+static void pollFootswitches(uint32_t now) {
+  switch (stompLeft.update(digitalRead(PIN_STOMP_LEFT) == LOW, now)) {
+    case vox::Footswitch::TAP:  toggleEffect(); break;
+    case vox::Footswitch::HOLD: recallPreset((presetSlot + 1) % PRESET_SLOTS); break;   // the preset decides reverb on/off
+    default: break;
+  }
+  switch (stompRight.update(digitalRead(PIN_STOMP_RIGHT) == LOW, now)) {
+    case vox::Footswitch::PRESS: tapDelayPress(stompRight.pressedMs()); break;
+    case vox::Footswitch::TAP:   tapDelayTempo(); break;
+    case vox::Footswitch::HOLD:  tapDelayCancel(); toggleDelay(); break;   // a hold is not a tap
+    default: break;
+  }
 }
 
 // ===================== Metering =====================
@@ -177,89 +483,290 @@ static const uint32_t METER_PERIOD_MS = 50;  // 20 Hz
 static uint32_t lastDbgMs = 0;
 static const uint32_t DBG_PERIOD_MS = 250;   // 4 Hz
 
-static void sendMeters() {
-  float inPk  = peakIn.available()  ? peakIn.read()  : 0.0f;
-  float outPk = peakOut.available() ? peakOut.read() : 0.0f;
+// Loudest channel of a tap; taps with no new block read as 0
+static float readPeak(Profiled<AudioAnalyzePeak>* taps) {
+  float pk = 0.0f;
+  for (int ch = 0; ch < CH; ch++) {
+    float v = taps[ch].available() ? taps[ch].read() : 0.0f;
+    if (v > pk) pk = v;
+  }
+  return pk;
+}
 
-  int inSeg  = peakToSegments(inPk);
-  int outSeg = peakToSegments(outPk);
+static void sendMeters() {
+  const float pk[2] = { readPeak(chain.peakIn), readPeak(chain.peakOut) };
+  uint8_t seg[2];
+  meterScale.segments(pk, seg, 2);
 
-  ESP_SERIAL.print("MTR,");
-  ESP_SERIAL.print(inSeg);
-  ESP_SERIAL.print(",");
-  ESP_SERIAL.print(outSeg);
-  ESP_SERIAL.print("\n");
+  vox::link::Meter mtr;
+  mtr.in = seg[0];
+  mtr.out = seg[1];
+  sendFrame(mtr);
 
   MON_SERIAL.print("MTR,");
-  MON_SERIAL.print(inSeg);
+  MON_SERIAL.print(seg[0]);
   MON_SERIAL.print(",");
-  MON_SERIAL.print(outSeg);
+  MON_SERIAL.print(seg[1]);
   MON_SERIAL.print("\n");
 }
 
+// CPU,BUD=<cycles/block>,<node>=<min>/<avg>/<max>/<h0>:..:<h7>,...,ALL=<max %>
+// Cycles per update() since the last report. Histogram bins are shares of the
+// block budget: <1% <2% <5% <10% <20% <50% <100% >=100% (deadline miss).
+static size_t fmtCpu(char* p, size_t room, const char* name, const vox::CpuStats::Snapshot& s) {
+  const uint16_t* h = s.hist;
+  int n = snprintf(p, room, ",%s=%lu/%lu/%lu/%u:%u:%u:%u:%u:%u:%u:%u", name,
+                   (unsigned long)s.min, (unsigned long)s.avg(), (unsigned long)s.max,
+                   h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+  return (n > 0 && (size_t)n < room) ? (size_t)n : 0;
+}
+
+// One window for all copies of a node (per-channel instances): min/max over
+// every copy, avg per copy update
+template <class Node, int N>
+static void takeCpu(NodeSlots<Node, N>& nodes, vox::CpuStats::Snapshot& out) {
+  nodes[0].takeCpu(out);
+  for (int i = 1; i < N; i++) {
+    vox::CpuStats::Snapshot s;
+    nodes[i].takeCpu(s);
+    out.merge(s);
+  }
+}
+
+static void sendCpu() {
+  static const int NODES = 10;
+  static const char* const NAMES[NODES] = { "DYN", "EQ", "RV", "DLY", "MX", "AMP", "PKI", "PKW", "PKM", "PKO" };
+  static_assert(NODES <= vox::link::Cpu::MAX_NODES, "CPU frame holds MAX_NODES nodes");
+  vox::CpuStats::Snapshot snap[NODES];
+  takeCpu(chain.dyn, snap[0]);
+  takeCpu(chain.eq, snap[1]);
+  takeCpu(chain.reverb.unit, snap[2]);
+  takeCpu(chain.delay, snap[3]);
+  takeCpu(chain.mix, snap[4]);
+  takeCpu(chain.amp, snap[5]);
+  takeCpu(chain.peakIn, snap[6]);
+  takeCpu(chain.peakWet, snap[7]);
+  takeCpu(chain.peakMix, snap[8]);
+  takeCpu(chain.peakOut, snap[9]);
+
+  const uint32_t budget = chain.mix[0].cpu.budget();
+  const unsigned all = (unsigned)AudioProcessorUsageMax();
+  AudioProcessorUsageMaxReset();
+
+  // Binary to the ESP32: shares of the budget, saturating 8-bit histogram
+  vox::link::Cpu cpu;
+  cpu.allPct = (uint8_t)(all > 255 ? 255 : all);
+  cpu.count = NODES;
+  for (int i = 0; i < NODES; i++) {
+    vox::link::Cpu::Node& nd = cpu.node[i];
+    const char* name = NAMES[i];
+    for (int c = 0; c < 3; c++) nd.name[c] = *name ? *name++ : ' ';
+    nd.min = vox::link::Cpu::share(snap[i].min, budget);
+    nd.avg = vox::link::Cpu::share(snap[i].avg(), budget);
+    nd.max = vox::link::Cpu::share(snap[i].max, budget);
+    for (int b = 0; b < vox::link::Cpu::BINS; b++) nd.hist[b] = (uint8_t)(snap[i].hist[b] > 255 ? 255 : snap[i].hist[b]);
+  }
+  sendFrame(cpu);
+
+  // Text, cycles, to the header monitor
+  char line[640];
+  size_t n = snprintf(line, sizeof(line), "CPU,BUD=%lu", (unsigned long)budget);
+  for (int i = 0; i < NODES; i++) n += fmtCpu(line + n, sizeof(line) - n, NAMES[i], snap[i]);
+  int tail = snprintf(line + n, sizeof(line) - n, ",ALL=%u\n", all);
+  if (tail > 0 && (size_t)tail < sizeof(line) - n) n += tail;
+
+  MON_SERIAL.write((const uint8_t*)line, n);
+}
+
+// TX,ESP=<records>/<dropped>/<high-water bytes>,MON=... (header monitor only)
+static void sendTx() {
+  char line[96];
+  int n = snprintf(line, sizeof(line), "TX,ESP=%lu/%lu/%lu,MON=%lu/%lu/%lu\n",
+                   (unsigned long)espTx.stats().records, (unsigned long)espTx.stats().dropped,
+                   (unsigned long)espTx.stats().highWater,
+                   (unsigned long)monTx.stats().records, (unsigned long)monTx.stats().dropped,
+                   (unsigned long)monTx.stats().highWater);
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+// BOOT,TEENSY,T0=<us before setup()>,<phase>=<us>,...,TOTAL=<us> (header monitor)
+static void sendBoot() {
+  char line[256];
+  size_t n = bootTrace.format(line, sizeof(line), "TEENSY");
+  MON_SERIAL.write((const uint8_t*)line, n);
+}
+
+// MON,GRAPH=<node>>...,BLOCKS=<n>,UNORDERED=<n>: AudioStream update order
+// from vox_chain.h; BLOCKS is the chain's minimum AudioMemory, UNORDERED the
+// same for the nodes in declaration order
+static void sendGraph() {
+  char line[128];
+  size_t n = snprintf(line, sizeof(line), "MON,GRAPH=");
+  for (int i = 0; i < vox::chain::NODES && n < sizeof(line); i++) {
+    int w = snprintf(line + n, sizeof(line) - n, "%s%s", i ? ">" : "", vox::chain::INFO[vox::chain::ORDER.order[i]].name);
+    if (w > 0) n += w;
+  }
+  if (n < sizeof(line)) {
+    snprintf(line + n, sizeof(line) - n, ",BLOCKS=%d,UNORDERED=%d\n", Chain::BLOCKS,
+             vox::chain::blocks(CH, vox::chain::DECLARED_BLOCKS_PER_CHANNEL));
+  }
+  MON_SERIAL.print(line);
+}
+
+// POOL,CAP=<blocks>,USE=<now>,MAX=<high-water>,FAIL=<allocate() failures>
+static void sendPool() {
+  vox::link::Pool pool;
+  pool.capacity = VOX_POOL_BLOCKS;
+  pool.used = AudioMemoryUsage();
+  pool.usedMax = AudioMemoryUsageMax();
+  pool.failures = AudioStreamVox::allocFailures();
+  sendFrame(pool);
+
+  char line[80];
+  int n = snprintf(line, sizeof(line), "POOL,CAP=%u,USE=%u,MAX=%u,FAIL=%lu\n",
+                   (unsigned)pool.capacity, (unsigned)pool.used, (unsigned)pool.usedMax,
+                   (unsigned long)pool.failures);
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+#if VOX_POOL_CALIBRATE
+static vox::PoolCalibration poolCal;
+static uint32_t poolCalFailures = 0;    // allocFailures() at the window start
+
+// POOL,CAL,<layout>,REV=<0|1>,DLY=<0|1>,PEAK=<blocks>,SAFE=<blocks>,FAIL=<n>
+// then POOL,CAL,<layout>,DONE,SAFE=<blocks for every configuration>
+static void pollPoolCal(uint32_t now) {
+  char line[96];
+  int n = 0;
+  switch (poolCal.poll(now, AudioMemoryUsageMax())) {
+    case vox::PoolCalibration::APPLY:
+      live.reverbOn = poolCal.reverb();
+      live.delayOn = poolCal.delay();
+      applyEffectState();
+      break;
+    case vox::PoolCalibration::RESET_PEAK:
+      AudioMemoryUsageMaxReset();
+      poolCalFailures = AudioStreamVox::allocFailures();
+      break;
+    case vox::PoolCalibration::MEASURED: {
+      const int c = poolCal.config();
+      n = snprintf(line, sizeof(line), "POOL,CAL,%s,REV=%d,DLY=%d,PEAK=%u,SAFE=%u,FAIL=%lu\n",
+                   vox::Layout<VOX_LAYOUT>::name(), poolCal.reverb() ? 1 : 0, poolCal.delay() ? 1 : 0,
+                   (unsigned)poolCal.peak(c), (unsigned)poolCal.safe(c),
+                   (unsigned long)(AudioStreamVox::allocFailures() - poolCalFailures));
+      break;
+    }
+    case vox::PoolCalibration::DONE:
+      n = snprintf(line, sizeof(line), "POOL,CAL,%s,DONE,SAFE=%u\n",
+                   vox::Layout<VOX_LAYOUT>::name(), (unsigned)poolCal.safeAll());
+      break;
+    default:
+      break;
+  }
+  if (n > 0) MON_SERIAL.write((const uint8_t*)line, (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+#endif
+
 static void sendDbg() {
-  float pki = peakIn.available()  ? peakIn.read()  : 0.0f;
-  float pkw = peakWet.available() ? peakWet.read() : 0.0f;
-  float pkm = peakMix.available() ? peakMix.read() : 0.0f;
-  float pko = peakOut.available() ? peakOut.read() : 0.0f;
-
-  ESP_SERIAL.print("DBG,");
-  ESP_SERIAL.print("DRY="); ESP_SERIAL.print(gDry, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("WET="); ESP_SERIAL.print(gWet, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("RV=");  ESP_SERIAL.print(REVERB_ROOMSIZE, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("PKI="); ESP_SERIAL.print(pki, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("PKW="); ESP_SERIAL.print(pkw, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("PKM="); ESP_SERIAL.print(pkm, 2); ESP_SERIAL.print(",");
-  ESP_SERIAL.print("PKO="); ESP_SERIAL.print(pko, 2);
-  ESP_SERIAL.print("\n");
+  float pki = readPeak(chain.peakIn);
+  float pkw = readPeak(chain.peakWet);
+  float pkm = readPeak(chain.peakMix);
+  float pko = readPeak(chain.peakOut);
+
+  // Deepest dynamics gain reduction over all channels (dB, <= 0)
+  float gr = 0.0f;
+  for (int ch = 0; ch < CH; ch++) {
+    float g = chain.dyn[ch].takeGainReductionDb();
+    if (g < gr) gr = g;
+  }
+
+  vox::link::Debug dbg;
+  dbg.dry    = toMilli(gDry);
+  dbg.wet    = toMilli(gWet);
+  dbg.room   = toMilli(live.roomsize);
+  dbg.pkIn   = toMilli(pki);
+  dbg.pkWet  = toMilli(pkw);
+  dbg.pkMix  = toMilli(pkm);
+  dbg.pkOut  = toMilli(pko);
+  dbg.grDb10 = (int16_t)(gr * 10.0f - 0.5f);
+  sendFrame(dbg);
 
   MON_SERIAL.print("DBG,");
   MON_SERIAL.print("DRY="); MON_SERIAL.print(gDry, 2); MON_SERIAL.print(",");
   MON_SERIAL.print("WET="); MON_SERIAL.print(gWet, 2); MON_SERIAL.print(",");
-  MON_SERIAL.print("RV=");  MON_SERIAL.print(REVERB_ROOMSIZE, 2); MON_SERIAL.print(",");
+  MON_SERIAL.print("RV=");  MON_SERIAL.print(live.roomsize, 2); MON_SERIAL.print(",");
   MON_SERIAL.print("PKI="); MON_SERIAL.print(pki, 2); MON_SERIAL.print(",");
   MON_SERIAL.print("PKW="); MON_SERIAL.print(pkw, 2); MON_SERIAL.print(",");
   MON_SERIAL.print("PKM="); MON_SERIAL.print(pkm, 2); MON_SERIAL.print(",");
-  MON_SERIAL.print("PKO="); MON_SERIAL.print(pko, 2);
+  MON_SERIAL.print("PKO="); MON_SERIAL.print(pko, 2); MON_SERIAL.print(",");
+  MON_SERIAL.print("GR=");  MON_SERIAL.print(gr, 1);
   MON_SERIAL.print("\n");
+
+  sendCpu();
+  sendTx();
+  sendPool();
 }
 
 // ===================== Setup / Loop =====================
 void setup() {
+  bootTrace.begin(micros());
   pinMode(PIN_STOMP_LEFT, INPUT_PULLUP);
+  pinMode(PIN_STOMP_RIGHT, INPUT_PULLUP);
 
-  ESP_SERIAL.begin(115200);
-  MON_SERIAL.begin(MON_BAUD);
+  ESP_UART.begin(115200);
+  MON_UART.begin(MON_BAUD);
+  txTimer.priority(224);              // below audio and the UART's own interrupt
+  txTimer.begin(drainTx, TX_DRAIN_US);
   MON_SERIAL.print("MON,BOOT\n");
+  MON_SERIAL.print("MON,LAYOUT=");
+  MON_SERIAL.print(vox::Layout<VOX_LAYOUT>::name());
+  MON_SERIAL.print("\n");
+  sendGraph();
+  bootMark("uart");
 
-  AudioMemory(80);
+  storeOk = TeensyFlash::fits();
+  if (storeOk) store.begin(STORE_MIN_FREE);   // may compact: tens of ms per erased sector
+  bootMark("store");
+  sendStore();
+
+  AudioMemory(VOX_POOL_BLOCKS);
+  bootMark("AudioMemory");
+  chain.beginDelay();   // delay lines come from voxDelayPool, not AudioMemory
+  bootMark("beginDelay");
 
   // Codec init
   sgtl5000.enable();
+  bootMark("sgtl5000.enable");
   sgtl5000.volume(0.6f);
 
   // External mic pre -> LINE IN
   sgtl5000.inputSelect(AUDIO_INPUT_LINEIN);
   sgtl5000.lineInLevel(0);
   sgtl5000.lineOutLevel(13);
+  bootMark("codec");
 
-  // Start with effect OFF (dry only)
-  effectEnabled = false;
-  applyEffectState();
+  // EQ panel layout (the gains come with each preset) and the preset bank
+  for (int b = 0; b < vox::Equalizer::BANDS; b++) eqBands[b] = EQ_BANDS[b];
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) presets.store(slot, presetDefaults(slot));
+  bootMark("presets");
 
-  sendLevel();
-  ESP_SERIAL.print("REV,0\n");
+  // Last saved state, or preset 0 (effects OFF, dry only); sends the state frames
+  restoreState();
+  bootMark("restore");
+  sendBoot();
+
+#if VOX_POOL_CALIBRATE
+  poolCal.begin(millis(), POOL_CAL_SETTLE_MS, POOL_CAL_WINDOW_MS, POOL_CAL_MARGIN);
+#endif
 }
 
 void loop() {
   pollUart();
 
-  static uint32_t lastLeftMs = 0;
-  if (fallingEdgeDebounced(PIN_STOMP_LEFT, lastLeftMs)) {
-    toggleEffect();
-  }
-
   uint32_t now = millis();
+  pollFootswitches(now);
+  pollPresetXfade();
+  pollStore(now);
 
   if (now - lastMeterMs >= METER_PERIOD_MS) {
     lastMeterMs = now;
@@ -269,4 +776,7 @@ void loop() {
     lastDbgMs = now;
     sendDbg();
   }
+#if VOX_POOL_CALIBRATE
+  pollPoolCal(now);
+#endif
 }
@@ -0,0 +1,75 @@
+// VOX EFX - non-blocking UART transmit for telemetry
+// - loop() writes into a TxRing (shared/VoxLink vox_tx_ring.h) and returns
+//   at once; a low-priority timer ISR moves records into the port's own
+//   interrupt-driven TX buffer, never more than availableForWrite(), so
+//   neither side ever blocks on the UART
+// - Text (print()) is gathered into lines and queued a line at a time;
+//   send() queues a binary frame as one record
+// - When the ring is full the oldest records go first (TxRing counters)
+
+#pragma once
+
+#include <Arduino.h>
+
+#include "vox_tx_ring.h"
+
+template <uint32_t N>
+class UartTx : public Print {
+public:
+  typedef vox::link::TxRing<N> Ring;
+
+  explicit UartTx(HardwareSerial& p) : port(p) {}
+
+  // Text: queued when a line ends (or the line buffer fills)
+  virtual size_t write(uint8_t b) { return write(&b, 1); }
+  virtual size_t write(const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      line[lineLen++] = p[i];
+      if (p[i] == '\n' || lineLen == sizeof(line)) commitLine();
+    }
+    return n;
+  }
+  using Print::write;
+
+  // Binary frame, one record (after any pending text)
+  void send(const uint8_t* p, size_t n) {
+    commitLine();
+    ring.push(p, n);
+  }
+
+  // ISR side: feed the port without ever waiting on it
+  void drain() {
+    for (;;) {
+      if (chunkPos == chunkLen) {
+        chunkLen = ring.pop(chunk);
+        chunkPos = 0;
+        if (chunkLen == 0) return;
+      }
+      int room = port.availableForWrite();
+      if (room <= 0) return;
+      size_t k = chunkLen - chunkPos;
+      if (k > (size_t)room) k = (size_t)room;
+      port.write(chunk + chunkPos, k);
+      chunkPos += k;
+    }
+  }
+
+  const Ring& stats() const { return ring; }
+
+private:
+  void commitLine() {
+    if (lineLen == 0) return;
+    ring.push(line, lineLen);
+    lineLen = 0;
+  }
+
+  HardwareSerial& port;
+  Ring ring;
+
+  uint8_t line[Ring::RECORD_MAX];          // loop() side
+  size_t  lineLen = 0;
+
+  uint8_t chunk[Ring::RECORD_MAX];         // ISR side: record being sent
+  size_t  chunkLen = 0;
+  size_t  chunkPos = 0;
+};
@@ -0,0 +1,65 @@
+// VOX EFX - host tests for the kernel benchmark harness (vox_bench.h)
+// Run: pio test -e native -f native/test_bench
+
+#include <unity.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vox_bench.h"
+
+using namespace vox::bench;
+
+// The empty block (measured first, RUNS times) costs 1000 ticks, every
+// kernel block 1000 + 256
+struct StepTimer {
+  int calls = 0;
+  void start() {}
+  uint32_t stop() { return calls++ < RUNS ? 1000 : 1256; }
+};
+
+static Suite* suite;
+static char rows[KERNELS + 1][128];
+static int nRows;
+
+static void collect(const char* line) {
+  if (nRows <= KERNELS) snprintf(rows[nRows++], sizeof(rows[0]), "%s", line);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_every_kernel_named_and_runs(void) {
+  for (int k = 0; k < KERNELS; k++) {
+    TEST_ASSERT_TRUE(strcmp(name(k), "?") != 0);
+    for (int i = 0; i < 8; i++) {
+      suite->prepare(k);
+      suite->run(k);
+    }
+  }
+  TEST_ASSERT_EQUAL_STRING("?", name(KERNELS));
+}
+
+// Header, then one row per kernel with the overhead taken off
+void test_rows_subtract_overhead(void) {
+  StepTimer t;
+  nRows = 0;
+  runAll(*suite, t, "abc123", "cyc", collect);
+  TEST_ASSERT_EQUAL_INT(KERNELS, nRows);                  // NONE has no row
+  TEST_ASSERT_EQUAL_STRING(HEADER, rows[0]);
+  TEST_ASSERT_EQUAL_STRING("abc123,peak,512,256,256,256,cyc,2.00", rows[1]);
+  TEST_ASSERT_EQUAL_STRING("abc123,dynamics,512,256,256,256,cyc,2.00", rows[KERNELS - 1]);
+  TEST_ASSERT_EQUAL_INT(RUNS * KERNELS, t.calls);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  suite = new Suite();                                    // reverb tanks, keep off the stack
+  UNITY_BEGIN();
+  RUN_TEST(test_every_kernel_named_and_runs);
+  RUN_TEST(test_rows_subtract_overhead);
+  const int r = UNITY_END();
+  delete suite;
+  return r;
+}
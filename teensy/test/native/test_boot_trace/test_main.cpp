@@ -0,0 +1,88 @@
+// VOX EFX - host tests for the boot timeline (shared/VoxLink)
+// Run: pio test -e native -f native/test_boot_trace
+
+#include <unity.h>
+
+#include <string.h>
+
+#include "vox_boot_trace.h"
+
+typedef vox::link::BootTrace<4> Trace;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_phases_are_deltas(void) {
+  Trace t;
+  t.begin(300000);
+  t.mark("AudioMemory", 300120);
+  t.mark("sgtl5000.enable", 305120);
+  t.mark("applyEffectState", 305170);
+
+  TEST_ASSERT_EQUAL_INT(3, t.size());
+  TEST_ASSERT_EQUAL_UINT32(120, t.phase(0));
+  TEST_ASSERT_EQUAL_UINT32(5000, t.phase(1));
+  TEST_ASSERT_EQUAL_UINT32(50, t.phase(2));
+  TEST_ASSERT_EQUAL_UINT32(5170, t.total());
+}
+
+void test_format_one_record(void) {
+  Trace t;
+  t.begin(1000);
+  t.mark("tft.init", 1500);
+  t.mark("lv_init", 1600);
+
+  char line[128];
+  const size_t n = t.format(line, sizeof(line), "ESP32");
+  TEST_ASSERT_EQUAL_STRING("BOOT,ESP32,T0=1000,tft.init=500,lv_init=100,TOTAL=600\n", line);
+  TEST_ASSERT_EQUAL_UINT32(strlen(line), n);
+}
+
+void test_clock_wrap(void) {
+  Trace t;
+  t.begin(0xFFFFFF00u);
+  t.mark("a", 0x00000100u);
+  TEST_ASSERT_EQUAL_UINT32(0x200, t.phase(0));
+  TEST_ASSERT_EQUAL_UINT32(0x200, t.total());
+}
+
+void test_full_trace_counts_drops(void) {
+  Trace t;
+  t.begin(0);
+  const char* names[6] = { "a", "b", "c", "d", "e", "f" };
+  for (int i = 0; i < 6; i++) t.mark(names[i], (uint32_t)(i + 1) * 10);
+
+  char line[128];
+  t.format(line, sizeof(line), "T");
+  TEST_ASSERT_EQUAL_STRING("BOOT,T,T0=0,a=10,b=10,c=10,d=10,TOTAL=40,DROP=2\n", line);
+}
+
+void test_short_buffer_cuts_at_whole_field(void) {
+  Trace t;
+  t.begin(0);
+  t.mark("first", 10);
+  t.mark("second", 30);
+
+  // Room for "BOOT,T,T0=0,first=10" but not ",second=20"
+  char line[24];
+  memset(line, 'x', sizeof(line));
+  const size_t n = t.format(line, sizeof(line), "T");
+  TEST_ASSERT_EQUAL_STRING("BOOT,T,T0=0,first=10\n", line);
+  TEST_ASSERT_EQUAL_UINT32(strlen(line), n);
+
+  char tiny[4];
+  t.format(tiny, sizeof(tiny), "T");
+  TEST_ASSERT_EQUAL_STRING("\n", tiny);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_phases_are_deltas);
+  RUN_TEST(test_format_one_record);
+  RUN_TEST(test_clock_wrap);
+  RUN_TEST(test_full_trace_counts_drops);
+  RUN_TEST(test_short_buffer_cuts_at_whole_field);
+  return UNITY_END();
+}
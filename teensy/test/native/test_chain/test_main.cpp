@@ -0,0 +1,58 @@
+// VOX EFX - host tests for the effect-chain description (vox_chain.h)
+// Run: pio test -e native -f native/test_chain
+
+#include <unity.h>
+
+#include "VoxDsp.h"
+
+using namespace vox::chain;
+
+static int position(Node n) {
+  for (int i = 0; i < ORDER.count; i++) {
+    if (ORDER.order[i] == n) return i;
+  }
+  return -1;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_order_is_topological(void) {
+  TEST_ASSERT_EQUAL_INT(NODES, ORDER.count);
+  for (int n = 0; n < NODES; n++) TEST_ASSERT_TRUE(position((Node)n) >= 0);
+  for (int e = 0; e < EDGE_COUNT; e++) {
+    TEST_ASSERT_TRUE(position(EDGES[e].from) < position(EDGES[e].to));
+  }
+}
+
+void test_taps_follow_their_source(void) {
+  TEST_ASSERT_EQUAL_INT(position(IN) + 1, position(PEAK_IN));
+  TEST_ASSERT_EQUAL_INT(position(REVERB) + 1, position(PEAK_WET));
+  TEST_ASSERT_EQUAL_INT(position(MIX) + 1, position(PEAK_MIX));
+}
+
+void test_order_needs_fewer_blocks(void) {
+  // The mixer's three inputs plus its output are the floor
+  TEST_ASSERT_EQUAL_INT(4, BLOCKS_PER_CHANNEL);
+  TEST_ASSERT_EQUAL_INT(5, DECLARED_BLOCKS_PER_CHANNEL);
+  TEST_ASSERT_EQUAL_INT(4 + 2 + 2, blocks(1));
+  TEST_ASSERT_EQUAL_INT(8 + 2 + 4, blocks(2));
+}
+
+void test_every_output_is_consumed(void) {
+  for (int n = 0; n < NODES; n++) {
+    if (INFO[n].output) TEST_ASSERT_TRUE(fanOut(n) >= 1);
+    else TEST_ASSERT_EQUAL_INT(0, fanOut(n));
+  }
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_order_is_topological);
+  RUN_TEST(test_taps_follow_their_source);
+  RUN_TEST(test_order_needs_fewer_blocks);
+  RUN_TEST(test_every_output_is_consumed);
+  return UNITY_END();
+}
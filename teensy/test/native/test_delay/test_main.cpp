@@ -0,0 +1,206 @@
+// VOX EFX - host tests for the modulated delay and tap tempo
+// Run: pio test -e native -f native/test_delay
+
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+#include "VoxDsp.h"
+
+static const int B = vox::BLOCK_SAMPLES;
+static const uint32_t POOL = vox::Delay::poolSamples(1000);
+
+static std::vector<int16_t> mem;
+static vox::Delay* dut = nullptr;
+
+void setUp(void) {
+  mem.assign(POOL, 0x5555);                // begin() must clear it
+  dut = new vox::Delay();
+  dut->begin(mem.data(), POOL);
+  dut->modulation(0.0f, 0.0f);
+  dut->feedback(0.0f);
+  dut->tone(30000.0f);
+}
+
+void tearDown(void) {
+  delete dut;
+  dut = nullptr;
+}
+
+static uint32_t lcg = 999;
+static int16_t noise() {
+  lcg = lcg * 1664525u + 1013904223u;
+  return (int16_t)(lcg >> 16);
+}
+
+// Runs blocks of input through the delay, collecting the output
+static std::vector<int16_t> run(vox::Delay& d, const std::vector<int16_t>& in) {
+  std::vector<int16_t> out(in.size());
+  for (size_t b = 0; b + B <= in.size(); b += B) d.update(&in[b], &out[b]);
+  return out;
+}
+
+void test_impulse_lands_at_delay_time(void) {
+  const uint32_t D = 1000;
+  dut->timeSamples(D);
+  dut->snap();
+  std::vector<int16_t> in(B * 20, 0);
+  in[3] = 12345;
+  std::vector<int16_t> out = run(*dut, in);
+  for (size_t i = 0; i < out.size(); i++) {
+    TEST_ASSERT_EQUAL_INT(i == 3 + D ? 12345 : 0, out[i]);
+  }
+}
+
+void test_feedback_repeats_decay(void) {
+  const uint32_t D = 300;
+  dut->timeSamples(D);
+  dut->snap();
+  dut->feedback(0.5f);
+  std::vector<int16_t> in(B * 12, 0);
+  in[0] = 16000;
+  std::vector<int16_t> out = run(*dut, in);
+  TEST_ASSERT_EQUAL_INT(16000, out[D]);
+  TEST_ASSERT_INT_WITHIN(2, 8000, out[2 * D]);
+  TEST_ASSERT_INT_WITHIN(2, 4000, out[3 * D]);
+}
+
+// Per-sample ring with the same fixed-point loop, for integer delays
+void test_spans_match_per_sample_reference(void) {
+  // Small pool, not a multiple of the block, so reads and writes wrap often
+  const uint32_t small = vox::Delay::MIN_SAMPLES + 600 + 37;
+  std::vector<int16_t> smallMem(small);
+  vox::Delay d;
+  d.begin(smallMem.data(), small);
+  d.modulation(0.0f, 0.0f);
+  d.feedback(0.6f);
+  d.tone(3000.0f);
+  const uint32_t D = d.maxDelaySamples();
+  d.timeSamples(D);
+  d.snap();
+
+  std::vector<int16_t> in(B * 200);
+  for (size_t i = 0; i < in.size(); i++) in[i] = noise() / 2;
+  std::vector<int16_t> out = run(d, in);
+
+  const int32_t fbk = (int32_t)(0.6f * 32768.0f);
+  const int32_t coef = (int32_t)((1.0f - expf(-2.0f * 3.14159265f * 3000.0f / vox::SAMPLE_RATE)) * 32767.0f);
+  std::vector<int16_t> ring(D, 0);
+  int32_t lp = 0;
+  for (size_t n = 0; n < in.size(); n++) {
+    int32_t v = ring[n % D];
+    TEST_ASSERT_EQUAL_INT(v, out[n]);
+    lp += ((v - lp) * coef) >> 15;
+    ring[n % D] = vox::saturate16(in[n] + ((lp * fbk) >> 15));
+  }
+}
+
+void test_time_glides_then_settles(void) {
+  dut->timeSamples(500);
+  dut->snap();
+  dut->timeSamples(2000);                  // 1500 samples of glide
+  std::vector<int16_t> in(B * 80, 0);
+  run(*dut, in);                           // > 1500 / GLIDE_MAX blocks
+  in.assign(B * 40, 0);
+  in[0] = 9000;
+  std::vector<int16_t> out = run(*dut, in);
+  TEST_ASSERT_EQUAL_INT(9000, out[2000]);
+  TEST_ASSERT_EQUAL_INT(0, out[1999]);
+}
+
+void test_modulated_reads_stay_in_window(void) {
+  // Full depth, fast LFO, gliding: a DC input must come back as the same DC
+  dut->modulation(7.0f, 5.0f);
+  dut->timeSamples(400);
+  dut->snap();
+  std::vector<int16_t> in(B * 60, 7000);
+  run(*dut, in);
+  dut->timeSamples(900);
+  std::vector<int16_t> out = run(*dut, in);
+  for (size_t i = 0; i < out.size(); i++) TEST_ASSERT_EQUAL_INT(7000, out[i]);
+}
+
+void test_time_clamps_to_pool(void) {
+  dut->time(60000.0f);
+  TEST_ASSERT_EQUAL_UINT32(dut->maxDelaySamples(), (uint32_t)(dut->timeMs() * vox::SAMPLE_RATE / 1000.0f + 0.5f));
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(44100, dut->maxDelaySamples());
+  dut->time(0.0f);
+  TEST_ASSERT_EQUAL_UINT32(vox::Delay::MIN_SAMPLES, (uint32_t)(dut->timeMs() * vox::SAMPLE_RATE / 1000.0f + 0.5f));
+}
+
+void test_pool_too_small_is_silent(void) {
+  int16_t tiny[64];
+  vox::Delay d;
+  d.begin(tiny, 64);
+  int16_t in[B], out[B];
+  for (int i = 0; i < B; i++) in[i] = 1000;
+  d.update(in, out);
+  for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT(0, out[i]);
+}
+
+void test_tap_tempo_averages_intervals(void) {
+  vox::TapTempo t;
+  TEST_ASSERT_FALSE(t.tap(10000));
+  TEST_ASSERT_TRUE(t.tap(10500));
+  TEST_ASSERT_EQUAL_UINT32(500, t.periodMs());
+  TEST_ASSERT_TRUE(t.tap(11020));
+  TEST_ASSERT_TRUE(t.tap(11500));
+  TEST_ASSERT_EQUAL_UINT32(500, t.periodMs());
+  TEST_ASSERT_FALSE(t.tap(11530));         // bounce
+  TEST_ASSERT_EQUAL_UINT32(500, t.periodMs());
+}
+
+void test_tap_tempo_restarts_after_pause(void) {
+  vox::TapTempo t;
+  t.tap(0);
+  t.tap(400);
+  TEST_ASSERT_FALSE(t.tap(5000));          // pause: new sequence, period kept
+  TEST_ASSERT_EQUAL_UINT32(400, t.periodMs());
+  TEST_ASSERT_TRUE(t.tap(5750));
+  TEST_ASSERT_EQUAL_UINT32(750, t.periodMs());
+}
+
+// A hold's press is taken back: neither its interval nor a fresh
+// sequence it would start survives
+void test_tap_tempo_untap(void) {
+  vox::TapTempo t;
+  t.tap(10000);
+  t.tap(10500);
+  TEST_ASSERT_TRUE(t.tap(11300));          // hold press inside the timeout: bogus 800
+  TEST_ASSERT_EQUAL_UINT32(650, t.periodMs());
+  t.untap();
+  TEST_ASSERT_EQUAL_UINT32(500, t.periodMs());
+  TEST_ASSERT_TRUE(t.tap(11500));          // the sequence carries on from 10500
+  TEST_ASSERT_EQUAL_UINT32(750, t.periodMs());
+
+  t.untap();
+  t.untap();                               // only the last tap can be taken back
+  TEST_ASSERT_EQUAL_UINT32(500, t.periodMs());
+
+  vox::TapTempo p;
+  p.tap(0);
+  p.tap(400);
+  TEST_ASSERT_FALSE(p.tap(5000));          // hold after a pause would start a sequence
+  p.untap();
+  TEST_ASSERT_FALSE(p.tap(6000));          // ... it didn't: this is a first tap again
+  TEST_ASSERT_TRUE(p.tap(6600));
+  TEST_ASSERT_EQUAL_UINT32(600, p.periodMs());
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_impulse_lands_at_delay_time);
+  RUN_TEST(test_feedback_repeats_decay);
+  RUN_TEST(test_spans_match_per_sample_reference);
+  RUN_TEST(test_time_glides_then_settles);
+  RUN_TEST(test_modulated_reads_stay_in_window);
+  RUN_TEST(test_time_clamps_to_pool);
+  RUN_TEST(test_pool_too_small_is_silent);
+  RUN_TEST(test_tap_tempo_averages_intervals);
+  RUN_TEST(test_tap_tempo_restarts_after_pause);
+  RUN_TEST(test_tap_tempo_untap);
+  return UNITY_END();
+}
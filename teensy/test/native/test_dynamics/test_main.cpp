@@ -0,0 +1,143 @@
+// VOX EFX - host tests for the look-ahead gate/compressor/limiter
+// Run: pio test -e native -f native/test_dynamics
+
+#include <unity.h>
+
+#include <math.h>
+#include <vector>
+
+#include "VoxDsp.h"
+
+static const int B = vox::BLOCK_SAMPLES;
+
+static vox::Dynamics* dut = nullptr;
+
+void setUp(void) {
+  dut = new vox::Dynamics();
+}
+
+void tearDown(void) {
+  delete dut;
+  dut = nullptr;
+}
+
+static uint32_t lcg = 4242;
+static int16_t noise() {
+  lcg = lcg * 1664525u + 1013904223u;
+  return (int16_t)(lcg >> 16);
+}
+
+static std::vector<int16_t> run(const std::vector<int16_t>& in) {
+  std::vector<int16_t> out(in.size());
+  for (size_t b = 0; b + B <= in.size(); b += B) dut->update(&in[b], &out[b]);
+  return out;
+}
+
+static float dbfs(int32_t x) {
+  return 20.0f * log10f((float)(x < 0 ? -x : x) / 32767.0f);
+}
+
+void test_log_and_exp_tables(void) {
+  for (int a = 1; a <= 32768; a += 7) {
+    float expect = log2f((float)a / 32768.0f) * 1024.0f;
+    TEST_ASSERT_FLOAT_WITHIN(12.0f, expect, (float)vox::Dynamics::levelLog2(a));
+  }
+  TEST_ASSERT_EQUAL_INT(0, vox::Dynamics::levelLog2(32768));
+  for (int g = -8 * 1024; g <= 4 * 1024; g += 13) {
+    float expect = powf(2.0f, (float)g / 1024.0f) * 65536.0f;
+    TEST_ASSERT_FLOAT_WITHIN(expect * 0.003f + 1.0f, expect, (float)vox::Dynamics::gainQ16(g));
+  }
+  TEST_ASSERT_EQUAL_UINT32(65536, vox::Dynamics::gainQ16(0));
+}
+
+void test_defaults_are_transparent(void) {
+  std::vector<int16_t> in(B * 20);
+  for (size_t i = 0; i < in.size(); i++) in[i] = noise() / 2;
+  std::vector<int16_t> out = run(in);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(&in[0], &out[0], (int)in.size());
+}
+
+void test_bypass_is_bit_exact(void) {
+  dut->compressor(-30.0f, 8.0f, 12.0f);
+  dut->lookahead(3.0f);
+  dut->bypass(true);
+  std::vector<int16_t> in(B * 10);
+  for (size_t i = 0; i < in.size(); i++) in[i] = noise();
+  std::vector<int16_t> out = run(in);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(&in[0], &out[0], (int)in.size());
+}
+
+void test_lookahead_delays_the_signal(void) {
+  dut->lookahead(2.0f);                      // 88 samples
+  std::vector<int16_t> in(B * 4, 0);
+  in[10] = 5000;
+  std::vector<int16_t> out = run(in);
+  for (size_t i = 0; i < out.size(); i++) TEST_ASSERT_EQUAL_INT(i == 98 ? 5000 : 0, out[i]);
+}
+
+void test_limiter_holds_the_ceiling(void) {
+  dut->limiter(-6.0f, 50.0f);
+  dut->compressor(-20.0f, 2.0f, 12.0f);      // makeup pushes into the limiter
+  dut->lookahead(2.0f);
+  std::vector<int16_t> in(B * 200);
+  for (size_t i = 0; i < in.size(); i++) {
+    float env = (i / 2000) % 2 ? 1.0f : 0.1f;  // bursts
+    in[i] = (int16_t)(30000.0f * env * sinf((float)i * 0.07f));
+  }
+  std::vector<int16_t> out = run(in);
+  const int32_t ceil = (int32_t)(32767.0f * powf(10.0f, -6.0f / 20.0f));
+  int32_t peak = 0;
+  for (size_t i = 0; i < out.size(); i++) {
+    int32_t a = out[i] < 0 ? -out[i] : out[i];
+    if (a > peak) peak = a;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(ceil, peak);
+  TEST_ASSERT_GREATER_THAN(ceil * 9 / 10, peak);
+  TEST_ASSERT_LESS_THAN(-1.0f, dut->takeGainReductionDb());
+}
+
+void test_compressor_steady_state_ratio(void) {
+  // -6 dBFS DC, threshold -20 dB, 4:1 -> -20 + 14/4 = -16.5 dBFS
+  dut->compressor(-20.0f, 4.0f, 0.0f);
+  dut->compressorTimes(1.0f, 50.0f);
+  std::vector<int16_t> in(B * 100, 16384);
+  std::vector<int16_t> out = run(in);
+  TEST_ASSERT_FLOAT_WITHIN(0.2f, -16.5f, dbfs(out.back()));
+}
+
+void test_gate_attenuates_below_threshold(void) {
+  dut->gate(-50.0f, 40.0f);
+  std::vector<int16_t> in(B * 400);
+  for (size_t i = 0; i < in.size(); i++) in[i] = (int16_t)(30.0f * sinf((float)i * 0.05f));   // ~ -61 dBFS
+  std::vector<int16_t> out = run(in);
+  int32_t peak = 0;
+  for (size_t i = in.size() - B * 20; i < in.size(); i++) {
+    int32_t a = out[i] < 0 ? -out[i] : out[i];
+    if (a > peak) peak = a;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1, peak);        // 30 * 10^(-40/20) = 0.3
+
+  // Loud signal opens it again within a few ms
+  for (size_t i = 0; i < in.size(); i++) in[i] = (int16_t)(10000.0f * sinf((float)i * 0.05f));
+  out = run(in);
+  peak = 0;
+  for (int i = 2 * B; i < 4 * B; i++) {
+    int32_t a = out[i] < 0 ? -out[i] : out[i];
+    if (a > peak) peak = a;
+  }
+  TEST_ASSERT_GREATER_THAN(9900, peak);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_log_and_exp_tables);
+  RUN_TEST(test_defaults_are_transparent);
+  RUN_TEST(test_bypass_is_bit_exact);
+  RUN_TEST(test_lookahead_delays_the_signal);
+  RUN_TEST(test_limiter_holds_the_ceiling);
+  RUN_TEST(test_compressor_steady_state_ratio);
+  RUN_TEST(test_gate_attenuates_below_threshold);
+  return UNITY_END();
+}
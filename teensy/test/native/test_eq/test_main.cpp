@@ -0,0 +1,174 @@
+// VOX EFX - host tests for the 6-band parametric EQ
+// Run: pio test -e native -f native/test_eq
+
+#include <unity.h>
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#include "VoxDsp.h"
+
+static const int B = vox::BLOCK_SAMPLES;
+
+static vox::Equalizer* dut = nullptr;
+
+void setUp(void) {
+  dut = new vox::Equalizer();
+}
+
+void tearDown(void) {
+  delete dut;
+  dut = nullptr;
+}
+
+static uint32_t lcg = 777;
+static int16_t noise() {
+  lcg = lcg * 1664525u + 1013904223u;
+  return (int16_t)(lcg >> 16);
+}
+
+static std::vector<int16_t> run(const std::vector<int16_t>& in) {
+  std::vector<int16_t> out(in.size());
+  for (size_t b = 0; b + B <= in.size(); b += B) dut->update(&in[b], &out[b]);
+  return out;
+}
+
+static std::vector<int16_t> sine(float hz, float amp, int blocks) {
+  std::vector<int16_t> s(B * blocks);
+  for (size_t i = 0; i < s.size(); i++) {
+    s[i] = (int16_t)(amp * sinf(2.0f * 3.14159265f * hz * (float)i / vox::SAMPLE_RATE));
+  }
+  return s;
+}
+
+// Output/input RMS over the second half (filters settled), in dB
+static float gainDb(float hz, int blocks = 40) {
+  std::vector<int16_t> in = sine(hz, 8000.0f, blocks);
+  std::vector<int16_t> out = run(in);
+  double ei = 0, eo = 0;
+  for (size_t i = in.size() / 2; i < in.size(); i++) {
+    ei += (double)in[i] * in[i];
+    eo += (double)out[i] * out[i];
+  }
+  return (float)(10.0 * log10(eo / ei));
+}
+
+void test_flat_is_bit_exact(void) {
+  // Default bands, plus shelves/peaks explicitly at 0 dB
+  dut->setBand(1, vox::EqBand{ vox::EqType::LowShelf, 120.0f, 0.0f, 0.707f });
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 0.0f, 1.0f });
+  TEST_ASSERT_TRUE(dut->passthrough());
+
+  std::vector<int16_t> in(B * 10);
+  for (size_t i = 0; i < in.size(); i++) in[i] = noise();
+  std::vector<int16_t> out = run(in);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(&in[0], &out[0], (int)in.size());
+}
+
+void test_peak_boosts_its_band_only(void) {
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 6.0f, 1.0f });
+  TEST_ASSERT_FALSE(dut->passthrough());
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 6.0f, gainDb(1000.0f));
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, gainDb(60.0f, 80));
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, gainDb(12000.0f));
+}
+
+void test_shelves(void) {
+  dut->setBand(1, vox::EqBand{ vox::EqType::LowShelf, 200.0f, -6.0f, 0.707f });
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, -6.0f, gainDb(40.0f, 120));
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, gainDb(5000.0f));
+
+  dut->setBand(1, vox::EqBand{ vox::EqType::Off, 200.0f, 0.0f, 0.707f });
+  dut->setBand(5, vox::EqBand{ vox::EqType::HighShelf, 4000.0f, 4.0f, 0.707f });
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 4.0f, gainDb(15000.0f));
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, gainDb(200.0f));
+}
+
+void test_high_pass_and_low_pass(void) {
+  dut->setBand(0, vox::EqBand{ vox::EqType::HighPass, 200.0f, 0.0f, 0.707f });
+  TEST_ASSERT_LESS_THAN(-20, (int)gainDb(40.0f, 120));        // 12 dB/oct, > 2 octaves down
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 0.0f, gainDb(4000.0f));
+
+  dut->setBand(0, vox::EqBand{ vox::EqType::Off, 200.0f, 0.0f, 0.707f });
+  dut->setBand(4, vox::EqBand{ vox::EqType::LowPass, 1000.0f, 0.0f, 0.707f });
+  dut->reset();
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, -3.0f, gainDb(1000.0f));     // -3 dB at the corner
+  dut->reset();
+  TEST_ASSERT_LESS_THAN(-20, (int)gainDb(8000.0f));
+}
+
+void test_newest_set_wins_at_block_boundary(void) {
+  // Several publishes between two blocks: only the last one runs
+  std::vector<int16_t> in = sine(1000.0f, 8000.0f, 40);
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 12.0f, 1.0f });
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, -12.0f, 1.0f });
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 6.0f, 1.0f });
+  TEST_ASSERT_FLOAT_WITHIN(0.3f, 6.0f, gainDb(1000.0f));
+
+  // Publishing mid-stream changes nothing inside the block being processed;
+  // the block after sees the new set
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 0.0f, 1.0f });
+  TEST_ASSERT_TRUE(dut->passthrough());
+  std::vector<int16_t> out(B);
+  dut->update(&in[0], &out[0]);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(&in[0], &out[0], B);
+}
+
+void test_process_keeps_the_checked_set(void) {
+  // A set published between passthrough() and process() waits for the next
+  // block: the AudioStream wrapper checks, then filters
+  std::vector<int16_t> in = sine(1000.0f, 8000.0f, 1);
+  std::vector<int16_t> ref(B), out(B);
+  vox::Equalizer boosted;
+  boosted.setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 6.0f, 1.0f });
+  boosted.update(&in[0], &ref[0]);
+
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, 6.0f, 1.0f });
+  TEST_ASSERT_FALSE(dut->passthrough());
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, -12.0f, 1.0f });
+  dut->process(&in[0], &out[0]);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(&ref[0], &out[0], B);
+
+  TEST_ASSERT_FALSE(dut->passthrough());
+  dut->process(&in[0], &out[0]);
+  TEST_ASSERT_TRUE(memcmp(&ref[0], &out[0], B * sizeof(int16_t)) != 0);
+}
+
+void test_all_bands_stable_and_saturating(void) {
+  dut->setBand(0, vox::EqBand{ vox::EqType::HighPass, 20.0f, 0.0f, 4.0f });
+  dut->setBand(1, vox::EqBand{ vox::EqType::LowShelf, 80.0f, 12.0f, 0.707f });
+  dut->setBand(2, vox::EqBand{ vox::EqType::Peak, 400.0f, 12.0f, 8.0f });
+  dut->setBand(3, vox::EqBand{ vox::EqType::Peak, 1000.0f, -12.0f, 0.3f });
+  dut->setBand(4, vox::EqBand{ vox::EqType::LowPass, 19000.0f, 0.0f, 2.0f });
+  dut->setBand(5, vox::EqBand{ vox::EqType::HighShelf, 8000.0f, 12.0f, 0.707f });
+
+  std::vector<int16_t> in(B * 400);
+  for (size_t i = 0; i < in.size(); i++) in[i] = noise();
+  run(in);
+
+  // Silence afterwards decays to silence (no runaway state)
+  std::vector<int16_t> out(B);
+  for (int b = 0; b < 400; b++) dut->update(nullptr, &out[0]);
+  for (int i = 0; i < B; i++) TEST_ASSERT_INT_WITHIN(1, 0, out[i]);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_flat_is_bit_exact);
+  RUN_TEST(test_peak_boosts_its_band_only);
+  RUN_TEST(test_shelves);
+  RUN_TEST(test_high_pass_and_low_pass);
+  RUN_TEST(test_newest_set_wins_at_block_boundary);
+  RUN_TEST(test_process_keeps_the_checked_set);
+  RUN_TEST(test_all_bands_stable_and_saturating);
+  return UNITY_END();
+}
@@ -0,0 +1,107 @@
+// VOX EFX - host tests for the footswitch press/hold state machine (vox_footswitch.h)
+// Run: pio test -e native -f native/test_footswitch
+
+#include <unity.h>
+
+#include "vox_footswitch.h"
+
+using vox::Footswitch;
+
+static const uint32_t HOLD_MS = 800;
+
+// Events seen over [from, to) with the switch at `down`, polled every ms
+struct Log {
+  int press = 0, hold = 0, tap = 0;
+  uint32_t holdAt = 0;
+};
+
+static void run(Footswitch& f, bool down, uint32_t from, uint32_t to, Log& log) {
+  for (uint32_t t = from; t < to; t++) {
+    switch (f.update(down, t)) {
+      case Footswitch::PRESS: log.press++; break;
+      case Footswitch::HOLD:  log.hold++; log.holdAt = t; break;
+      case Footswitch::TAP:   log.tap++; break;
+      default: break;
+    }
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_short_press_taps_on_release(void) {
+  Footswitch f(HOLD_MS);
+  Log log;
+  run(f, false, 1000, 1100, log);
+  run(f, true, 1100, 1300, log);                 // 200 ms press
+  TEST_ASSERT_EQUAL_INT(1, log.press);
+  TEST_ASSERT_EQUAL_INT(0, log.tap);             // nothing until release
+  TEST_ASSERT_EQUAL_UINT32(1100, f.pressedMs());
+  run(f, false, 1300, 3000, log);
+  TEST_ASSERT_EQUAL_INT(1, log.tap);
+  TEST_ASSERT_EQUAL_INT(0, log.hold);
+}
+
+// The hold path never produces the short-press action
+void test_hold_does_not_tap(void) {
+  Footswitch f(HOLD_MS);
+  Log log;
+  run(f, false, 1000, 1100, log);
+  run(f, true, 1100, 3000, log);
+  TEST_ASSERT_EQUAL_INT(1, log.press);
+  TEST_ASSERT_EQUAL_INT(1, log.hold);            // once, however long it's held
+  TEST_ASSERT_EQUAL_UINT32(1100 + HOLD_MS, log.holdAt);
+  run(f, false, 3000, 4000, log);
+  TEST_ASSERT_EQUAL_INT(0, log.tap);
+
+  // The next short press taps again
+  run(f, true, 4000, 4100, log);
+  run(f, false, 4100, 4500, log);
+  TEST_ASSERT_EQUAL_INT(2, log.press);
+  TEST_ASSERT_EQUAL_INT(1, log.tap);
+  TEST_ASSERT_EQUAL_INT(1, log.hold);
+}
+
+void test_bounce_is_ignored(void) {
+  Footswitch f(HOLD_MS);
+  Log log;
+  run(f, false, 1000, 1100, log);
+  // Contact bounce on press and on release, 2 ms chatter for 10 ms each
+  for (uint32_t t = 1100; t < 1110; t += 2) {
+    run(f, true, t, t + 1, log);
+    run(f, false, t + 1, t + 2, log);
+  }
+  run(f, true, 1110, 1300, log);
+  for (uint32_t t = 1300; t < 1310; t += 2) {
+    run(f, false, t, t + 1, log);
+    run(f, true, t + 1, t + 2, log);
+  }
+  run(f, false, 1310, 1600, log);
+  TEST_ASSERT_EQUAL_INT(1, log.press);
+  TEST_ASSERT_EQUAL_INT(1, log.tap);
+  TEST_ASSERT_EQUAL_INT(0, log.hold);
+}
+
+// A press shorter than the debounce still taps, once the lockout ends
+void test_quick_press_taps_late(void) {
+  Footswitch f(HOLD_MS);
+  Log log;
+  run(f, false, 1000, 1100, log);
+  run(f, true, 1100, 1120, log);
+  run(f, false, 1120, 1149, log);
+  TEST_ASSERT_EQUAL_INT(0, log.tap);
+  run(f, false, 1149, 1200, log);
+  TEST_ASSERT_EQUAL_INT(1, log.press);
+  TEST_ASSERT_EQUAL_INT(1, log.tap);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_short_press_taps_on_release);
+  RUN_TEST(test_hold_does_not_tap);
+  RUN_TEST(test_bounce_is_ignored);
+  RUN_TEST(test_quick_press_taps_late);
+  return UNITY_END();
+}
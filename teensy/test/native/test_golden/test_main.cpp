@@ -0,0 +1,140 @@
+// VOX EFX - golden-audio regression tests (vox_golden.h): every corpus input
+// through every preset slot, against test/golden
+// Run (from teensy/): pio test -e native -f native/test_golden
+// - Bit-exact is required by default. A change meant to alter the output
+//   within tolerance (fixed point, SIMD reassociation) is checked with
+//   -DVOX_GOLDEN_EXACT=0, which reports exact mismatches without failing
+// - Regenerate after an intended change: program --golden test/golden
+
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "VoxDsp.h"
+#include "vox_config.h"
+#include "vox_golden.h"
+
+#ifndef VOX_GOLDEN_DIR
+#define VOX_GOLDEN_DIR "test/golden"
+#endif
+#ifndef VOX_GOLDEN_EXACT
+#define VOX_GOLDEN_EXACT 1
+#endif
+
+using namespace vox::golden;
+
+static int16_t input[SAMPLES];
+static int16_t output[SAMPLES];
+static int16_t golden[SAMPLES];
+
+// Renders one case and loads its golden; fails the test when the file is missing
+static void run(int in, int slot, char* name, size_t n) {
+  const vox::link::Preset p = presetDefaults(slot);
+  makeInput(in, input, SAMPLES);
+  vox::golden::render(presetSettings(p), input, output, SAMPLES);
+  path(name, n, VOX_GOLDEN_DIR, in, p.name);
+  char msg[320];
+  snprintf(msg, sizeof(msg), "%s missing or short: run from teensy/, or regenerate with --golden", name);
+  TEST_ASSERT_TRUE_MESSAGE(readRaw(name, golden, SAMPLES), msg);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// The goldens only mean something for the inputs they were rendered from
+void test_corpus_is_pinned(void) {
+  const uint32_t HASHES[INPUTS] = { 0x96870b51, 0xaec6df13, 0x80dcb365, 0xefb69dc5 };
+  for (int in = 0; in < INPUTS; in++) {
+    makeInput(in, input, SAMPLES);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(HASHES[in], hash(input, SAMPLES), inputName(in));
+  }
+  // Signal, then silence for the tails
+  makeInput(VOICE, input, SAMPLES);
+  for (int i = SIGNAL_BLOCKS * vox::BLOCK_SAMPLES; i < SAMPLES; i++) TEST_ASSERT_EQUAL_INT16(0, input[i]);
+}
+
+void test_outputs_bit_exact(void) {
+  int failed = 0;
+  for (int in = 0; in < INPUTS; in++) {
+    for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+      char name[256];
+      run(in, slot, name, sizeof(name));
+      const Diff d = compare(golden, output, SAMPLES);
+      if (d.exact()) continue;
+      failed++;
+      char msg[400];
+      snprintf(msg, sizeof(msg), "%s: %d samples differ from %d, max %d LSB, RMS %.1f dBFS, spectrum %.2f dB",
+               name, d.count, d.first, d.maxAbs, d.rmsDbfs, d.spectralDb);
+      TEST_MESSAGE(msg);
+    }
+  }
+#if VOX_GOLDEN_EXACT
+  TEST_ASSERT_EQUAL_INT_MESSAGE(0, failed, "output is not bit-exact with the goldens");
+#else
+  if (failed) TEST_IGNORE_MESSAGE("not bit-exact (VOX_GOLDEN_EXACT=0): see the tolerance test");
+#endif
+}
+
+void test_outputs_within_tolerance(void) {
+  for (int in = 0; in < INPUTS; in++) {
+    for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+      char name[256];
+      run(in, slot, name, sizeof(name));
+      const Diff d = compare(golden, output, SAMPLES);
+      char msg[400];
+      snprintf(msg, sizeof(msg), "%s: RMS %.1f dBFS (max %.1f), spectrum %.2f dB (max %.2f)",
+               name, d.rmsDbfs, TOL_RMS_DBFS, d.spectralDb, TOL_SPECTRAL_DB);
+      TEST_ASSERT_TRUE_MESSAGE(d.withinTolerance(), msg);
+    }
+  }
+}
+
+// The tolerance lets rounding noise through and stops a real change
+void test_metrics(void) {
+  char name[256];
+  run(VOICE, 1, name, sizeof(name));
+
+  // +/- 1 LSB on every sample: not exact, well inside tolerance
+  uint32_t r = 1;
+  for (int i = 0; i < SAMPLES; i++) {
+    r = r * 1664525u + 1013904223u;
+    output[i] = (int16_t)(golden[i] + (int)(r >> 31) * 2 - 1);
+  }
+  Diff d = compare(golden, output, SAMPLES);
+  TEST_ASSERT_FALSE(d.exact());
+  TEST_ASSERT_EQUAL_INT(0, d.first);
+  TEST_ASSERT_EQUAL_INT(1, d.maxAbs);
+  TEST_ASSERT_FLOAT_WITHIN(0.1, -90.3, d.rmsDbfs);
+  TEST_ASSERT_TRUE(d.withinTolerance());
+
+  // 1 dB quieter: fails both
+  for (int i = 0; i < SAMPLES; i++) output[i] = (int16_t)(golden[i] * 0.891f);
+  d = compare(golden, output, SAMPLES);
+  TEST_ASSERT_FLOAT_WITHIN(0.05, 1.0, d.spectralDb);
+  TEST_ASSERT_TRUE(d.rmsDbfs > TOL_RMS_DBFS);
+  TEST_ASSERT_FALSE(d.withinTolerance());
+
+  // Duller top: a 2-tap average on the sweep (-3 dB at 11 kHz, -7.6 dB
+  // at 16 kHz) shows in the high bands
+  run(SWEEP, 0, name, sizeof(name));
+  for (int i = 0; i < SAMPLES; i++) output[i] = (int16_t)((golden[i] + (i ? golden[i - 1] : 0)) / 2);
+  d = compare(golden, output, SAMPLES);
+  TEST_ASSERT_TRUE(d.spectralDb > 6.0);
+  TEST_ASSERT_FALSE(d.withinTolerance());
+
+  // Same samples: exact, nothing else computed
+  d = compare(golden, golden, SAMPLES);
+  TEST_ASSERT_TRUE(d.exact());
+  TEST_ASSERT_TRUE(d.rmsDbfs == SILENT_DBFS);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_corpus_is_pinned);
+  RUN_TEST(test_outputs_bit_exact);
+  RUN_TEST(test_outputs_within_tolerance);
+  RUN_TEST(test_metrics);
+  return UNITY_END();
+}
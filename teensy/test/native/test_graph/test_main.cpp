@@ -0,0 +1,159 @@
+// VOX EFX - host tests for the mirrored audio graph
+// Run: pio test -e native -f native/test_graph
+
+#include <unity.h>
+
+#include "VoxDsp.h"
+
+static const int B = vox::BLOCK_SAMPLES;
+
+static vox::MonoGraph* g = nullptr;
+
+void setUp(void) {
+  g = new vox::MonoGraph();
+}
+
+void tearDown(void) {
+  delete g;
+  g = nullptr;
+}
+
+static vox::GraphSettings settings(bool fx, float level) {
+  vox::GraphSettings s;
+  s.wet   = fx ? 0.35f : 0.0f;
+  s.level = level;
+  return s;
+}
+
+static void fillRamp(int16_t* buf, int seed) {
+  for (int i = 0; i < B; i++) buf[i] = (int16_t)((i * 517 + seed * 131) % 40000 - 20000);
+}
+
+void test_dry_unity_is_bit_exact(void) {
+  g->configure(settings(false, 1.0f));
+  int16_t in[B], out[B];
+  for (int b = 0; b < 20; b++) {
+    fillRamp(in, b);
+    g->update(in, out);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(in, out, B);
+  }
+}
+
+void test_level_half_matches_q16_gain(void) {
+  g->configure(settings(false, 0.5f));
+  int16_t in[B], out[B];
+  fillRamp(in, 3);
+  g->update(in, out);
+  for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT((in[i] * 32768) >> 16, out[i]);
+}
+
+void test_level_zero_outputs_silence(void) {
+  g->configure(settings(true, 0.0f));
+  int16_t in[B], out[B];
+  fillRamp(in, 1);
+  g->update(in, out);
+  for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT(0, out[i]);
+  TEST_ASSERT_FALSE(g->peakOut.available());
+}
+
+void test_silence_in_silence_out_with_reverb(void) {
+  g->configure(settings(true, 1.0f));
+  int16_t in[B] = {0}, out[B];
+  for (int b = 0; b < 50; b++) {
+    g->update(in, out);
+    for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT(0, out[i]);
+  }
+}
+
+void test_reverb_tail_rings_then_decays(void) {
+  g->configure(settings(true, 1.0f));
+  int16_t in[B] = {0}, out[B];
+  in[0] = 20000;
+  g->update(in, out);
+  in[0] = 0;
+
+  // Energy shortly after the impulse vs. several seconds later
+  long long early = 0, late = 0;
+  for (int b = 1; b < 2000; b++) {
+    g->update(in, out);
+    for (int i = 0; i < B; i++) {
+      long long e = (long long)out[i] * out[i];
+      if (b >= 10 && b < 110) early += e;
+      if (b >= 1900) late += e;
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(0, early);
+  TEST_ASSERT_LESS_THAN(early / 100, late);
+}
+
+void test_peaks_follow_taps(void) {
+  g->configure(settings(false, 0.5f));
+  int16_t in[B] = {0}, out[B];
+  in[5] = -16384;
+  g->update(in, out);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 16384.0f / 32767.0f, g->peakIn.read());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 16384.0f / 32767.0f, g->peakMix.read());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 8192.0f / 32767.0f, g->peakOut.read());
+  TEST_ASSERT_FALSE(g->peakIn.available());
+}
+
+void test_dual_mono_sides_match_mono_graph(void) {
+  vox::DualMonoGraph* d = new vox::DualMonoGraph();
+  g->configure(settings(true, 1.0f));
+  d->configure(settings(true, 1.0f));
+  int16_t in[B], out[B], l[B], r[B], silent[B] = {0};
+  const int16_t* din[2] = { in, silent };
+  int16_t* dout[2] = { l, r };
+  for (int b = 0; b < 40; b++) {
+    fillRamp(in, b);
+    g->update(in, out);
+    d->process(din, dout);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(out, l, B);
+    for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT(0, r[i]);
+  }
+  delete d;
+}
+
+void test_stereo_shared_tank_is_decorrelated(void) {
+  vox::StereoGraph* st = new vox::StereoGraph();
+  vox::GraphSettings s = settings(true, 1.0f);
+  s.dry = 0.0f;                       // wet only
+  st->configure(s);
+  int16_t in[B] = {0}, l[B], r[B];
+  const int16_t* sin[2] = { in, in };
+  int16_t* sout[2] = { l, r };
+  in[0] = 20000;
+  st->process(sin, sout);
+  in[0] = 0;
+
+  // Same input on both sides; the allpass spread still makes L != R
+  long long el = 0, er = 0;
+  int differ = 0;
+  for (int b = 1; b < 200; b++) {
+    st->process(sin, sout);
+    for (int i = 0; i < B; i++) {
+      el += (long long)l[i] * l[i];
+      er += (long long)r[i] * r[i];
+      if (l[i] != r[i]) differ++;
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(0, el);
+  TEST_ASSERT_GREATER_THAN(0, er);
+  TEST_ASSERT_GREATER_THAN(B * 50, differ);
+  delete st;
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_dry_unity_is_bit_exact);
+  RUN_TEST(test_level_half_matches_q16_gain);
+  RUN_TEST(test_level_zero_outputs_silence);
+  RUN_TEST(test_silence_in_silence_out_with_reverb);
+  RUN_TEST(test_reverb_tail_rings_then_decays);
+  RUN_TEST(test_peaks_follow_taps);
+  RUN_TEST(test_dual_mono_sides_match_mono_graph);
+  RUN_TEST(test_stereo_shared_tank_is_decorrelated);
+  return UNITY_END();
+}
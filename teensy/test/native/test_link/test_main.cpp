@@ -0,0 +1,238 @@
+// VOX EFX - host tests for the Teensy <-> ESP32 frame codec (shared/VoxLink)
+// Run: pio test -e native -f native/test_link
+
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+#include "vox_link.h"
+
+using namespace vox::link;
+
+static Decoder* rx = nullptr;
+
+void setUp(void) {
+  rx = new Decoder();
+}
+
+void tearDown(void) {
+  delete rx;
+  rx = nullptr;
+}
+
+// Feeds bytes, returns how many frames completed
+static int feed(const uint8_t* p, size_t n) {
+  int frames = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (rx->push(p[i])) frames++;
+  }
+  return frames;
+}
+
+template <class M>
+static std::vector<uint8_t> frameOf(const M& m) {
+  std::vector<uint8_t> f(MAX_FRAME);
+  f.resize(encode(m, &f[0], f.size()));
+  return f;
+}
+
+void test_crc16_ccitt_false_check_value(void) {
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16(check, sizeof(check)));
+}
+
+void test_frame_layout(void) {
+  Meter m;
+  m.in = 3;
+  m.out = 5;
+  std::vector<uint8_t> f = frameOf(m);
+  TEST_ASSERT_EQUAL_UINT32(Meter::SIZE + OVERHEAD, f.size());
+  TEST_ASSERT_EQUAL_HEX8(SYNC, f[0]);
+  TEST_ASSERT_EQUAL_HEX8(MSG_METER, f[1]);
+  TEST_ASSERT_EQUAL_UINT8(2, f[2]);
+  TEST_ASSERT_EQUAL_UINT8(3, f[3]);
+  TEST_ASSERT_EQUAL_UINT8(5, f[4]);
+  uint16_t crc = crc16(&f[1], 4);
+  TEST_ASSERT_EQUAL_HEX8(crc & 0xFF, f[5]);
+  TEST_ASSERT_EQUAL_HEX8(crc >> 8, f[6]);
+}
+
+void test_round_trip_every_message(void) {
+  DelayState d;
+  d.on = true;
+  d.ms = 1234;
+  Debug g;
+  g.dry = 1000; g.wet = 350; g.room = 550;
+  g.pkIn = 371; g.pkWet = 4; g.pkMix = 65535; g.pkOut = 0;
+  g.grDb10 = -123;
+  SetEq e;
+  e.band = 3;
+  e.gainDb10 = -60;
+  SetLevel l;
+  l.pct = 77;
+
+  std::vector<uint8_t> all;
+  for (auto& f : { frameOf(d), frameOf(g), frameOf(e), frameOf(l) }) all.insert(all.end(), f.begin(), f.end());
+
+  DelayState d2;
+  Debug g2;
+  SetEq e2;
+  SetLevel l2;
+  Level wrongType;
+  int n = 0;
+  for (uint8_t b : all) {
+    if (!rx->push(b)) continue;
+    switch (n++) {
+      case 0:
+        TEST_ASSERT_TRUE(decode(*rx, d2));
+        TEST_ASSERT_FALSE(decode(*rx, g2));       // type mismatch
+        break;
+      case 1: TEST_ASSERT_TRUE(decode(*rx, g2)); break;
+      case 2: TEST_ASSERT_TRUE(decode(*rx, e2)); break;
+      case 3:
+        TEST_ASSERT_FALSE(decode(*rx, wrongType)); // SET_LEVEL is not LEVEL
+        TEST_ASSERT_TRUE(decode(*rx, l2));
+        break;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(4, n);
+  TEST_ASSERT_TRUE(d2.on);
+  TEST_ASSERT_EQUAL_UINT16(1234, d2.ms);
+  TEST_ASSERT_EQUAL_MEMORY(&g.dry, &g2.dry, 7 * sizeof(uint16_t));
+  TEST_ASSERT_EQUAL_INT16(-123, g2.grDb10);
+  TEST_ASSERT_EQUAL_UINT8(3, e2.band);
+  TEST_ASSERT_EQUAL_INT16(-60, e2.gainDb10);
+  TEST_ASSERT_EQUAL_UINT8(77, l2.pct);
+  TEST_ASSERT_EQUAL_UINT32(4, rx->frames);
+  TEST_ASSERT_EQUAL_UINT32(0, rx->crcErrors);
+}
+
+void test_cpu_frame_round_trip(void) {
+  Cpu c;
+  c.allPct = 42;
+  c.count = Cpu::MAX_NODES;
+  for (int i = 0; i < c.count; i++) {
+    memcpy(c.node[i].name, "N0 ", 3);
+    c.node[i].name[1] = (char)('0' + i);
+    c.node[i].min = (uint16_t)(i * 10);
+    c.node[i].avg = (uint16_t)(i * 100);
+    c.node[i].max = (uint16_t)(i * 1000);
+    for (int b = 0; b < Cpu::BINS; b++) c.node[i].hist[b] = (uint8_t)(i + b);
+  }
+  std::vector<uint8_t> f = frameOf(c);
+  TEST_ASSERT_EQUAL_UINT32(c.size() + OVERHEAD, f.size());
+  TEST_ASSERT_EQUAL_INT(1, feed(&f[0], f.size()));
+
+  Cpu c2;
+  TEST_ASSERT_TRUE(decode(*rx, c2));
+  TEST_ASSERT_EQUAL_UINT8(42, c2.allPct);
+  TEST_ASSERT_EQUAL_UINT8(Cpu::MAX_NODES, c2.count);
+  for (int i = 0; i < c.count; i++) {
+    TEST_ASSERT_EQUAL_MEMORY(c.node[i].name, c2.node[i].name, 3);
+    TEST_ASSERT_EQUAL_UINT16(c.node[i].max, c2.node[i].max);
+    TEST_ASSERT_EQUAL_MEMORY(c.node[i].hist, c2.node[i].hist, Cpu::BINS);
+  }
+
+  TEST_ASSERT_EQUAL_UINT16(5000, Cpu::share(500, 1000));
+  TEST_ASSERT_EQUAL_UINT16(65535, Cpu::share(100000, 1000));
+  TEST_ASSERT_EQUAL_UINT16(0, Cpu::share(5, 0));
+}
+
+void test_pool_frame_round_trip(void) {
+  Pool p;
+  p.capacity = 80;
+  p.used = 23;
+  p.usedMax = 41;
+  p.failures = 0x01020304u;
+  std::vector<uint8_t> f = frameOf(p);
+  TEST_ASSERT_EQUAL_UINT32(Pool::SIZE + OVERHEAD, f.size());
+  TEST_ASSERT_EQUAL_HEX8(0x04, f[3 + 6]);          // little-endian
+  TEST_ASSERT_EQUAL_INT(1, feed(&f[0], f.size()));
+
+  Pool p2;
+  TEST_ASSERT_TRUE(decode(*rx, p2));
+  TEST_ASSERT_EQUAL_UINT16(80, p2.capacity);
+  TEST_ASSERT_EQUAL_UINT16(23, p2.used);
+  TEST_ASSERT_EQUAL_UINT16(41, p2.usedMax);
+  TEST_ASSERT_EQUAL_HEX32(0x01020304u, p2.failures);
+}
+
+void test_resync_after_garbage_and_bad_crc(void) {
+  Meter m;
+  m.in = 7;
+  m.out = 8;
+  std::vector<uint8_t> good = frameOf(m);
+  std::vector<uint8_t> bad = good;
+  bad[4] ^= 0x40;                                  // corrupt the payload
+
+  std::vector<uint8_t> s = { 0x00, 0x13, 0x37 };   // line noise
+  s.insert(s.end(), bad.begin(), bad.end());
+  s.insert(s.end(), good.begin(), good.end());
+  s.push_back(0xFF);
+  s.insert(s.end(), good.begin(), good.end());
+
+  TEST_ASSERT_EQUAL_INT(2, feed(&s[0], s.size()));
+  TEST_ASSERT_EQUAL_UINT32(1, rx->crcErrors);
+  TEST_ASSERT_EQUAL_UINT32(4, rx->skipped);
+  Meter m2;
+  TEST_ASSERT_TRUE(decode(*rx, m2));
+  TEST_ASSERT_EQUAL_UINT8(8, m2.out);
+}
+
+void test_oversize_length_is_rejected(void) {
+  const uint8_t s[] = { SYNC, MSG_DEBUG, (uint8_t)(MAX_PAYLOAD + 1) };
+  TEST_ASSERT_EQUAL_INT(0, feed(s, sizeof(s)));
+  TEST_ASSERT_EQUAL_UINT32(1, rx->lengthErrors);
+
+  // Still decodes the next frame
+  Level l;
+  l.pct = 50;
+  std::vector<uint8_t> f = frameOf(l);
+  TEST_ASSERT_EQUAL_INT(1, feed(&f[0], f.size()));
+}
+
+void test_payload_length_mismatch_is_rejected(void) {
+  // A well-formed frame whose payload is too short for its type
+  uint8_t payload[1] = { 3 };
+  uint8_t f[MAX_FRAME];
+  size_t n = encodeFrame(MSG_METER, payload, 1, f, sizeof(f));
+  TEST_ASSERT_EQUAL_INT(1, feed(f, n));
+  Meter m;
+  TEST_ASSERT_FALSE(decode(*rx, m));
+}
+
+void test_encode_into_small_buffer_fails(void) {
+  Debug g = {};
+  uint8_t f[Debug::SIZE + OVERHEAD - 1];
+  TEST_ASSERT_EQUAL_UINT32(0, encode(g, f, sizeof(f)));
+  uint8_t big[MAX_PAYLOAD + 1] = {};
+  uint8_t out[MAX_FRAME + 1];
+  TEST_ASSERT_EQUAL_UINT32(0, encodeFrame(MSG_DEBUG, big, sizeof(big), out, sizeof(out)));
+}
+
+void test_empty_payload(void) {
+  uint8_t f[MAX_FRAME];
+  size_t n = encodeFrame(0x7F, nullptr, 0, f, sizeof(f));
+  TEST_ASSERT_EQUAL_UINT32(OVERHEAD, n);
+  TEST_ASSERT_EQUAL_INT(1, feed(f, n));
+  TEST_ASSERT_EQUAL_UINT8(0x7F, rx->type());
+  TEST_ASSERT_EQUAL_UINT32(0, rx->length());
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_crc16_ccitt_false_check_value);
+  RUN_TEST(test_frame_layout);
+  RUN_TEST(test_round_trip_every_message);
+  RUN_TEST(test_cpu_frame_round_trip);
+  RUN_TEST(test_pool_frame_round_trip);
+  RUN_TEST(test_resync_after_garbage_and_bad_crc);
+  RUN_TEST(test_oversize_length_is_rejected);
+  RUN_TEST(test_payload_length_mismatch_is_rejected);
+  RUN_TEST(test_encode_into_small_buffer_fails);
+  RUN_TEST(test_empty_payload);
+  return UNITY_END();
+}
@@ -0,0 +1,246 @@
+// VOX EFX - host tests for the flash log store (vox_log_store.h), on a
+// file-backed flash with simulated power loss (vox_file_flash.h)
+// Run: pio test -e native -f native/test_log_store
+
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "VoxDsp.h"
+#include "vox_file_flash.h"
+
+typedef vox::FileFlash<4 * 4096> Flash;     // two 8 KB banks
+typedef vox::LogStore<Flash> Store;
+
+static const char* PATH = "test_log_store.bin";
+
+struct Value {
+  uint32_t n;
+  uint32_t check;                           // ~n: a mixed-up record shows
+};
+
+static Value value(uint32_t n) {
+  Value v;
+  v.n = n;
+  v.check = ~n;
+  return v;
+}
+
+static void save(Store& s, uint8_t key, uint32_t n) {
+  const Value v = value(n);
+  TEST_ASSERT_TRUE(s.put(key, &v, sizeof(v)));
+  while (s.poll()) {}
+}
+
+static bool load(Store& s, uint8_t key, uint32_t& n) {
+  Value v;
+  if (!s.get(key, &v, sizeof(v))) return false;
+  TEST_ASSERT_EQUAL_UINT32(~v.n, v.check);
+  n = v.n;
+  return true;
+}
+
+void setUp(void) { remove(PATH); }
+void tearDown(void) { remove(PATH); }
+
+void test_empty_then_persisted(void) {
+  {
+    Flash f;
+    TEST_ASSERT_TRUE(f.open(PATH));
+    Store s(f);
+    s.begin();
+    uint32_t n;
+    TEST_ASSERT_FALSE(load(s, 3, n));
+    save(s, 3, 42);
+    save(s, 5, 7);
+    save(s, 3, 43);
+    TEST_ASSERT_TRUE(load(s, 3, n));
+    TEST_ASSERT_EQUAL_UINT32(43, n);
+  }
+  Flash f;
+  TEST_ASSERT_TRUE(f.open(PATH));
+  Store s(f);
+  s.begin();
+  uint32_t n;
+  TEST_ASSERT_TRUE(load(s, 3, n));
+  TEST_ASSERT_EQUAL_UINT32(43, n);
+  TEST_ASSERT_TRUE(load(s, 5, n));
+  TEST_ASSERT_EQUAL_UINT32(7, n);
+  TEST_ASSERT_EQUAL_UINT32(3, s.stats().records);
+  TEST_ASSERT_FALSE(s.stats().torn);
+
+  Value v = value(1);
+  TEST_ASSERT_FALSE(s.get(3, &v, 4));               // wrong size
+  TEST_ASSERT_FALSE(s.put(Store::MAX_KEYS, &v, sizeof(v)));
+}
+
+void test_poll_writes_small_chunks(void) {
+  Flash f;
+  TEST_ASSERT_TRUE(f.open(PATH));
+  Store s(f);
+  s.begin();
+
+  uint8_t big[Store::MAX_PAYLOAD] = {};
+  const uint32_t before = f.programs;
+  const uint32_t erases = f.erases;                  // begin() formatted bank 0
+  TEST_ASSERT_TRUE(s.put(1, big, sizeof(big)));
+  TEST_ASSERT_FALSE(s.put(2, big, 1));               // one record at a time
+  int polls = 0;
+  while (s.poll()) polls++;
+  polls++;
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)polls, f.programs - before);
+  TEST_ASSERT_TRUE(polls >= (int)((sizeof(big) + 6) / Store::CHUNK));
+  TEST_ASSERT_EQUAL_UINT32(erases, f.erases);        // erases are for begin() only
+  TEST_ASSERT_FALSE(s.busy());
+}
+
+void test_full_bank_compacts_on_boot(void) {
+  uint32_t last = 0;
+  {
+    Flash f;
+    TEST_ASSERT_TRUE(f.open(PATH));
+    Store s(f);
+    s.begin();
+    const Value v = value(0);
+    for (uint32_t i = 1;; i++) {
+      const Value w = value(i);
+      if (!s.put((uint8_t)(i % 4), &w, sizeof(w))) break;
+      while (s.poll()) {}
+      last = i;
+    }
+    TEST_ASSERT_TRUE(s.stats().full > 0);
+    TEST_ASSERT_FALSE(s.put(0, &v, sizeof(v)));
+  }
+  Flash f;
+  TEST_ASSERT_TRUE(f.open(PATH));
+  Store s(f);
+  s.begin();
+  TEST_ASSERT_TRUE(s.stats().compacted);
+  TEST_ASSERT_EQUAL_UINT32(4, s.stats().records);
+  for (uint32_t k = 0; k < 4; k++) {
+    uint32_t n;
+    TEST_ASSERT_TRUE(load(s, (uint8_t)k, n));
+    TEST_ASSERT_EQUAL_UINT32(k, n % 4);
+    TEST_ASSERT_TRUE(last - n < 4);                   // the newest of each key
+  }
+  save(s, 2, 9999);
+  uint32_t n;
+  TEST_ASSERT_TRUE(load(s, 2, n));
+  TEST_ASSERT_EQUAL_UINT32(9999, n);
+}
+
+// Boot compacts once less than half the bank is free, not only when full,
+// so the session that follows has room to save
+void test_half_full_compacts_on_boot(void) {
+  const uint32_t rec = Store::recordSize(sizeof(Value));
+  uint32_t i = 0;
+  {
+    Flash f;
+    TEST_ASSERT_TRUE(f.open(PATH));
+    Store s(f);
+    s.begin();
+    for (; Store::BANK - s.stats().used - rec >= Store::BANK / 2; i++) save(s, (uint8_t)(i % 3), i);
+  }
+  {
+    Flash f;
+    TEST_ASSERT_TRUE(f.open(PATH));
+    Store s(f);
+    s.begin();
+    TEST_ASSERT_FALSE(s.stats().compacted);          // half the bank still free
+    save(s, (uint8_t)(i % 3), i);
+    i++;
+  }
+  Flash f;
+  TEST_ASSERT_TRUE(f.open(PATH));
+  Store s(f);
+  s.begin();
+  TEST_ASSERT_TRUE(s.stats().compacted);
+  TEST_ASSERT_EQUAL_UINT32(3, s.stats().records);
+  TEST_ASSERT_TRUE(Store::BANK - s.stats().used >= Store::BANK / 2);
+  for (uint32_t k = 0; k < 3; k++) {
+    uint32_t n;
+    TEST_ASSERT_TRUE(load(s, (uint8_t)k, n));
+    TEST_ASSERT_TRUE(i - n <= 3);
+  }
+
+  // A caller can ask for more room than the default
+  Store t(f);
+  t.begin(Store::BANK);
+  TEST_ASSERT_TRUE(t.stats().compacted);
+}
+
+// Power cut at a random flash operation, again and again on the same file:
+// after every reboot each key reads its last completed value or the one
+// that was being written, never garbage, and the store keeps working
+void test_power_loss_fuzz(void) {
+  static const int KEYS = 5;
+  uint32_t rng = 12345;
+  int tornSeen = 0, compactions = 0;
+
+  for (int seed = 0; seed < 40; seed++) {
+    remove(PATH);
+    bool has[KEYS] = {};
+    uint32_t committed[KEYS] = {};
+    uint32_t counter = 1;
+
+    for (int round = 0; round < 25; round++) {
+      int inflightKey = -1;
+      uint32_t inflight = 0;
+
+      Flash f;
+      TEST_ASSERT_TRUE(f.open(PATH));
+      rng = rng * 1103515245u + 12345u;
+      f.cutAfter(1 + (rng >> 8) % 300, rng | 1);
+      Store s(f);
+      s.begin();
+
+      for (int i = 0; i < 200 && !f.powerLost(); i++) {
+        rng = rng * 1103515245u + 12345u;
+        const int key = (int)((rng >> 16) % KEYS);
+        const Value v = value(counter);
+        if (!s.put((uint8_t)key, &v, sizeof(v))) break;     // full until next boot
+        inflightKey = key;
+        inflight = counter++;
+        while (s.poll() && !f.powerLost()) {}
+        if (f.powerLost()) break;
+        has[key] = true;
+        committed[key] = inflight;
+        inflightKey = -1;
+      }
+      f.close();
+
+      // Reboot, no cut
+      Flash g;
+      TEST_ASSERT_TRUE(g.open(PATH));
+      Store r(g);
+      r.begin();
+      if (r.stats().torn) tornSeen++;
+      if (r.stats().compacted) compactions++;
+      for (int k = 0; k < KEYS; k++) {
+        uint32_t n;
+        const bool got = load(r, (uint8_t)k, n);
+        if (k == inflightKey && got && n == inflight) {
+          has[k] = true;                 // the torn-looking write had landed
+          committed[k] = n;
+          continue;
+        }
+        TEST_ASSERT_EQUAL(has[k], got);
+        if (got) TEST_ASSERT_EQUAL_UINT32(committed[k], n);
+      }
+    }
+  }
+  TEST_ASSERT_TRUE(tornSeen > 0);
+  TEST_ASSERT_TRUE(compactions > 0);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_then_persisted);
+  RUN_TEST(test_poll_writes_small_chunks);
+  RUN_TEST(test_full_bank_compacts_on_boot);
+  RUN_TEST(test_half_full_compacts_on_boot);
+  RUN_TEST(test_power_loss_fuzz);
+  return UNITY_END();
+}
@@ -0,0 +1,108 @@
+// VOX EFX - host tests for the meter segment mapping (vox_meter.h)
+// Run: pio test -e native -f native/test_meter
+
+#include <unity.h>
+
+#include <math.h>
+
+#include "VoxDsp.h"
+#include "vox_config.h"
+
+static constexpr vox::MeterScale<METER_SEGMENTS> scale(METER_FLOOR_DB, METER_TOP_DB);
+static_assert(scale.threshold(1) > 0.0039f && scale.threshold(1) < 0.0040f, "-48 dB at compile time");
+
+// What the old per-call code did: log10f, then walk the dB thresholds
+static int reference(float peak, int n, double floorDb, double topDb) {
+  if (peak <= 0.0f) return 0;
+  const double db = 20.0 * log10((double)peak);
+  int seg = 0;
+  for (int i = 0; i < n; i++) {
+    if (db >= floorDb + (topDb - floorDb) * i / (n > 1 ? n - 1 : 1)) seg = i + 1;
+  }
+  return seg;
+}
+
+// Within float rounding of a threshold either answer is right
+static bool nearThreshold(float peak, int n, double floorDb, double topDb) {
+  const double db = 20.0 * log10((double)peak);
+  for (int i = 0; i < n; i++) {
+    if (fabs(db - (floorDb + (topDb - floorDb) * i / (n > 1 ? n - 1 : 1))) < 1e-4) return true;
+  }
+  return false;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_thresholds(void) {
+  TEST_ASSERT_EQUAL_INT(29, METER_SEGMENTS);
+  for (int s = 1; s <= METER_SEGMENTS; s++) {
+    const double db = METER_FLOOR_DB + 1.5 * (s - 1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f * (float)pow(10.0, db / 20.0) + 1e-9f, (float)pow(10.0, db / 20.0),
+                             scale.threshold(s));
+  }
+}
+
+void test_matches_log10_reference(void) {
+  uint32_t r = 7;
+  int checked = 0;
+  for (int i = 0; i < 20000; i++) {
+    r = r * 1664525u + 1013904223u;
+    const float peak = (float)pow(10.0, -4.0 * (r >> 8) / 16777216.0);   // -80 .. 0 dB
+    if (nearThreshold(peak, METER_SEGMENTS, METER_FLOOR_DB, METER_TOP_DB)) continue;
+    TEST_ASSERT_EQUAL_INT(reference(peak, METER_SEGMENTS, METER_FLOOR_DB, METER_TOP_DB), scale.segments(peak));
+    checked++;
+  }
+  TEST_ASSERT_GREATER_THAN(19000, checked);
+
+  // Exactly on a threshold lights it
+  for (int s = 1; s <= METER_SEGMENTS; s++) TEST_ASSERT_EQUAL_INT(s, scale.segments(scale.threshold(s)));
+}
+
+void test_edges(void) {
+  TEST_ASSERT_EQUAL_INT(0, scale.segments(0.0f));
+  TEST_ASSERT_EQUAL_INT(0, scale.segments(-1.0f));
+  TEST_ASSERT_EQUAL_INT(0, scale.segments(NAN));
+  TEST_ASSERT_EQUAL_INT(METER_SEGMENTS, scale.segments(1.0f));
+  TEST_ASSERT_EQUAL_INT(METER_SEGMENTS, scale.segments(INFINITY));
+
+  // Monotonic
+  int last = 0;
+  for (float db = -90.0f; db <= 6.0f; db += 0.05f) {
+    const int s = scale.segments(powf(10.0f, db / 20.0f));
+    TEST_ASSERT_TRUE(s >= last);
+    last = s;
+  }
+  TEST_ASSERT_EQUAL_INT(METER_SEGMENTS, last);
+}
+
+// Any segment count, and many channels per call
+void test_other_counts(void) {
+  static constexpr vox::MeterScale<8> eight(-42.0, -6.0);
+  static constexpr vox::MeterScale<1> one(-20.0, -20.0);
+  static constexpr vox::MeterScale<100> hundred(-99.0, 0.0);
+  TEST_ASSERT_EQUAL_INT(16, eight.SLOTS);
+  TEST_ASSERT_EQUAL_INT(2, one.SLOTS);
+  TEST_ASSERT_EQUAL_INT(128, hundred.SLOTS);
+
+  const float peaks[6] = { 0.0f, 0.0079f, 0.0080f, 0.25f, 0.6f, 1.0f };
+  uint8_t seg[6];
+  eight.segments(peaks, seg, 6);
+  for (int c = 0; c < 6; c++) TEST_ASSERT_EQUAL_INT(reference(peaks[c], 8, -42.0, -6.0), seg[c]);
+
+  TEST_ASSERT_EQUAL_INT(0, one.segments(0.09f));
+  TEST_ASSERT_EQUAL_INT(1, one.segments(0.11f));
+  TEST_ASSERT_EQUAL_INT(50, hundred.segments(hundred.threshold(50)));
+  TEST_ASSERT_EQUAL_INT(100, hundred.segments(1.0f));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_thresholds);
+  RUN_TEST(test_matches_log10_reference);
+  RUN_TEST(test_edges);
+  RUN_TEST(test_other_counts);
+  return UNITY_END();
+}
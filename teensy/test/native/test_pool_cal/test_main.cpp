@@ -0,0 +1,82 @@
+// VOX EFX - host tests for the AudioMemory calibration sequence
+// Run: pio test -e native -f native/test_pool_cal
+
+#include <unity.h>
+
+#include "VoxDsp.h"
+
+typedef vox::PoolCalibration Cal;
+
+static const uint32_t SETTLE = 100;
+static const uint32_t WINDOW = 1000;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_idle_until_begin(void) {
+  Cal c;
+  TEST_ASSERT_FALSE(c.running());
+  TEST_ASSERT_EQUAL_INT(Cal::NONE, c.poll(0, 10));
+}
+
+void test_walks_every_configuration(void) {
+  // Pool high-water per configuration: dry, reverb, delay, both
+  const uint16_t PEAK[Cal::CONFIGS] = { 12, 20, 17, 25 };
+  Cal c;
+  c.begin(0, SETTLE, WINDOW, 4);
+
+  uint32_t now = 0;
+  int applied = 0, resets = 0, measured = 0;
+  bool done = false;
+  bool seen[Cal::CONFIGS] = { false, false, false, false };
+  while (!done && now < 60000) {
+    switch (c.poll(now, PEAK[c.config()])) {
+      case Cal::APPLY:
+        TEST_ASSERT_EQUAL(c.config() & 1, c.reverb() ? 1 : 0);
+        TEST_ASSERT_EQUAL(c.config() & 2, c.delay() ? 2 : 0);
+        seen[c.config()] = true;
+        applied++;
+        break;
+      case Cal::RESET_PEAK: resets++; break;
+      case Cal::MEASURED:   measured++; break;
+      case Cal::DONE:       done = true; break;
+      default: break;
+    }
+    now += 10;
+  }
+
+  TEST_ASSERT_TRUE(done);
+  TEST_ASSERT_FALSE(c.running());
+  TEST_ASSERT_EQUAL_INT(Cal::CONFIGS, applied);
+  TEST_ASSERT_EQUAL_INT(Cal::CONFIGS, resets);
+  TEST_ASSERT_EQUAL_INT(Cal::CONFIGS, measured);
+  for (int i = 0; i < Cal::CONFIGS; i++) {
+    TEST_ASSERT_TRUE(seen[i]);
+    TEST_ASSERT_EQUAL_UINT16(PEAK[i], c.peak(i));
+    TEST_ASSERT_EQUAL_UINT16(PEAK[i] + 4, c.safe(i));
+  }
+  TEST_ASSERT_EQUAL_UINT16(29, c.safeAll());
+  TEST_ASSERT_EQUAL_INT(Cal::NONE, c.poll(now, 99));   // stays done
+}
+
+void test_waits_settle_and_window(void) {
+  Cal c;
+  c.begin(1000, SETTLE, WINDOW, 0);
+  TEST_ASSERT_EQUAL_INT(Cal::APPLY, c.poll(1000, 0));
+  TEST_ASSERT_EQUAL_INT(Cal::NONE, c.poll(1000 + SETTLE - 1, 0));
+  TEST_ASSERT_EQUAL_INT(Cal::RESET_PEAK, c.poll(1000 + SETTLE, 0));
+  TEST_ASSERT_EQUAL_INT(Cal::NONE, c.poll(1000 + SETTLE + WINDOW - 1, 7));
+  TEST_ASSERT_EQUAL_INT(Cal::MEASURED, c.poll(1000 + SETTLE + WINDOW, 9));
+  TEST_ASSERT_EQUAL_UINT16(9, c.peak(0));
+  TEST_ASSERT_TRUE(c.running());
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_idle_until_begin);
+  RUN_TEST(test_walks_every_configuration);
+  RUN_TEST(test_waits_settle_and_window);
+  return UNITY_END();
+}
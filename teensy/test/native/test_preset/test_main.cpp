@@ -0,0 +1,96 @@
+// VOX EFX - host tests for the preset records (shared/VoxLink vox_preset.h)
+// Run: pio test -e native -f native/test_preset
+
+#include <unity.h>
+
+#include <string.h>
+
+#include "vox_preset.h"
+
+using namespace vox::link;
+
+static Preset makePreset(const char* name, float room) {
+  Preset p;
+  memset(&p, 0, sizeof(p));
+  p.setName(name);
+  p.reverbOn = 1;
+  p.level = 70;
+  p.roomsize = room;
+  p.wet = 0.4f;
+  p.dry = 1.0f;
+  p.eqDb10[3] = -25;
+  return p;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_store_and_get(void) {
+  PresetBank<4> bank;
+  TEST_ASSERT_NULL(bank.get(0));                 // empty slots are invalid
+
+  bank.store(2, makePreset("HALL", 0.85f));
+  const Preset* p = bank.get(2);
+  TEST_ASSERT_NOT_NULL(p);
+  TEST_ASSERT_EQUAL_STRING("HALL", p->name);
+  TEST_ASSERT_EQUAL_FLOAT(0.85f, p->roomsize);
+  TEST_ASSERT_EQUAL_INT(-25, p->eqDb10[3]);
+  TEST_ASSERT_NULL(bank.get(1));
+  TEST_ASSERT_NULL(bank.get(4));
+  TEST_ASSERT_NULL(bank.get(-1));
+}
+
+void test_name_is_truncated_and_terminated(void) {
+  Preset p = makePreset("A VERY LONG PRESET NAME", 0.5f);
+  TEST_ASSERT_EQUAL_INT(PRESET_NAME - 1, (int)strlen(p.name));
+}
+
+void test_load_round_trip(void) {
+  PresetBank<2> a, b;
+  a.store(0, makePreset("SLAP", 0.3f));
+
+  uint8_t bytes[sizeof(PresetRecord)];
+  memcpy(bytes, &a.record(0), sizeof(bytes));
+  TEST_ASSERT_TRUE(b.load(1, bytes, sizeof(bytes)));
+  TEST_ASSERT_NOT_NULL(b.get(1));
+  TEST_ASSERT_EQUAL_MEMORY(a.get(0), b.get(1), sizeof(Preset));
+  TEST_ASSERT_FALSE(b.load(1, bytes, sizeof(bytes) - 1));
+}
+
+void test_corrupt_record_is_rejected(void) {
+  PresetBank<1> a, b;
+  a.store(0, makePreset("HALL", 0.85f));
+  uint8_t bytes[sizeof(PresetRecord)];
+
+  // Any flipped bit (header, body or CRC) fails the check; the slot keeps
+  // what it had
+  for (size_t i = 0; i < sizeof(bytes); i++) {
+    memcpy(bytes, &a.record(0), sizeof(bytes));
+    bytes[i] ^= 0x10;
+    TEST_ASSERT_FALSE(b.load(0, bytes, sizeof(bytes)));
+  }
+  TEST_ASSERT_NULL(b.get(0));
+}
+
+void test_other_version_is_rejected(void) {
+  PresetBank<1> a, b;
+  a.store(0, makePreset("HALL", 0.85f));
+
+  // An older firmware's record: right CRC, wrong version
+  PresetRecord r = a.record(0);
+  r.version = PRESET_VERSION + 1;
+  r.crc = crc16((const uint8_t*)&r, PresetRecord::SEALED);
+  TEST_ASSERT_FALSE(b.load(0, (const uint8_t*)&r, sizeof(r)));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_store_and_get);
+  RUN_TEST(test_name_is_truncated_and_terminated);
+  RUN_TEST(test_load_round_trip);
+  RUN_TEST(test_corrupt_record_is_rejected);
+  RUN_TEST(test_other_version_is_rejected);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+// VOX EFX - host tests for the per-block gain ramps (mixer/amp)
+// Run: pio test -e native -f native/test_ramp
+
+#include <unity.h>
+
+#include <vector>
+
+#include "VoxDsp.h"
+
+static const int B = vox::BLOCK_SAMPLES;
+
+static vox::Ramp* dut = nullptr;
+
+void setUp(void) {
+  dut = new vox::Ramp();
+}
+
+void tearDown(void) {
+  delete dut;
+  dut = nullptr;
+}
+
+// Per-sample Q24 gains of the next n blocks
+static std::vector<int32_t> trace(int blocks) {
+  std::vector<int32_t> g;
+  for (int b = 0; b < blocks; b++) {
+    vox::Ramp::Segment s = dut->next();
+    for (int i = 0; i < B; i++) g.push_back(s.start + i * s.step);
+  }
+  return g;
+}
+
+void test_first_block_starts_on_target(void) {
+  dut->shape(vox::Ramp::LINEAR, 20.0f);
+  dut->set(vox::gainToQ16(0.35f));
+  vox::Ramp::Segment s = dut->next();
+  TEST_ASSERT_TRUE(s.settled());
+  TEST_ASSERT_EQUAL_INT32(vox::gainToQ16(0.35f), s.q16());
+}
+
+void test_linear_length_and_no_overshoot(void) {
+  dut->shape(vox::Ramp::LINEAR, 20.0f);          // 20 ms = 6.9 blocks -> 7
+  dut->next();                                   // settle at unity
+  dut->set(0);
+
+  std::vector<int32_t> g = trace(9);
+  // Ramping for 7 blocks, monotonic and never below the target
+  for (size_t i = 1; i < g.size(); i++) {
+    TEST_ASSERT_TRUE(g[i] <= g[i - 1]);
+    TEST_ASSERT_TRUE(g[i] >= 0);
+  }
+  TEST_ASSERT_GREATER_THAN(0, g[6 * B + B - 1]);
+  for (int i = 7 * B; i < 9 * B; i++) TEST_ASSERT_EQUAL_INT32(0, g[i]);
+
+  // Straight line: equal steps from 1.0 to 0
+  int32_t step = g[1] - g[0];
+  TEST_ASSERT_INT_WITHIN(2, -(1 << 24) / (7 * B), step);
+}
+
+void test_exponential_settles_without_overshoot(void) {
+  dut->shape(vox::Ramp::EXPONENTIAL, 10.0f);
+  dut->set(0);
+  dut->next();                                   // settle at 0
+  dut->set(vox::GAIN_UNITY);
+
+  std::vector<int32_t> g = trace(200);
+  for (size_t i = 1; i < g.size(); i++) {
+    TEST_ASSERT_TRUE(g[i] >= g[i - 1]);
+    TEST_ASSERT_TRUE(g[i] <= (1 << 24));
+  }
+  // One time constant in: ~63%
+  int at = (int)(10.0f * 0.001f * vox::SAMPLE_RATE);
+  TEST_ASSERT_INT_WITHIN(1 << 20, (int32_t)(0.632f * (1 << 24)), g[at]);
+  TEST_ASSERT_EQUAL_INT32(1 << 24, g.back());
+  TEST_ASSERT_TRUE(dut->next().settled());
+}
+
+void test_retarget_mid_ramp_is_continuous(void) {
+  dut->shape(vox::Ramp::LINEAR, 30.0f);
+  dut->next();
+  dut->set(0);
+  std::vector<int32_t> a = trace(3);
+  dut->set(vox::GAIN_UNITY / 2);
+  std::vector<int32_t> b = trace(20);
+
+  // The new ramp starts where the old one was, no jump
+  int32_t expectNext = a.back() + (a[B * 3 - 1] - a[B * 3 - 2]);
+  TEST_ASSERT_INT_WITHIN(1 << 16, expectNext, b.front());
+  for (size_t i = 1; i < b.size(); i++) TEST_ASSERT_TRUE(b[i] <= b[i - 1]);
+  TEST_ASSERT_EQUAL_INT32(1 << 23, b.back());
+}
+
+void test_settled_gain_is_q16_bit_exact(void) {
+  dut->set(vox::gainToQ16(0.5f));
+  int16_t in[B], out[B];
+  for (int i = 0; i < B; i++) in[i] = (int16_t)(i * 509 - 32000);
+  vox::Ramp::Segment s = dut->next();
+  vox::Ramp::scale(s, in, out);
+  for (int i = 0; i < B; i++) TEST_ASSERT_EQUAL_INT(vox::saturate16(vox::mulQ16(32768, in[i])), out[i]);
+}
+
+void test_mixer_toggle_does_not_click(void) {
+  // Full-scale DC on the wet channel, toggled on: the output climbs in
+  // small steps instead of jumping
+  vox::Mixer4 mix;
+  mix.ramp(vox::Ramp::LINEAR, 20.0f);
+  mix.gain(0, 0.0f);
+  mix.gain(1, 0.0f);
+  int16_t dc[B], out[B];
+  for (int i = 0; i < B; i++) dc[i] = 32000;
+  const int16_t* in[4] = { dc, nullptr, nullptr, nullptr };
+  mix.update(in, out);
+  TEST_ASSERT_EQUAL_INT(0, out[B - 1]);
+
+  mix.gain(0, 1.0f);
+  int16_t prev = 0;
+  for (int b = 0; b < 10; b++) {
+    mix.update(in, out);
+    for (int i = 0; i < B; i++) {
+      TEST_ASSERT_INT_WITHIN(64, prev, out[i]);
+      TEST_ASSERT_TRUE(out[i] <= 32000);
+      prev = out[i];
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(32000, prev);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_first_block_starts_on_target);
+  RUN_TEST(test_linear_length_and_no_overshoot);
+  RUN_TEST(test_exponential_settles_without_overshoot);
+  RUN_TEST(test_retarget_mid_ramp_is_continuous);
+  RUN_TEST(test_settled_gain_is_q16_bit_exact);
+  RUN_TEST(test_mixer_toggle_does_not_click);
+  return UNITY_END();
+}
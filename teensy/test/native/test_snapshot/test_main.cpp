@@ -0,0 +1,119 @@
+// VOX EFX - host tests for the lock-free latest-value snapshot (shared/VoxLink)
+// Run: pio test -e native -f native/test_snapshot
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "vox_snapshot.h"
+
+// Every field derived from seq, so a torn copy shows up
+struct State {
+  uint32_t seq;
+  uint32_t a, b, c;
+  uint8_t  pad[64];
+};
+
+static State make(uint32_t seq) {
+  State s;
+  s.seq = seq;
+  s.a = seq * 3;
+  s.b = ~seq;
+  s.c = seq ^ 0x5A5A5A5Au;
+  for (int i = 0; i < 64; i++) s.pad[i] = (uint8_t)(seq + i);
+  return s;
+}
+
+static bool intact(const State& s) {
+  if (s.a != s.seq * 3 || s.b != ~s.seq || s.c != (s.seq ^ 0x5A5A5A5Au)) return false;
+  for (int i = 0; i < 64; i++) {
+    if (s.pad[i] != (uint8_t)(s.seq + i)) return false;
+  }
+  return true;
+}
+
+static vox::link::Snapshot<State>* snap = nullptr;
+
+void setUp(void) {
+  snap = new vox::link::Snapshot<State>();
+}
+
+void tearDown(void) {
+  delete snap;
+  snap = nullptr;
+}
+
+void test_nothing_published_reads_default(void) {
+  TEST_ASSERT_FALSE(snap->acquire());
+  TEST_ASSERT_EQUAL_UINT32(0, snap->current().seq);
+}
+
+void test_reader_gets_newest_and_only_once(void) {
+  snap->publish(make(1));
+  snap->publish(make(2));
+  snap->publish(make(3));
+  TEST_ASSERT_TRUE(snap->acquire());
+  TEST_ASSERT_EQUAL_UINT32(3, snap->current().seq);
+  TEST_ASSERT_TRUE(intact(snap->current()));
+
+  // Nothing new: keeps the same copy
+  TEST_ASSERT_FALSE(snap->acquire());
+  TEST_ASSERT_EQUAL_UINT32(3, snap->current().seq);
+
+  snap->publish(make(4));
+  TEST_ASSERT_TRUE(snap->acquire());
+  TEST_ASSERT_EQUAL_UINT32(4, snap->current().seq);
+  TEST_ASSERT_EQUAL_UINT32(4, snap->published);
+}
+
+void test_writer_never_overwrites_reader_copy(void) {
+  snap->publish(make(10));
+  TEST_ASSERT_TRUE(snap->acquire());
+  const State* held = &snap->current();
+  for (uint32_t i = 11; i < 50; i++) snap->publish(make(i));
+  TEST_ASSERT_EQUAL_UINT32(10, held->seq);
+  TEST_ASSERT_TRUE(intact(*held));
+}
+
+void test_concurrent_writer_and_reader(void) {
+  // Writer as fast as it can, reader polling: every copy read is intact and
+  // sequence numbers never go backwards
+  static const uint32_t COUNT = 200000;
+  std::atomic<bool> done(false);
+  uint32_t reads = 0, bad = 0, backwards = 0, last = 0;
+
+  std::thread reader([&]() {
+    for (;;) {
+      const bool finished = done.load();
+      if (snap->acquire()) {
+        const State& s = snap->current();
+        if (!intact(s)) bad++;
+        if (s.seq < last) backwards++;
+        last = s.seq;
+        reads++;
+      }
+      if (finished) break;
+    }
+  });
+
+  for (uint32_t i = 1; i <= COUNT; i++) snap->publish(make(i));
+  done.store(true);
+  reader.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, bad);
+  TEST_ASSERT_EQUAL_UINT32(0, backwards);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, reads);
+  TEST_ASSERT_EQUAL_UINT32(COUNT, last);      // the final copy always arrives
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_nothing_published_reads_default);
+  RUN_TEST(test_reader_gets_newest_and_only_once);
+  RUN_TEST(test_writer_never_overwrites_reader_copy);
+  RUN_TEST(test_concurrent_writer_and_reader);
+  return UNITY_END();
+}
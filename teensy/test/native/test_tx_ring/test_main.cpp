@@ -0,0 +1,165 @@
+// VOX EFX - host tests for the lock-free telemetry TX ring (shared/VoxLink)
+// Run: pio test -e native -f native/test_tx_ring
+
+#include <unity.h>
+
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "vox_tx_ring.h"
+
+typedef vox::link::TxRing<1024> Ring;
+static const uint32_t RMAX = Ring::RECORD_MAX;
+
+static Ring* ring = nullptr;
+
+void setUp(void) {
+  ring = new Ring();
+}
+
+void tearDown(void) {
+  delete ring;
+  ring = nullptr;
+}
+
+// Record i: 4-byte sequence number plus filler derived from it
+static size_t makeRecord(uint32_t seq, uint8_t* out, size_t len) {
+  memcpy(out, &seq, 4);
+  for (size_t i = 4; i < len; i++) out[i] = (uint8_t)(seq * 31 + i);
+  return len;
+}
+
+static bool checkRecord(const uint8_t* p, size_t len, uint32_t& seq) {
+  if (len < 4) return false;
+  memcpy(&seq, p, 4);
+  for (size_t i = 4; i < len; i++) {
+    if (p[i] != (uint8_t)(seq * 31 + i)) return false;
+  }
+  return true;
+}
+
+void test_fifo_order_and_wrap(void) {
+  uint8_t rec[RMAX], out[RMAX];
+  uint32_t next = 0;
+  // Many more bytes than the ring holds, popped as we go: wraps repeatedly
+  for (uint32_t i = 0; i < 500; i++) {
+    ring->push(rec, makeRecord(i, rec, 4 + i % 90));
+    if (i % 3 == 2) {
+      size_t n;
+      while ((n = ring->pop(out)) != 0) {
+        uint32_t seq;
+        TEST_ASSERT_TRUE(checkRecord(out, n, seq));
+        TEST_ASSERT_EQUAL_UINT32(next++, seq);
+      }
+    }
+  }
+  size_t n;
+  while ((n = ring->pop(out)) != 0) {
+    uint32_t seq;
+    TEST_ASSERT_TRUE(checkRecord(out, n, seq));
+    TEST_ASSERT_EQUAL_UINT32(next++, seq);
+  }
+  TEST_ASSERT_EQUAL_UINT32(500, next);
+  TEST_ASSERT_EQUAL_UINT32(0, ring->dropped);
+  TEST_ASSERT_EQUAL_UINT32(500, ring->records);
+}
+
+void test_full_ring_drops_oldest(void) {
+  uint8_t rec[100], out[RMAX];
+  // 102 bytes per record: 10 fit in 1024, push 25
+  for (uint32_t i = 0; i < 25; i++) ring->push(rec, makeRecord(i, rec, sizeof(rec)));
+
+  TEST_ASSERT_EQUAL_UINT32(15, ring->dropped);
+  TEST_ASSERT_EQUAL_UINT32(15 * 100, ring->droppedBytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(1024, ring->highWater);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(1024, ring->used());
+
+  // The newest 10 survive, in order
+  uint32_t expect = 15;
+  size_t n;
+  while ((n = ring->pop(out)) != 0) {
+    uint32_t seq;
+    TEST_ASSERT_TRUE(checkRecord(out, n, seq));
+    TEST_ASSERT_EQUAL_UINT32(expect++, seq);
+  }
+  TEST_ASSERT_EQUAL_UINT32(25, expect);
+  TEST_ASSERT_EQUAL_UINT32(0, ring->used());
+}
+
+void test_long_writes_split_into_records(void) {
+  std::vector<uint8_t> big(RMAX * 2 + 10);
+  for (size_t i = 0; i < big.size(); i++) big[i] = (uint8_t)i;
+  ring->push(&big[0], big.size());
+  TEST_ASSERT_EQUAL_UINT32(3, ring->records);
+
+  std::vector<uint8_t> got;
+  uint8_t out[RMAX];
+  size_t n;
+  while ((n = ring->pop(out)) != 0) {
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(RMAX, n);
+    got.insert(got.end(), out, out + n);
+  }
+  TEST_ASSERT_EQUAL_UINT32(big.size(), got.size());
+  TEST_ASSERT_EQUAL_MEMORY(&big[0], &got[0], big.size());
+}
+
+void test_empty_pop(void) {
+  uint8_t out[RMAX];
+  TEST_ASSERT_EQUAL_UINT32(0, ring->pop(out));
+  ring->push(out, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, ring->records);
+  TEST_ASSERT_EQUAL_UINT32(0, ring->pop(out));
+}
+
+void test_concurrent_producer_and_consumer(void) {
+  // Producer overruns a slow consumer: every record that arrives is intact
+  // and in order; arrived + dropped == pushed
+  static const uint32_t COUNT = 200000;
+  std::atomic<bool> done(false);
+  uint32_t received = 0, bad = 0, outOfOrder = 0;
+
+  std::thread consumer([&]() {
+    uint8_t out[RMAX];
+    uint32_t last = 0;
+    bool first = true;
+    for (;;) {
+      size_t n = ring->pop(out);
+      if (n == 0) {
+        if (done.load()) {
+          if ((n = ring->pop(out)) == 0) break;
+        } else {
+          continue;
+        }
+      }
+      uint32_t seq;
+      if (!checkRecord(out, n, seq)) { bad++; continue; }
+      if (!first && seq <= last) outOfOrder++;
+      last = seq;
+      first = false;
+      received++;
+    }
+  });
+
+  uint8_t rec[RMAX];
+  for (uint32_t i = 0; i < COUNT; i++) ring->push(rec, makeRecord(i, rec, 4 + i % 120));
+  done.store(true);
+  consumer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, bad);
+  TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+  TEST_ASSERT_EQUAL_UINT32(COUNT, received + ring->dropped);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_fifo_order_and_wrap);
+  RUN_TEST(test_full_ring_drops_oldest);
+  RUN_TEST(test_long_writes_split_into_records);
+  RUN_TEST(test_empty_pop);
+  RUN_TEST(test_concurrent_producer_and_consumer);
+  return UNITY_END();
+}